@@ -0,0 +1,64 @@
+/**************************************************************************************************
+* allocator.c: Innehller definitioner av associerade funktioner fr strukten allocator, som
+*              anvnds fr att anropa en godtycklig minnesallokator eller standardallokatorn.
+**************************************************************************************************/
+#include "allocator.h"
+
+/**************************************************************************************************
+* allocator_allocate: Allokerar ett minnesblock av angiven storlek via angiven allokator och
+*                     returnerar en pekare till blocket. Vid misslyckad allokering returneras null.
+*
+*                     - self: Pekare till allokatorn (null = malloc).
+*                     - size: Minnesblockets storlek i byte.
+**************************************************************************************************/
+void* allocator_allocate(const struct allocator* self,
+                         const size_t size)
+{
+   if (!self) return malloc(size);
+   return self->allocate(self->context, size);
+}
+
+/**************************************************************************************************
+* allocator_reallocate: Omallokerar ett minnesblock via angiven allokator och returnerar en
+*                       pekare till det nya blocket. Vid misslyckad omallokering returneras null,
+*                       varvid det ursprungliga blocket bibehlls.
+*
+*                       - self    : Pekare till allokatorn (null = realloc).
+*                       - block   : Pekare till minnesblocket som ska omallokeras (eller null).
+*                       - old_size: Minnesblockets nuvarande storlek i byte.
+*                       - new_size: Minnesblockets nya storlek i byte.
+**************************************************************************************************/
+void* allocator_reallocate(const struct allocator* self,
+                           void* block,
+                           const size_t old_size,
+                           const size_t new_size)
+{
+   if (!self) return realloc(block, new_size);
+   if (!block) return self->allocate(self->context, new_size);
+   return self->reallocate(self->context, block, old_size, new_size);
+}
+
+/**************************************************************************************************
+* allocator_deallocate: Frigr ett minnesblock via angiven allokator.
+*
+*                       - self : Pekare till allokatorn (null = free).
+*                       - block: Pekare till minnesblocket som ska frigras (eller null).
+*                       - size : Minnesblockets storlek i byte.
+**************************************************************************************************/
+void allocator_deallocate(const struct allocator* self,
+                          void* block,
+                          const size_t size)
+{
+   if (!block) return;
+
+   if (!self)
+   {
+      free(block);
+   }
+   else
+   {
+      self->deallocate(self->context, block, size);
+   }
+
+   return;
+}
@@ -0,0 +1,64 @@
+/**************************************************************************************************
+* allocator.h: Grnssnitt fr minnesallokatorer, som gr det mjligt att erstta de globala
+*              funktionerna malloc, realloc och free med exempelvis en arena eller en pool.
+*              En allokator utgrs av en tabell med funktionspekare samt en kontextpekare, som
+*              passeras till samtliga funktioner. En nullpekare tolkas som standardallokatorn,
+*              dvs. att malloc, realloc och free anropas direkt.
+**************************************************************************************************/
+#ifndef ALLOCATOR_H_
+#define ALLOCATOR_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+
+/**************************************************************************************************
+* allocator: Tabell med funktioner fr allokering, omallokering och frigrande av minne. Storleken
+*            p befintliga minnesblock passeras vid omallokering samt frigrande, s att
+*            allokatorn inte sjlv behver lagra storleken p varje block.
+**************************************************************************************************/
+struct allocator
+{
+   void* (*allocate)(void* context, size_t size); /* Allokerar nytt minnesblock. */
+   void* (*reallocate)(void* context, void* block, 
+                       size_t old_size, size_t new_size); /* Omallokerar minnesblock. */
+   void (*deallocate)(void* context, void* block, size_t size); /* Frigr minnesblock. */
+   void* context; /* Pekare till allokatorns tillstnd, exempelvis en arena. */
+};
+
+/**************************************************************************************************
+* allocator_allocate: Allokerar ett minnesblock av angiven storlek via angiven allokator och
+*                     returnerar en pekare till blocket. Vid misslyckad allokering returneras null.
+*
+*                     - self: Pekare till allokatorn (null = malloc).
+*                     - size: Minnesblockets storlek i byte.
+**************************************************************************************************/
+void* allocator_allocate(const struct allocator* self,
+                         const size_t size);
+
+/**************************************************************************************************
+* allocator_reallocate: Omallokerar ett minnesblock via angiven allokator och returnerar en
+*                       pekare till det nya blocket. Vid misslyckad omallokering returneras null,
+*                       varvid det ursprungliga blocket bibehlls.
+*
+*                       - self    : Pekare till allokatorn (null = realloc).
+*                       - block   : Pekare till minnesblocket som ska omallokeras (eller null).
+*                       - old_size: Minnesblockets nuvarande storlek i byte.
+*                       - new_size: Minnesblockets nya storlek i byte.
+**************************************************************************************************/
+void* allocator_reallocate(const struct allocator* self,
+                           void* block,
+                           const size_t old_size,
+                           const size_t new_size);
+
+/**************************************************************************************************
+* allocator_deallocate: Frigr ett minnesblock via angiven allokator.
+*
+*                       - self : Pekare till allokatorn (null = free).
+*                       - block: Pekare till minnesblocket som ska frigras (eller null).
+*                       - size : Minnesblockets storlek i byte.
+**************************************************************************************************/
+void allocator_deallocate(const struct allocator* self,
+                          void* block,
+                          const size_t size);
+
+#endif /* ALLOCATOR_H_ */
@@ -0,0 +1,194 @@
+/**************************************************************************************************
+* arena.c: Innehller definitioner av associerade funktioner fr strukten arena, som anvnds
+*          fr snabb allokering av kortlivat minne som frigrs p en gng.
+**************************************************************************************************/
+#include "arena.h"
+
+/**************************************************************************************************
+* ARENA_ALIGN: Avrundar angivet antal byte uppt till nrmaste multipel av ARENA_ALIGNMENT.
+*
+* ARENA_CHUNK_HEADER_SIZE: Storleken p huvudet i brjan av varje minnesblock, avrundad s att
+*                          utdelat minne hamnar p en justerad adress.
+**************************************************************************************************/
+#define ARENA_ALIGN(size) (((size) + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1))
+#define ARENA_CHUNK_HEADER_SIZE ARENA_ALIGN(sizeof(struct arena_chunk))
+
+/* Statiska funktioner: */
+static void* arena_allocate(void* context, size_t size);
+static void* arena_reallocate(void* context, void* block, size_t old_size, size_t new_size);
+static void arena_deallocate(void* context, void* block, size_t size);
+static unsigned char* arena_chunk_data(struct arena_chunk* self);
+
+/**************************************************************************************************
+* arena_init: Initierar ny tom arena. Inget minne allokeras frrn det frsta blocket begrs.
+*
+*             - self      : Pekare till arenan som ska initieras.
+*             - chunk_size: Minsta storlek i byte p arenans minnesblock (0 = default-storlek).
+**************************************************************************************************/
+void arena_init(struct arena* self,
+                const size_t chunk_size)
+{
+   self->allocator.allocate = arena_allocate;
+   self->allocator.reallocate = arena_reallocate;
+   self->allocator.deallocate = arena_deallocate;
+   self->allocator.context = self;
+   self->first = 0;
+   self->current = 0;
+   self->last_block = 0;
+   self->chunk_size = chunk_size ? ARENA_ALIGN(chunk_size) : ARENA_DEFAULT_CHUNK_SIZE;
+   return;
+}
+
+/**************************************************************************************************
+* arena_reset: Frigr samtliga minnesblock som har delats ut av arenan p en gng. Arenans
+*              stora minnesblock behlls fr teranvndning. Pekare till tidigare utdelat minne
+*              blir ogiltiga, exempelvis fltet i vektorer som anvnder arenan.
+*
+*              - self: Pekare till arenan som ska terstllas.
+**************************************************************************************************/
+void arena_reset(struct arena* self)
+{
+   for (struct arena_chunk* i = self->first; i; i = i->next)
+   {
+      i->used = 0;
+   }
+
+   self->current = self->first;
+   self->last_block = 0;
+   return;
+}
+
+/**************************************************************************************************
+* arena_clear: Frigr allt minne som har allokerats av arenan och terstller arenan till tom.
+*
+*              - self: Pekare till arenan som ska tmmas.
+**************************************************************************************************/
+void arena_clear(struct arena* self)
+{
+   struct arena_chunk* i = self->first;
+
+   while (i)
+   {
+      struct arena_chunk* next = i->next;
+      free(i);
+      i = next;
+   }
+
+   self->first = 0;
+   self->current = 0;
+   self->last_block = 0;
+   return;
+}
+
+/**************************************************************************************************
+* arena_allocate: Delar ut ett minnesblock av angiven storlek frn arenans aktuella minnesblock.
+*                 Ifall utrymmet inte rcker anvnds nsta minnesblock, alternativt allokeras
+*                 ett nytt minnesblock som rymmer minst det begrda antalet byte.
+*
+*                 - context: Pekare till arenan.
+*                 - size   : Det begrda minnesblockets storlek i byte.
+**************************************************************************************************/
+static void* arena_allocate(void* context, size_t size)
+{
+   struct arena* self = (struct arena*)context;
+   if (size > SIZE_MAX - ARENA_CHUNK_HEADER_SIZE - ARENA_ALIGNMENT) return 0;
+   size = ARENA_ALIGN(size);
+
+   while (self->current && self->current->capacity - self->current->used < size)
+   {
+      const struct arena_chunk* next = self->current->next;
+      if (!next || next->capacity - next->used < size) break;
+      self->current = self->current->next;
+   }
+
+   if (!self->current || self->current->capacity - self->current->used < size)
+   {
+      const size_t capacity = size > self->chunk_size ? size : self->chunk_size;
+      struct arena_chunk* chunk = (struct arena_chunk*)malloc(ARENA_CHUNK_HEADER_SIZE + capacity);
+      if (!chunk) return 0;
+      chunk->capacity = capacity;
+      chunk->used = 0;
+
+      if (self->current)
+      {
+         chunk->next = self->current->next;
+         self->current->next = chunk;
+      }
+      else
+      {
+         chunk->next = self->first;
+         self->first = chunk;
+      }
+
+      self->current = chunk;
+   }
+
+   unsigned char* block = arena_chunk_data(self->current) + self->current->used;
+   self->current->used += size;
+   self->last_block = block;
+   return block;
+}
+
+/**************************************************************************************************
+* arena_reallocate: Omallokerar ett minnesblock. Ifall blocket r det senast utdelade och det
+*                   finns plats kvar i det aktuella minnesblocket utkas det p plats, annars
+*                   delas ett nytt block ut och innehllet kopieras dit.
+*
+*                   - context : Pekare till arenan.
+*                   - block   : Pekare till minnesblocket som ska omallokeras.
+*                   - old_size: Minnesblockets nuvarande storlek i byte.
+*                   - new_size: Minnesblockets nya storlek i byte.
+**************************************************************************************************/
+static void* arena_reallocate(void* context, void* block, size_t old_size, size_t new_size)
+{
+   struct arena* self = (struct arena*)context;
+
+   if ((unsigned char*)block == self->last_block && new_size <= SIZE_MAX - ARENA_ALIGNMENT)
+   {
+      const size_t offset = (size_t)(self->last_block - arena_chunk_data(self->current));
+
+      if (ARENA_ALIGN(new_size) <= self->current->capacity - offset)
+      {
+         self->current->used = offset + ARENA_ALIGN(new_size);
+         return block;
+      }
+   }
+
+   void* copy = arena_allocate(self, new_size);
+   if (!copy) return 0;
+   memcpy(copy, block, old_size < new_size ? old_size : new_size);
+   return copy;
+}
+
+/**************************************************************************************************
+* arena_deallocate: terlmnar ett minnesblock till arenan ifall det r det senast utdelade.
+*                   vriga block frigrs frst nr arenan terstlls.
+*
+*                   - context: Pekare till arenan.
+*                   - block  : Pekare till minnesblocket som ska frigras.
+*                   - size   : Minnesblockets storlek i byte.
+**************************************************************************************************/
+static void arena_deallocate(void* context, void* block, size_t size)
+{
+   struct arena* self = (struct arena*)context;
+   (void)size;
+
+   if ((unsigned char*)block == self->last_block)
+   {
+      self->current->used = (size_t)(self->last_block - arena_chunk_data(self->current));
+      self->last_block = 0;
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* arena_chunk_data: Returnerar adressen till det frsta byte som kan delas ut frn angivet
+*                   minnesblock, dvs. direkt efter minnesblockets huvud.
+*
+*                   - self: Pekare till minnesblocket.
+**************************************************************************************************/
+static unsigned char* arena_chunk_data(struct arena_chunk* self)
+{
+   return (unsigned char*)self + ARENA_CHUNK_HEADER_SIZE;
+}
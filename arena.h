@@ -0,0 +1,75 @@
+/**************************************************************************************************
+* arena.h: Implementering av en arena, dvs. en allokator som delar ut minne genom att enbart
+*          flytta fram en pekare i stora frallokerade minnesblock (bump pointer). Enskilda
+*          minnesblock frigrs normalt inte, i stllet frigrs allt minne som delats ut av arenan
+*          p en gng via ett anrop av funktionen arena_reset. Detta lmpar sig vl fr ett stort
+*          antal kortlivade vektorer, exempelvis samtliga vektorer som anvnds under en frfrgan.
+*
+*          Arenan r inte trdsker, anvnd drfr en arena per trd.
+**************************************************************************************************/
+#ifndef ARENA_H_
+#define ARENA_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "allocator.h"
+
+/**************************************************************************************************
+* ARENA_ALIGNMENT: Justering i byte fr samtliga minnesblock som delas ut av arenan.
+*
+* ARENA_DEFAULT_CHUNK_SIZE: Default-storlek i byte p de stora minnesblock som arenan allokerar.
+**************************************************************************************************/
+#define ARENA_ALIGNMENT 16
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+/**************************************************************************************************
+* arena_chunk: Stort minnesblock allokerat av arenan, frn vilket mindre block delas ut.
+**************************************************************************************************/
+struct arena_chunk
+{
+   struct arena_chunk* next; /* Pekare till nsta minnesblock i arenan. */
+   size_t capacity;          /* Antalet byte som kan delas ut frn minnesblocket. */
+   size_t used;              /* Antalet byte som har delats ut hittills. */
+};
+
+/**************************************************************************************************
+* arena: Bump pointer-allokator. Medlemmen allocator kan passeras till exempelvis en vektor,
+*        varvid vektorns minne allokeras frn arenan.
+**************************************************************************************************/
+struct arena
+{
+   struct allocator allocator;   /* Allokatorgrnssnitt med arenan som kontext. */
+   struct arena_chunk* first;    /* Pekare till arenans frsta minnesblock. */
+   struct arena_chunk* current;  /* Pekare till minnesblocket som minne delas ut frn. */
+   unsigned char* last_block;    /* Senast utdelade block, kan utkas eller terlmnas. */
+   size_t chunk_size;            /* Minsta storlek p nya minnesblock i byte. */
+};
+
+/**************************************************************************************************
+* arena_init: Initierar ny tom arena. Inget minne allokeras frrn det frsta blocket begrs.
+*
+*             - self      : Pekare till arenan som ska initieras.
+*             - chunk_size: Minsta storlek i byte p arenans minnesblock (0 = default-storlek).
+**************************************************************************************************/
+void arena_init(struct arena* self,
+                const size_t chunk_size);
+
+/**************************************************************************************************
+* arena_reset: Frigr samtliga minnesblock som har delats ut av arenan p en gng. Arenans
+*              stora minnesblock behlls fr teranvndning. Pekare till tidigare utdelat minne
+*              blir ogiltiga, exempelvis fltet i vektorer som anvnder arenan.
+*
+*              - self: Pekare till arenan som ska terstllas.
+**************************************************************************************************/
+void arena_reset(struct arena* self);
+
+/**************************************************************************************************
+* arena_clear: Frigr allt minne som har allokerats av arenan och terstller arenan till tom.
+*
+*              - self: Pekare till arenan som ska tmmas.
+**************************************************************************************************/
+void arena_clear(struct arena* self);
+
+#endif /* ARENA_H_ */
@@ -0,0 +1,27 @@
+/**************************************************************************************************
+* crc32c.h: Berkning av kontrollsumman CRC-32C (Castagnoli), som anvnds fr att upptcka
+*           frndrat eller skadat innehll, exempelvis i filer sparade via int_vector_save.
+*           Processorns CRC32-instruktion (SSE4.2 eller ARM CRC32) anvnds ifall den stds.
+**************************************************************************************************/
+#ifndef CRC32C_H_
+#define CRC32C_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**************************************************************************************************
+* crc32c: Returnerar kontrollsumman fr angivet minnesomrde. Kontrollsumman fr ett omrde som
+*         delats upp i flera delar kan berknas stegvis genom att passera returvrdet fr
+*         fregende del som startvrde, dr 0 anvnds som startvrde fr den frsta delen.
+*
+*         - crc : Kontrollsumman fr fregende data (0 vid start).
+*         - data: Pekare till minnesomrdet vars kontrollsumma ska berknas.
+*         - size: Minnesomrdets storlek i byte.
+**************************************************************************************************/
+uint32_t crc32c(const uint32_t crc,
+                const void* data,
+                const size_t size);
+
+#endif /* CRC32C_H_ */
@@ -101,6 +101,7 @@
 ********************************************************************************/
 #include <stdio.h>  /* Innehller funktionalitet fr utskrift och inmatning. */
 #include <stdlib.h> /* Innehller funktionalitet fr dynamisk minnesallokering. */
+#include "int_format.h" /* Innehller funktionalitet fr snabb utskrift av heltal. */
 
 /********************************************************************************
 * int_array_assign: Fyller arrayen till bredden med heltal med angivet stegvrde.
@@ -124,7 +125,8 @@ static void int_array_assign(int* self,
 /********************************************************************************
 * int_array_print: Skriver ut heltal lagrade i array via angiven utstrm, dr
 *                  standardutenhet stdout anvnds som default fr utskrift
-*                  i terminalen.
+*                  i terminalen. Heltalen formateras via int_format och skrivs
+*                  ut i stora block i stllet fr ett fprintf-anrop per tal.
 *
 *                   - self   : Pekare till arrayen vars innehll ska skrivas ut.
 *                   - size   : Arrayens storlek, dvs. antalet heltal den rymmer.
@@ -137,10 +139,7 @@ static void int_array_print(const int* self,
    if (!ostream) ostream = stdout;
    fprintf(ostream, "----------------------------------------------------------------------------\n");
 
-   for (size_t i = 0; i < size; ++i)
-   {
-      fprintf(ostream, "%d\n", self[i]);
-   }
+   int_format_write(ostream, self, size, 0, 0);
 
    fprintf(ostream, "----------------------------------------------------------------------------\n\n");
    return;
@@ -0,0 +1,281 @@
+/**************************************************************************************************
+* huge_allocator.c: Innehller definitioner av associerade funktioner fr strukten
+*                   huge_allocator, som anvnds fr justerade samt minnesmappade block fr stora
+*                   vektorer.
+**************************************************************************************************/
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* Krvs fr mremap. */
+#endif
+
+#include "huge_allocator.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/* Statiska funktioner: */
+static void* huge_allocator_allocate(void* context, size_t size);
+static void* huge_allocator_reallocate(void* context, void* block, size_t old_size,
+                                       size_t new_size);
+static void huge_allocator_deallocate(void* context, void* block, size_t size);
+static size_t huge_allocator_round(const size_t size, const size_t alignment);
+static void* huge_allocator_aligned(const size_t size);
+static void huge_allocator_free(void* block);
+
+#ifndef _WIN32
+static size_t huge_allocator_page_size(void);
+static void* huge_allocator_map(const size_t size);
+static void huge_allocator_advise(void* block, const size_t length);
+#endif
+
+/**************************************************************************************************
+* huge_allocator_init: Initierar ny allokator med angivet trskelvrde. Inget minne allokeras
+*                      frrn det frsta blocket begrs.
+*
+*                      - self     : Pekare till allokatorn som ska initieras.
+*                      - threshold: Minsta storlek i byte fr minnesmappade block
+*                                   (0 = HUGE_ALLOCATOR_DEFAULT_THRESHOLD).
+**************************************************************************************************/
+void huge_allocator_init(struct huge_allocator* self,
+                         const size_t threshold)
+{
+   self->allocator.allocate = huge_allocator_allocate;
+   self->allocator.reallocate = huge_allocator_reallocate;
+   self->allocator.deallocate = huge_allocator_deallocate;
+   self->allocator.context = self;
+   self->threshold = threshold ? threshold : HUGE_ALLOCATOR_DEFAULT_THRESHOLD;
+   return;
+}
+
+/**************************************************************************************************
+* huge_allocator_mapped: Indikerar ifall ett minnesblock av angiven storlek mappas via mmap av
+*                        angiven allokator.
+*
+*                        - self: Pekare till allokatorn.
+*                        - size: Minnesblockets storlek i byte.
+**************************************************************************************************/
+int huge_allocator_mapped(const struct huge_allocator* self,
+                          const size_t size)
+{
+#ifdef _WIN32
+   (void)self;
+   (void)size;
+   return 0;
+#else
+   return size >= self->threshold;
+#endif
+}
+
+/**************************************************************************************************
+* huge_allocator_allocate: Allokerar ett justerat minnesblock, som mappas via mmap ifall
+*                          storleken nr upp till allokatorns trskelvrde.
+*
+*                          - context: Pekare till allokatorn.
+*                          - size   : Det begrda minnesblockets storlek i byte.
+**************************************************************************************************/
+static void* huge_allocator_allocate(void* context, size_t size)
+{
+#ifndef _WIN32
+   if (huge_allocator_mapped((const struct huge_allocator*)context, size))
+   {
+      return huge_allocator_map(size);
+   }
+#else
+   (void)context;
+#endif
+   return huge_allocator_aligned(size);
+}
+
+/**************************************************************************************************
+* huge_allocator_reallocate: Omallokerar ett minnesblock. Mappade block som frblir mappade
+*                            vxer p plats via mremap, eller flyttas annars via mremap utan
+*                            kopiering till ett nytt justerat block. vriga block kopieras till ett
+*                            nytt justerat eller mappat block, eftersom realloc inte bibehller
+*                            justeringen. Ifall blockets avrundade storlek r ofrndrad
+*                            returneras samma block.
+*
+*                            - context : Pekare till allokatorn.
+*                            - block   : Pekare till minnesblocket som ska omallokeras.
+*                            - old_size: Minnesblockets nuvarande storlek i byte.
+*                            - new_size: Minnesblockets nya storlek i byte.
+**************************************************************************************************/
+static void* huge_allocator_reallocate(void* context, void* block, size_t old_size,
+                                       size_t new_size)
+{
+   const struct huge_allocator* self = (const struct huge_allocator*)context;
+   const int old_mapped = huge_allocator_mapped(self, old_size);
+   const int new_mapped = huge_allocator_mapped(self, new_size);
+
+#ifndef _WIN32
+   if (old_mapped && new_mapped)
+   {
+      const size_t page_size = huge_allocator_page_size();
+      const size_t old_length = huge_allocator_round(old_size, page_size);
+      const size_t new_length = huge_allocator_round(new_size, page_size);
+      if (!new_length) return 0;
+      if (old_length == new_length) return block;
+#ifdef __linux__
+      void* moved = mremap(block, old_length, new_length, 0);
+
+      if (moved == MAP_FAILED)
+      {
+         void* target = huge_allocator_map(new_size);
+         if (!target) return 0;
+         moved = mremap(block, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+
+         if (moved == MAP_FAILED)
+         {
+            munmap(target, new_length);
+            return 0;
+         }
+      }
+
+      if (new_length > old_length) huge_allocator_advise(moved, new_length);
+      return moved;
+#endif
+   }
+#endif
+
+   if (!old_mapped && !new_mapped)
+   {
+      const size_t old_rounded = huge_allocator_round(old_size, HUGE_ALLOCATOR_ALIGNMENT);
+      const size_t new_rounded = huge_allocator_round(new_size, HUGE_ALLOCATOR_ALIGNMENT);
+      if (new_rounded && old_rounded == new_rounded) return block;
+   }
+
+   void* copy = huge_allocator_allocate(context, new_size);
+   if (!copy) return 0;
+   memcpy(copy, block, old_size < new_size ? old_size : new_size);
+   huge_allocator_deallocate(context, block, old_size);
+   return copy;
+}
+
+/**************************************************************************************************
+* huge_allocator_deallocate: Frigr ett minnesblock via munmap eller free beroende p blockets
+*                            storlek.
+*
+*                            - context: Pekare till allokatorn.
+*                            - block  : Pekare till minnesblocket som ska frigras.
+*                            - size   : Minnesblockets storlek i byte.
+**************************************************************************************************/
+static void huge_allocator_deallocate(void* context, void* block, size_t size)
+{
+#ifndef _WIN32
+   if (huge_allocator_mapped((const struct huge_allocator*)context, size))
+   {
+      munmap(block, huge_allocator_round(size, huge_allocator_page_size()));
+      return;
+   }
+#else
+   (void)context;
+   (void)size;
+#endif
+   huge_allocator_free(block);
+   return;
+}
+
+/**************************************************************************************************
+* huge_allocator_round: Avrundar angiven storlek uppt till nrmaste multipel av angiven
+*                       justering, som mste vara en tvpotens. Vid verspill returneras 0.
+*
+*                       - size     : Storleken i byte som ska avrundas.
+*                       - alignment: Justeringen i byte.
+**************************************************************************************************/
+static size_t huge_allocator_round(const size_t size, const size_t alignment)
+{
+   if (size > SIZE_MAX - (alignment - 1)) return 0;
+   return (size + alignment - 1) & ~(alignment - 1);
+}
+
+/**************************************************************************************************
+* huge_allocator_aligned: Allokerar ett minnesblock p heapen justerat till
+*                         HUGE_ALLOCATOR_ALIGNMENT byte. Storleken avrundas uppt till en
+*                         multipel av justeringen, vilket krvs av aligned_alloc.
+*
+*                         - size: Det begrda minnesblockets storlek i byte.
+**************************************************************************************************/
+static void* huge_allocator_aligned(const size_t size)
+{
+   const size_t rounded = huge_allocator_round(size ? size : 1, HUGE_ALLOCATOR_ALIGNMENT);
+   if (!rounded) return 0;
+#ifdef _WIN32
+   return _aligned_malloc(rounded, HUGE_ALLOCATOR_ALIGNMENT);
+#else
+   return aligned_alloc(HUGE_ALLOCATOR_ALIGNMENT, rounded);
+#endif
+}
+
+/**************************************************************************************************
+* huge_allocator_free: Frigr ett minnesblock allokerat via huge_allocator_aligned.
+*
+*                      - block: Pekare till minnesblocket som ska frigras.
+**************************************************************************************************/
+static void huge_allocator_free(void* block)
+{
+#ifdef _WIN32
+   _aligned_free(block);
+#else
+   free(block);
+#endif
+   return;
+}
+
+#ifndef _WIN32
+
+/**************************************************************************************************
+* huge_allocator_page_size: Returnerar systemets sidstorlek i byte.
+**************************************************************************************************/
+static size_t huge_allocator_page_size(void)
+{
+   const long page_size = sysconf(_SC_PAGESIZE);
+   return page_size > 0 ? (size_t)page_size : 4096;
+}
+
+/**************************************************************************************************
+* huge_allocator_map: Mappar ett nytt anonymt minnesblock av angiven storlek, avrundad uppt
+*                     till en multipel av sidstorleken, och ber systemet anvnda stora sidor.
+*                     Eftersom mmap enbart garanterar justering till sidstorleken mappas en stor
+*                     sida extra, varefter delarna fre och efter det justerade blocket frigrs.
+*                     Vid misslyckad mappning returneras null.
+*
+*                     - size: Det begrda minnesblockets storlek i byte.
+**************************************************************************************************/
+static void* huge_allocator_map(const size_t size)
+{
+   const size_t length = huge_allocator_round(size, huge_allocator_page_size());
+   if (!length || length > SIZE_MAX - HUGE_ALLOCATOR_HUGE_PAGE_SIZE) return 0;
+   char* mapping = (char*)mmap(0, length + HUGE_ALLOCATOR_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if ((void*)mapping == MAP_FAILED) return 0;
+
+   const size_t head = huge_allocator_round((uintptr_t)mapping, HUGE_ALLOCATOR_HUGE_PAGE_SIZE) -
+                       (uintptr_t)mapping;
+   char* block = mapping + head;
+   if (head) munmap(mapping, head);
+   munmap(block + length, HUGE_ALLOCATOR_HUGE_PAGE_SIZE - head);
+   huge_allocator_advise(block, length);
+   return block;
+}
+
+/**************************************************************************************************
+* huge_allocator_advise: Ber systemet anvnda stora sidor fr angivet mappat minnesblock, dr
+*                        detta stds. Rdet r enbart en hint, varfr eventuella fel ignoreras.
+*
+*                        - block : Pekare till det mappade minnesblocket.
+*                        - length: Minnesblockets lngd i byte.
+**************************************************************************************************/
+static void huge_allocator_advise(void* block, const size_t length)
+{
+#ifdef MADV_HUGEPAGE
+   (void)madvise(block, length, MADV_HUGEPAGE);
+#else
+   (void)block;
+   (void)length;
+#endif
+   return;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,73 @@
+/**************************************************************************************************
+* huge_allocator.h: Implementering av en allokator fr stora vektorer. Samtliga minnesblock
+*                   justeras till HUGE_ALLOCATOR_ALIGNMENT byte, vilket motsvarar en cache-rad
+*                   och medger justerade SIMD-laddningar. Minnesblock som r minst lika stora som
+*                   allokatorns trskelvrde mappas i stllet direkt via mmap, varefter systemet
+*                   ombeds anvnda stora sidor (transparent huge pages) via madvise, vilket
+*                   minskar antalet TLB-missar vid genomlsning av hundratals miljoner element.
+*                   Mappade block startar p en multipel av HUGE_ALLOCATOR_HUGE_PAGE_SIZE, s
+*                   att hela blocket utom en eventuell ofullstndig stor sida i slutet kan
+*                   lagras p stora sidor. Mappade block vxer via mremap, vilket flyttar sidorna
+*                   utan att innehllet kopieras och utan att justeringen gr frlorad.
+*
+*                   Allokatorn passeras till exempelvis int_vector_new_with_allocator, varefter
+*                   samtliga omallokeringar av vektorn (int_vector_resize, int_vector_push osv.)
+*                   sker via allokatorn. Allokatorn saknar frnderligt tillstnd och r drmed
+*                   trdsker. P system som saknar mmap anvnds enbart justerad heapallokering.
+**************************************************************************************************/
+#ifndef HUGE_ALLOCATOR_H_
+#define HUGE_ALLOCATOR_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "allocator.h"
+
+/**************************************************************************************************
+* HUGE_ALLOCATOR_ALIGNMENT: Justering i byte fr samtliga minnesblock som delas ut.
+*
+* HUGE_ALLOCATOR_HUGE_PAGE_SIZE: Storleken p en stor sida p x86-64 i byte, vilket ven utgr
+*                                justeringen fr minnesmappade block.
+*
+* HUGE_ALLOCATOR_DEFAULT_THRESHOLD: Default-trskelvrde i byte fr minnesmappade block, vilket
+*                                   motsvarar storleken p en stor sida.
+**************************************************************************************************/
+#define HUGE_ALLOCATOR_ALIGNMENT 64
+#define HUGE_ALLOCATOR_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define HUGE_ALLOCATOR_DEFAULT_THRESHOLD HUGE_ALLOCATOR_HUGE_PAGE_SIZE
+
+/**************************************************************************************************
+* huge_allocator: Allokator fr justerade och minnesmappade block. Medlemmen allocator kan
+*                 passeras till exempelvis en vektor, varvid vektorns minne allokeras via
+*                 allokatorn. Huruvida ett block r mappat avgrs av blockets storlek, som
+*                 passeras av vektorn vid varje omallokering och frigrande.
+**************************************************************************************************/
+struct huge_allocator
+{
+   struct allocator allocator; /* Allokatorgrnssnitt med allokatorn som kontext. */
+   size_t threshold;           /* Minsta storlek i byte fr minnesmappade block. */
+};
+
+/**************************************************************************************************
+* huge_allocator_init: Initierar ny allokator med angivet trskelvrde. Inget minne allokeras
+*                      frrn det frsta blocket begrs.
+*
+*                      - self     : Pekare till allokatorn som ska initieras.
+*                      - threshold: Minsta storlek i byte fr minnesmappade block
+*                                   (0 = HUGE_ALLOCATOR_DEFAULT_THRESHOLD).
+**************************************************************************************************/
+void huge_allocator_init(struct huge_allocator* self,
+                         const size_t threshold);
+
+/**************************************************************************************************
+* huge_allocator_mapped: Indikerar ifall ett minnesblock av angiven storlek mappas via mmap av
+*                        angiven allokator.
+*
+*                        - self: Pekare till allokatorn.
+*                        - size: Minnesblockets storlek i byte.
+**************************************************************************************************/
+int huge_allocator_mapped(const struct huge_allocator* self,
+                          const size_t size);
+
+#endif /* HUGE_ALLOCATOR_H_ */
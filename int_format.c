@@ -0,0 +1,123 @@
+/**************************************************************************************************
+* int_format.c: Innehller definitioner av funktioner fr snabb formatering och utskrift av
+*               heltal, som anvnds i stllet fr fprintf vid utskrift av stora mngder heltal.
+**************************************************************************************************/
+#include "int_format.h"
+
+/**************************************************************************************************
+* int_format_digit_pairs: Tabell med samtliga tvsiffriga tal 00 - 99, dr talet n lagras p
+*                         index 2n och 2n + 1. Drmed kan tv siffror skrivas per division.
+**************************************************************************************************/
+static const char int_format_digit_pairs[201] =
+   "0001020304050607080910111213141516171819"
+   "2021222324252627282930313233343536373839"
+   "4041424344454647484950515253545556575859"
+   "6061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
+
+/**************************************************************************************************
+* int_format: Skriver angivet heltal som text till angiven destination, utan avslutande
+*             nolltecken, och returnerar antalet skrivna tecken.
+*
+*             - s    : Pekare till destinationen, som mste rymma minst INT_FORMAT_MAX_LENGTH
+*                      tecken.
+*             - value: Heltalet som ska formateras.
+**************************************************************************************************/
+size_t int_format(char* s,
+                  const int value)
+{
+   char digits[10];
+   char* first = digits + sizeof(digits);
+   unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+   size_t length = 0;
+
+   while (magnitude >= 100)
+   {
+      const unsigned int index = (magnitude % 100) * 2;
+      magnitude /= 100;
+      first -= 2;
+      first[0] = int_format_digit_pairs[index];
+      first[1] = int_format_digit_pairs[index + 1];
+   }
+
+   if (magnitude >= 10)
+   {
+      first -= 2;
+      first[0] = int_format_digit_pairs[magnitude * 2];
+      first[1] = int_format_digit_pairs[magnitude * 2 + 1];
+   }
+   else
+   {
+      *--first = (char)('0' + magnitude);
+   }
+
+   if (value < 0) s[length++] = '-';
+   memcpy(s + length, first, (size_t)(digits + sizeof(digits) - first));
+   return length + (size_t)(digits + sizeof(digits) - first);
+}
+
+/**************************************************************************************************
+* int_format_lines: Skriver angivna heltal som text till angiven destination, med en radbrytning
+*                   efter varje heltal, och returnerar antalet skrivna tecken. Inget avslutande
+*                   nolltecken skrivs.
+*
+*                   - s   : Pekare till destinationen, som mste rymma minst
+*                           INT_FORMAT_MAX_LENGTH x size tecken.
+*                   - data: Pekare till fltet innehllande heltalen som ska formateras.
+*                   - size: Antalet heltal som ska formateras.
+**************************************************************************************************/
+size_t int_format_lines(char* s,
+                        const int* data,
+                        const size_t size)
+{
+   char* i = s;
+
+   for (size_t j = 0; j < size; ++j)
+   {
+      i += int_format(i, data[j]);
+      *i++ = '\n';
+   }
+
+   return (size_t)(i - s);
+}
+
+/**************************************************************************************************
+* int_format_write: Skriver angivna heltal via angiven utstrm, ett heltal per rad. Texten samlas
+*                   i angiven buffert och skrivs via fwrite varje gng bufferten r full. Vid
+*                   lyckad utskrift returneras 0, annars returneras felkod 1.
+*
+*                   - ostream    : Pekare till angiven utstrm (default = stdout).
+*                   - data       : Pekare till fltet innehllande heltalen som ska skrivas ut.
+*                   - size       : Antalet heltal som ska skrivas ut.
+*                   - buffer     : Pekare till bufferten (null = intern buffert p stacken).
+*                   - buffer_size: Buffertens storlek i byte, minst INT_FORMAT_MAX_LENGTH.
+**************************************************************************************************/
+int int_format_write(FILE* ostream,
+                     const int* data,
+                     const size_t size,
+                     char* buffer,
+                     const size_t buffer_size)
+{
+   char local_buffer[INT_FORMAT_BUFFER_SIZE];
+   size_t capacity = buffer_size;
+   size_t i = 0;
+
+   if (!ostream) ostream = stdout;
+
+   if (!buffer || buffer_size < INT_FORMAT_MAX_LENGTH)
+   {
+      buffer = local_buffer;
+      capacity = sizeof(local_buffer);
+   }
+
+   while (i < size)
+   {
+      size_t count = capacity / INT_FORMAT_MAX_LENGTH;
+      if (count > size - i) count = size - i;
+      const size_t length = int_format_lines(buffer, data + i, count);
+      if (fwrite(buffer, 1, length, ostream) != length) return 1;
+      i += count;
+   }
+
+   return 0;
+}
@@ -0,0 +1,66 @@
+/**************************************************************************************************
+* int_format.h: Snabb formatering av heltal till text utan anrop av fprintf. Varje heltal
+*               omvandlas till siffror tv i taget via en tabell med tvsiffriga tal, varefter
+*               texten samlas i en stor buffert som skrivs till utstrmmen i stora block via
+*               fwrite. Utskriften blir identisk med fprintf(ostream, "%d\n", value) per element.
+**************************************************************************************************/
+#ifndef INT_FORMAT_H_
+#define INT_FORMAT_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**************************************************************************************************
+* INT_FORMAT_MAX_LENGTH: Maximalt antal tecken fr ett formaterat heltal inklusive radbrytning
+*                        (exempelvis "-2147483648\n").
+*
+* INT_FORMAT_BUFFER_SIZE: Default-storlek i byte p bufferten som anvnds vid utskrift.
+**************************************************************************************************/
+#define INT_FORMAT_MAX_LENGTH 12
+#define INT_FORMAT_BUFFER_SIZE (64 * 1024)
+
+/**************************************************************************************************
+* int_format: Skriver angivet heltal som text till angiven destination, utan avslutande
+*             nolltecken, och returnerar antalet skrivna tecken.
+*
+*             - s    : Pekare till destinationen, som mste rymma minst INT_FORMAT_MAX_LENGTH
+*                      tecken.
+*             - value: Heltalet som ska formateras.
+**************************************************************************************************/
+size_t int_format(char* s,
+                  const int value);
+
+/**************************************************************************************************
+* int_format_lines: Skriver angivna heltal som text till angiven destination, med en radbrytning
+*                   efter varje heltal, och returnerar antalet skrivna tecken. Inget avslutande
+*                   nolltecken skrivs.
+*
+*                   - s   : Pekare till destinationen, som mste rymma minst
+*                           INT_FORMAT_MAX_LENGTH x size tecken.
+*                   - data: Pekare till fltet innehllande heltalen som ska formateras.
+*                   - size: Antalet heltal som ska formateras.
+**************************************************************************************************/
+size_t int_format_lines(char* s,
+                        const int* data,
+                        const size_t size);
+
+/**************************************************************************************************
+* int_format_write: Skriver angivna heltal via angiven utstrm, ett heltal per rad. Texten samlas
+*                   i angiven buffert och skrivs via fwrite varje gng bufferten r full. Vid
+*                   lyckad utskrift returneras 0, annars returneras felkod 1.
+*
+*                   - ostream    : Pekare till angiven utstrm (default = stdout).
+*                   - data       : Pekare till fltet innehllande heltalen som ska skrivas ut.
+*                   - size       : Antalet heltal som ska skrivas ut.
+*                   - buffer     : Pekare till bufferten (null = intern buffert p stacken).
+*                   - buffer_size: Buffertens storlek i byte, minst INT_FORMAT_MAX_LENGTH.
+**************************************************************************************************/
+int int_format_write(FILE* ostream,
+                     const int* data,
+                     const size_t size,
+                     char* buffer,
+                     const size_t buffer_size);
+
+#endif /* INT_FORMAT_H_ */
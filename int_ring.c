@@ -0,0 +1,237 @@
+/**************************************************************************************************
+* int_ring.c: Innehller definitioner av associerade funktioner fr strukten int_ring, som anvnds
+*             fr lsfri verfring av heltal mellan en producenttrd och en konsumenttrd.
+**************************************************************************************************/
+#include "int_ring.h"
+
+/* Statiska funktioner: */
+static size_t int_ring_free_space(struct int_ring* self,
+                                  const size_t tail,
+                                  const size_t n);
+static size_t int_ring_available(struct int_ring* self,
+                                 const size_t head,
+                                 const size_t n);
+
+/**************************************************************************************************
+* int_ring_init: Initierar ny ringbuffert med angiven kapacitet, som avrundas uppt till nrmaste
+*                tvpotens. Vid lyckad initiering returneras 0, annars returneras felkod 1.
+*
+*                - self    : Pekare till ringbufferten som ska initieras.
+*                - capacity: Minsta antal element som ska rymmas i bufferten.
+**************************************************************************************************/
+int int_ring_init(struct int_ring* self,
+                  const size_t capacity)
+{
+   return int_ring_init_with_allocator(self, capacity, 0);
+}
+
+/**************************************************************************************************
+* int_ring_init_with_allocator: Initierar ny ringbuffert med angiven kapacitet, dr fltet
+*                               allokeras via angiven allokator, se int_ring_init.
+*
+*                               - self     : Pekare till ringbufferten som ska initieras.
+*                               - capacity : Minsta antal element som ska rymmas i bufferten.
+*                               - allocator: Pekare till allokatorn (null = standardallokatorn).
+**************************************************************************************************/
+int int_ring_init_with_allocator(struct int_ring* self,
+                                 const size_t capacity,
+                                 const struct allocator* allocator)
+{
+   size_t size = 1;
+
+   while (size < capacity)
+   {
+      if (size > SIZE_MAX / 2 / sizeof(int)) return 1;
+      size *= 2;
+   }
+
+   self->data = (int*)allocator_allocate(allocator, sizeof(int) * size);
+   if (!self->data) return 1;
+
+   atomic_init(&self->head, 0);
+   atomic_init(&self->tail, 0);
+   self->cached_head = 0;
+   self->cached_tail = 0;
+   self->mask = size - 1;
+   self->allocator = allocator;
+   return 0;
+}
+
+/**************************************************************************************************
+* int_ring_clear: Frigr minnet som har allokerats fr angiven ringbuffert. Fr enbart anropas
+*                 d ingen trd lngre anvnder bufferten.
+*
+*                 - self: Pekare till ringbufferten som ska tmmas.
+**************************************************************************************************/
+void int_ring_clear(struct int_ring* self)
+{
+   allocator_deallocate(self->allocator, self->data, sizeof(int) * (self->mask + 1));
+   self->data = 0;
+   self->mask = 0;
+   atomic_store(&self->head, 0);
+   atomic_store(&self->tail, 0);
+   self->cached_head = 0;
+   self->cached_tail = 0;
+   return;
+}
+
+/**************************************************************************************************
+* int_ring_capacity: Returnerar antalet element som ryms i angiven ringbuffert.
+*
+*                    - self: Pekare till ringbufferten.
+**************************************************************************************************/
+size_t int_ring_capacity(const struct int_ring* self)
+{
+   return self->mask + 1;
+}
+
+/**************************************************************************************************
+* int_ring_size: Returnerar antalet element som fr tillfllet lagras i angiven ringbuffert.
+*                Vrdet r exakt fr den anropande producenten eller konsumenten s lnge den
+*                andra trden str still, annars r det en gonblicksbild.
+*
+*                - self: Pekare till ringbufferten.
+**************************************************************************************************/
+size_t int_ring_size(struct int_ring* self)
+{
+   const size_t head = atomic_load_explicit(&self->head, memory_order_acquire);
+   const size_t tail = atomic_load_explicit(&self->tail, memory_order_acquire);
+   return tail - head;
+}
+
+/**************************************************************************************************
+* int_ring_push: Lgger till ett nytt element lngst bak i angiven ringbuffert. Anropas enbart
+*                av producenten. Vid lyckad insttning returneras 0, annars returneras felkod 1
+*                ifall bufferten r full.
+*
+*                - self       : Pekare till ringbufferten.
+*                - new_element: Det nya element som ska lggas till.
+**************************************************************************************************/
+int int_ring_push(struct int_ring* self,
+                  const int new_element)
+{
+   const size_t tail = atomic_load_explicit(&self->tail, memory_order_relaxed);
+   if (!int_ring_free_space(self, tail, 1)) return 1;
+   self->data[tail & self->mask] = new_element;
+   atomic_store_explicit(&self->tail, tail + 1, memory_order_release);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_ring_pop: Tar ut det frsta elementet i angiven ringbuffert. Anropas enbart av
+*               konsumenten. Vid lyckat uttag returneras 0, annars returneras felkod 1 ifall
+*               bufferten r tom.
+*
+*               - self   : Pekare till ringbufferten.
+*               - element: Pekare till variabeln som ska tilldelas elementet.
+**************************************************************************************************/
+int int_ring_pop(struct int_ring* self,
+                 int* element)
+{
+   const size_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+   if (!int_ring_available(self, head, 1)) return 1;
+   *element = self->data[head & self->mask];
+   atomic_store_explicit(&self->head, head + 1, memory_order_release);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_ring_push_range: Lgger till upp till n element frn angivet flt lngst bak i angiven
+*                      ringbuffert. Elementen kopieras i hgst tv sammanhngande block och
+*                      publiceras fr konsumenten p en gng. Anropas enbart av producenten.
+*                      Antalet tillagda element returneras, vilket r frre n n om bufferten
+*                      blev full.
+*
+*                      - self: Pekare till ringbufferten.
+*                      - src : Pekare till fltet med elementen som ska lggas till.
+*                      - n   : Antalet element som ska lggas till.
+**************************************************************************************************/
+size_t int_ring_push_range(struct int_ring* self,
+                           const int* src,
+                           const size_t n)
+{
+   const size_t tail = atomic_load_explicit(&self->tail, memory_order_relaxed);
+   const size_t count = int_ring_free_space(self, tail, n);
+   const size_t index = tail & self->mask;
+   const size_t first = count < self->mask + 1 - index ? count : self->mask + 1 - index;
+
+   if (!count) return 0;
+   memcpy(self->data + index, src, sizeof(int) * first);
+   memcpy(self->data, src + first, sizeof(int) * (count - first));
+   atomic_store_explicit(&self->tail, tail + count, memory_order_release);
+   return count;
+}
+
+/**************************************************************************************************
+* int_ring_pop_range: Tar ut upp till n element frn angiven ringbuffert och kopierar dem till
+*                     angivet flt i hgst tv sammanhngande block. Anropas enbart av
+*                     konsumenten. Antalet uttagna element returneras, vilket r frre n n om
+*                     bufferten blev tom.
+*
+*                     - self: Pekare till ringbufferten.
+*                     - dest: Pekare till fltet som ska tilldelas elementen.
+*                     - n   : Maximalt antal element som ska tas ut.
+**************************************************************************************************/
+size_t int_ring_pop_range(struct int_ring* self,
+                          int* dest,
+                          const size_t n)
+{
+   const size_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+   const size_t count = int_ring_available(self, head, n);
+   const size_t index = head & self->mask;
+   const size_t first = count < self->mask + 1 - index ? count : self->mask + 1 - index;
+
+   if (!count) return 0;
+   memcpy(dest, self->data + index, sizeof(int) * first);
+   memcpy(dest + first, self->data, sizeof(int) * (count - first));
+   atomic_store_explicit(&self->head, head + count, memory_order_release);
+   return count;
+}
+
+/**************************************************************************************************
+* int_ring_free_space: Returnerar antalet lediga platser fr producenten, dock hgst n. Kopian
+*                      av konsumentens index anvnds i frsta hand, och det atomra indexet
+*                      lses enbart ifall kopian indikerar att frre n n platser r lediga.
+*
+*                      - self: Pekare till ringbufferten.
+*                      - tail: Producentens aktuella index.
+*                      - n   : nskat antal lediga platser.
+**************************************************************************************************/
+static size_t int_ring_free_space(struct int_ring* self,
+                                  const size_t tail,
+                                  const size_t n)
+{
+   size_t free_space = self->mask + 1 - (tail - self->cached_head);
+
+   if (free_space < n)
+   {
+      self->cached_head = atomic_load_explicit(&self->head, memory_order_acquire);
+      free_space = self->mask + 1 - (tail - self->cached_head);
+   }
+
+   return free_space < n ? free_space : n;
+}
+
+/**************************************************************************************************
+* int_ring_available: Returnerar antalet element som konsumenten kan ta ut, dock hgst n. Kopian
+*                     av producentens index anvnds i frsta hand, och det atomra indexet lses
+*                     enbart ifall kopian indikerar att frre n n element finns tillgngliga.
+*
+*                     - self: Pekare till ringbufferten.
+*                     - head: Konsumentens aktuella index.
+*                     - n   : nskat antal element.
+**************************************************************************************************/
+static size_t int_ring_available(struct int_ring* self,
+                                 const size_t head,
+                                 const size_t n)
+{
+   size_t available = self->cached_tail - head;
+
+   if (available < n)
+   {
+      self->cached_tail = atomic_load_explicit(&self->tail, memory_order_acquire);
+      available = self->cached_tail - head;
+   }
+
+   return available < n ? available : n;
+}
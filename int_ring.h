@@ -0,0 +1,142 @@
+/**************************************************************************************************
+* int_ring.h: Implementering av en lsfri ringbuffert fr verfring av heltal av datatypen int
+*             frn en producenttrd till en konsumenttrd (single producer, single consumer).
+*             Bufferten har en fast kapacitet som r en tvpotens, s att index kan berknas via
+*             bitmaskning. Producenten ger index tail och konsumenten ger index head, vilka
+*             uppdateras via atomra operationer i C11. Indexen placeras p separata cache-rader,
+*             s att trdarna inte invaliderar varandras cache vid varje uppdatering.
+*
+*             Endast en trd i taget fr lgga till element och endast en trd i taget fr
+*             ta ut element. Fler producenter eller konsumenter krver extern synkronisering.
+**************************************************************************************************/
+#ifndef INT_RING_H_
+#define INT_RING_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "allocator.h"
+
+/**************************************************************************************************
+* INT_RING_CACHE_LINE_SIZE: Storleken p en cache-rad i byte, som anvnds fr att separera
+*                           producentens och konsumentens data i strukten int_ring.
+**************************************************************************************************/
+#define INT_RING_CACHE_LINE_SIZE 64
+
+/**************************************************************************************************
+* int_ring: Lsfri ringbuffert fr heltal med en producent och en konsument. Varje trd sparar
+*           en lokal kopia av den andra trdens index, s att det atomra indexet enbart behver
+*           lsas d bufferten verkar vara full respektive tom. Indexen rknas uppt utan att
+*           nollstllas och omvandlas till positioner i fltet via mask.
+**************************************************************************************************/
+struct int_ring
+{
+   _Alignas(INT_RING_CACHE_LINE_SIZE) atomic_size_t head; /* Nsta element att ta ut. */
+   size_t cached_tail;                                   /* Konsumentens kopia av tail. */
+   _Alignas(INT_RING_CACHE_LINE_SIZE) atomic_size_t tail; /* Nsta lediga plats. */
+   size_t cached_head;                                   /* Producentens kopia av head. */
+   _Alignas(INT_RING_CACHE_LINE_SIZE) int* data;          /* Pekare till buffertens flt. */
+   size_t mask;                                          /* Kapaciteten minus ett. */
+   const struct allocator* allocator;                    /* Allokator (null = malloc). */
+};
+
+/**************************************************************************************************
+* int_ring_init: Initierar ny ringbuffert med angiven kapacitet, som avrundas uppt till nrmaste
+*                tvpotens. Vid lyckad initiering returneras 0, annars returneras felkod 1.
+*
+*                - self    : Pekare till ringbufferten som ska initieras.
+*                - capacity: Minsta antal element som ska rymmas i bufferten.
+**************************************************************************************************/
+int int_ring_init(struct int_ring* self,
+                  const size_t capacity);
+
+/**************************************************************************************************
+* int_ring_init_with_allocator: Initierar ny ringbuffert med angiven kapacitet, dr fltet
+*                               allokeras via angiven allokator, se int_ring_init.
+*
+*                               - self     : Pekare till ringbufferten som ska initieras.
+*                               - capacity : Minsta antal element som ska rymmas i bufferten.
+*                               - allocator: Pekare till allokatorn (null = standardallokatorn).
+**************************************************************************************************/
+int int_ring_init_with_allocator(struct int_ring* self,
+                                 const size_t capacity,
+                                 const struct allocator* allocator);
+
+/**************************************************************************************************
+* int_ring_clear: Frigr minnet som har allokerats fr angiven ringbuffert. Fr enbart anropas
+*                 d ingen trd lngre anvnder bufferten.
+*
+*                 - self: Pekare till ringbufferten som ska tmmas.
+**************************************************************************************************/
+void int_ring_clear(struct int_ring* self);
+
+/**************************************************************************************************
+* int_ring_capacity: Returnerar antalet element som ryms i angiven ringbuffert.
+*
+*                    - self: Pekare till ringbufferten.
+**************************************************************************************************/
+size_t int_ring_capacity(const struct int_ring* self);
+
+/**************************************************************************************************
+* int_ring_size: Returnerar antalet element som fr tillfllet lagras i angiven ringbuffert.
+*                Vrdet r exakt fr den anropande producenten eller konsumenten s lnge den
+*                andra trden str still, annars r det en gonblicksbild.
+*
+*                - self: Pekare till ringbufferten.
+**************************************************************************************************/
+size_t int_ring_size(struct int_ring* self);
+
+/**************************************************************************************************
+* int_ring_push: Lgger till ett nytt element lngst bak i angiven ringbuffert. Anropas enbart
+*                av producenten. Vid lyckad insttning returneras 0, annars returneras felkod 1
+*                ifall bufferten r full.
+*
+*                - self       : Pekare till ringbufferten.
+*                - new_element: Det nya element som ska lggas till.
+**************************************************************************************************/
+int int_ring_push(struct int_ring* self,
+                  const int new_element);
+
+/**************************************************************************************************
+* int_ring_pop: Tar ut det frsta elementet i angiven ringbuffert. Anropas enbart av
+*               konsumenten. Vid lyckat uttag returneras 0, annars returneras felkod 1 ifall
+*               bufferten r tom.
+*
+*               - self   : Pekare till ringbufferten.
+*               - element: Pekare till variabeln som ska tilldelas elementet.
+**************************************************************************************************/
+int int_ring_pop(struct int_ring* self,
+                 int* element);
+
+/**************************************************************************************************
+* int_ring_push_range: Lgger till upp till n element frn angivet flt lngst bak i angiven
+*                      ringbuffert. Elementen kopieras i hgst tv sammanhngande block och
+*                      publiceras fr konsumenten p en gng. Anropas enbart av producenten.
+*                      Antalet tillagda element returneras, vilket r frre n n om bufferten
+*                      blev full.
+*
+*                      - self: Pekare till ringbufferten.
+*                      - src : Pekare till fltet med elementen som ska lggas till.
+*                      - n   : Antalet element som ska lggas till.
+**************************************************************************************************/
+size_t int_ring_push_range(struct int_ring* self,
+                           const int* src,
+                           const size_t n);
+
+/**************************************************************************************************
+* int_ring_pop_range: Tar ut upp till n element frn angiven ringbuffert och kopierar dem till
+*                     angivet flt i hgst tv sammanhngande block. Anropas enbart av
+*                     konsumenten. Antalet uttagna element returneras, vilket r frre n n om
+*                     bufferten blev tom.
+*
+*                     - self: Pekare till ringbufferten.
+*                     - dest: Pekare till fltet som ska tilldelas elementen.
+*                     - n   : Maximalt antal element som ska tas ut.
+**************************************************************************************************/
+size_t int_ring_pop_range(struct int_ring* self,
+                          int* dest,
+                          const size_t n);
+
+#endif /* INT_RING_H_ */
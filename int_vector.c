@@ -3,172 +3,647 @@
 *               anvnds fr implementering av dynamiska vektorer fr lagring av signerade heltal.
 **************************************************************************************************/
 #include "int_vector.h"
+#include "int_format.h"
+#include "int_vector_simd.h"
+#include "crc32c.h"
+#include <limits.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**************************************************************************************************
+* INT_VECTOR_FILE_MAGIC: Magiskt tal i brjan av filer sparade via int_vector_save ("IVEC").
+*
+* INT_VECTOR_FILE_VERSION: Filformatets aktuella version.
+*
+* INT_VECTOR_FILE_BYTE_ORDER: Byteordningsmarkr, som lses som INT_VECTOR_FILE_BYTE_ORDER_SWAPPED
+*                             p en maskin med motsatt byteordning jmfrt med maskinen som
+*                             sparade filen.
+**************************************************************************************************/
+#define INT_VECTOR_FILE_MAGIC "IVEC"
+#define INT_VECTOR_FILE_VERSION 1
+#define INT_VECTOR_FILE_BYTE_ORDER 0x0102
+#define INT_VECTOR_FILE_BYTE_ORDER_SWAPPED 0x0201
+
+/**************************************************************************************************
+* INT_VECTOR_CHANGES_MAGIC: Magiskt tal i brjan av filer sparade via int_vector_save_changes.
+**************************************************************************************************/
+#define INT_VECTOR_CHANGES_MAGIC "IVCH"
 
 /**************************************************************************************************
-* int_vector_init: Initierar ny tom vektor.
+* INT_VECTOR_READ_BUFFER_SIZE: Storleken i byte p blocken som lses in vid tolkning av text.
 *
-*                  - self: Pekare till vektorn som ska initieras.
+* INT_VECTOR_READ_BATCH_SIZE: Antalet tolkade heltal som lggs till i vektorn t gngen.
 **************************************************************************************************/
-void int_vector_init(struct int_vector* self)
+#define INT_VECTOR_READ_BUFFER_SIZE (64 * 1024)
+#define INT_VECTOR_READ_BATCH_SIZE 1024
+
+/**************************************************************************************************
+* int_vector_read_state: Tillstnd vid tolkning av text, vilket bevaras mellan inlsta block s
+*                        att en rad kan vara uppdelad ver tv block.
+**************************************************************************************************/
+enum int_vector_read_state
 {
-   self->data = 0;
-   self->size = 0;
-   return;
+   INT_VECTOR_READ_LINE_START, /* I brjan av en rad, eller p en rad med enbart blanktecken. */
+   INT_VECTOR_READ_DASH,       /* Efter ett inledande bindestreck (minustecken eller avgrnsning). */
+   INT_VECTOR_READ_NUMBER,     /* Inuti ett heltal. */
+   INT_VECTOR_READ_SEPARATOR,  /* Inuti en avgrnsningsrad med bindestreck. */
+   INT_VECTOR_READ_TRAILING    /* Efter ett heltal eller en avgrnsningsrad, innan radbrytning. */
+};
+
+/**************************************************************************************************
+* int_vector_file_header: Huvud p 32 byte i brjan av filer sparade via int_vector_save.
+*                         Elementen fljer direkt efter huvudet.
+**************************************************************************************************/
+struct int_vector_file_header
+{
+   char magic[4];         /* Magiskt tal, se INT_VECTOR_FILE_MAGIC. */
+   uint16_t version;      /* Filformatets version. */
+   uint16_t byte_order;   /* Byteordningsmarkr, se INT_VECTOR_FILE_BYTE_ORDER. */
+   uint32_t element_size; /* Elementens storlek i byte. */
+   uint32_t checksum;     /* Kontrollsumma (CRC-32C) fr elementen. */
+   uint64_t size;         /* Antalet element i filen. */
+   uint64_t reserved;     /* Reserverat fr framtida bruk, stts till 0. */
+};
+
+/**************************************************************************************************
+* int_vector_changes_header: Huvud p 40 byte i brjan av filer sparade via
+*                            int_vector_save_changes. De ndrade elementen fljer direkt efter
+*                            huvudet.
+**************************************************************************************************/
+struct int_vector_changes_header
+{
+   char magic[4];         /* Magiskt tal, se INT_VECTOR_CHANGES_MAGIC. */
+   uint16_t version;      /* Filformatets version. */
+   uint16_t byte_order;   /* Byteordningsmarkr, se INT_VECTOR_FILE_BYTE_ORDER. */
+   uint32_t element_size; /* Elementens storlek i byte. */
+   uint32_t checksum;     /* Vektorns kontrollsumma, se int_vector_checksum. */
+   uint64_t size;         /* Antalet element i vektorn. */
+   uint64_t first;        /* Index till det frsta ndrade elementet. */
+   uint64_t count;        /* Antalet ndrade element i filen. */
+};
+
+/**************************************************************************************************
+* int_vector_separator: Avgrnsningsrad som skrivs ut fre och efter vektorns innehll.
+**************************************************************************************************/
+static const char int_vector_separator[] = 
+   "--------------------------------------------------------------------------\n";
+
+/**************************************************************************************************
+* DEFINE_VECTOR: Genererar vektorns generella funktioner (int_vector_init, int_vector_push osv.),
+*                se "vector.h". Filhuvudet mste vara lika stort som VECTOR_MAP_OFFSET, eftersom
+*                mappade filer avmappas av dessa funktioner.
+**************************************************************************************************/
+DEFINE_VECTOR(int_vector, int)
+_Static_assert(sizeof(struct int_vector_file_header) == VECTOR_MAP_OFFSET, 
+               "Filhuvudet mste rymmas i VECTOR_MAP_OFFSET byte.");
+
+/* Statiska funktioner: */
+static int int_vector_read_header(FILE* istream,
+                                  struct int_vector_file_header* header,
+                                  int* swapped);
+static uint32_t int_vector_swap_bytes(const uint32_t value);
+
+/**************************************************************************************************
+* int_vector_assign_step: Stter vektorns storlek till angivet antal element och tilldelar
+*                         elementen heltal rknat frn angivet startvrde med angivet stegvrde
+*                         (start, start + step, start + 2 * step...). Hgst en omallokering
+*                         genomfrs. Vid lyckad tilldelning returneras 0, annars returneras
+*                         felkod 1.
+*
+*                         - self : Pekare till vektorn som ska tilldelas.
+*                         - size : Vektorns nya storlek.
+*                         - start: Det frsta elementets vrde.
+*                         - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+int int_vector_assign_step(struct int_vector* self,
+                           const size_t size,
+                           const int start,
+                           const int step)
+{
+   if (int_vector_resize(self, size)) return 1;
+   int_vector_fill_step(self, start, step);
+   return 0;
 }
 
 /**************************************************************************************************
-* int_vector_clear: Tmmer innehllet i angiven vektor genom att frigra allokerat minne.
+* int_vector_print: Skriver ut innehllet lagrat i angiven vektor via angiven utstrm, dr
+*                   standardutenheten stdout anvnds som default fr utskrift i terminalen.
+*                   Heltalen formateras via int_format och skrivs ut i stora block.
 *
-*                   - self: Pekare till vektorn som ska tmmas.
+*                   - self   : Pekare till vektorn vars innehll ska skrivas ut.
+*                   - ostream: Pekare till angiven utstrm (default = stdout).
 **************************************************************************************************/
-void int_vector_clear(struct int_vector* self)
+void int_vector_print(const struct int_vector* self,
+                      FILE* ostream)
 {
-   free(self->data);
-   self->data = 0;
-   self->size = 0;
+   if (!self->size) return;
+   if (!ostream) ostream = stdout;
+   fputs(int_vector_separator, ostream);
+   int_format_write(ostream, self->data, self->size, 0, 0);
+   fputs(int_vector_separator, ostream);
+   fputc('\n', ostream);
    return;
 }
 
 /**************************************************************************************************
-* int_vector_new: Returnerar en pekare till en ny heapallokerad vektor av angiven storlek.
+* int_vector_print_changes: Skriver ut de element i angiven vektor som har ndrats sedan
+*                           int_vector_mark_clean via angiven utstrm, i samma format som
+*                           int_vector_print. Intervallet av ndrade element ges av
+*                           int_vector_dirty_range. Utan sprning av ndringar skrivs samtliga
+*                           element ut.
 *
-*                 - size: Vektorns storlek (antalet element den rymmer) vid start.
+*                           - self   : Pekare till vektorn vars ndringar ska skrivas ut.
+*                           - ostream: Pekare till angiven utstrm (default = stdout).
 **************************************************************************************************/
-struct int_vector* int_vector_new(const size_t size)
+void int_vector_print_changes(const struct int_vector* self,
+                              FILE* ostream)
 {
-   struct int_vector* self = (struct int_vector*)malloc(sizeof(struct int_vector));
-   if (!self) return 0;
-   self->data = 0;
-   self->size = 0;
-   int_vector_resize(self, size);
-   return self;
+   size_t first, last;
+   if (!int_vector_dirty_range(self, &first, &last) || first == last) return;
+   if (!ostream) ostream = stdout;
+   fputs(int_vector_separator, ostream);
+   int_format_write(ostream, self->data + first, last - first, 0, 0);
+   fputs(int_vector_separator, ostream);
+   fputc('\n', ostream);
+   return;
 }
 
 /**************************************************************************************************
-* int_vector_delete: Frigr minne fr en heapallokerad vektor. Vektorpekarens adress passeras 
-*                    fr att bde frigra minnet fr det dynamiska flt denna peka p, minnet 
-*                    fr sjlva vektorn samt att vektorpekaren stts till null.
+* int_vector_to_string: Returnerar en pekare till en ny heapallokerad, nollterminerad strng
+*                       innehllande samma text som int_vector_print skriver ut fr angiven
+*                       vektor. Strngen mste frigras via free. Vid misslyckad allokering
+*                       returneras null.
 *
-*                    - self: Adressen till vektorpekaren.
+*                       - self  : Pekare till vektorn vars innehll ska omvandlas till text.
+*                       - length: Pekare till variabel som tilldelas strngens lngd (eller null).
 **************************************************************************************************/
-void int_vector_delete(struct int_vector** self)
+char* int_vector_to_string(const struct int_vector* self,
+                           size_t* length)
 {
-   int_vector_clear(*self);
-   free(*self);
-   *self = 0;
-   return;
+   const size_t separator_length = sizeof(int_vector_separator) - 1;
+   size_t i = 0;
+
+   if (self->size > (SIZE_MAX - 2 * separator_length - 2) / INT_FORMAT_MAX_LENGTH) return 0;
+   char* s = (char*)malloc(self->size * INT_FORMAT_MAX_LENGTH + 2 * separator_length + 2);
+   if (!s) return 0;
+
+   if (self->size)
+   {
+      memcpy(s, int_vector_separator, separator_length);
+      i = separator_length;
+      i += int_format_lines(s + i, self->data, self->size);
+      memcpy(s + i, int_vector_separator, separator_length);
+      i += separator_length;
+      s[i++] = '\n';
+   }
+
+   s[i] = '\0';
+   if (length) *length = i;
+   return s;
 }
 
 /**************************************************************************************************
-* int_vector_resize: ndrar storleken / kapaciteten p en vektor via omallokering. Vid lyckad
-*                    omallokering returneras 0, annars returneras felkod 1.
+* int_vector_save: Sparar innehllet i angiven vektor till en binr fil. Filen inleds med ett
+*                  huvud p 32 byte innehllande ett magiskt tal, formatets version, en
+*                  byteordningsmarkr, elementens storlek, en kontrollsumma (CRC-32C) samt
+*                  antalet element, fljt av elementen i maskinens egen byteordning. Vid lyckad
+*                  sparning returneras 0, annars returneras felkod 1.
 *
-*                    - self    : Pekare till vektorn vars storlek skall ndras.
-*                    - new_size: Vektorns nya storlek efter omallokeringen.
+*                  - self    : Pekare till vektorn vars innehll ska sparas.
+*                  - filepath: Skvgen till filen som ska skrivas.
 **************************************************************************************************/
-int int_vector_resize(struct int_vector* self,
-                      const size_t new_size)
+int int_vector_save(const struct int_vector* self,
+                    const char* filepath)
 {
-   int* copy = (int*)realloc(self->data, sizeof(int) * new_size);
-   if (!copy) return 1;
-   self->data = copy;
-   self->size = new_size;
-   return 0;
+   struct int_vector_file_header header;
+   memcpy(header.magic, INT_VECTOR_FILE_MAGIC, sizeof(header.magic));
+   header.version = INT_VECTOR_FILE_VERSION;
+   header.byte_order = INT_VECTOR_FILE_BYTE_ORDER;
+   header.element_size = sizeof(int);
+   header.checksum = crc32c(0, self->data, sizeof(int) * self->size);
+   header.size = self->size;
+   header.reserved = 0;
+
+   FILE* ostream = fopen(filepath, "wb");
+   if (!ostream) return 1;
+
+   int error = fwrite(&header, sizeof(header), 1, ostream) != 1;
+
+   if (!error && self->size)
+   {
+      error = fwrite(self->data, sizeof(int), self->size, ostream) != self->size;
+   }
+
+   if (fclose(ostream)) error = 1;
+   return error;
 }
 
 /**************************************************************************************************
-* int_vector_push: Lgger till ett nytt element lngst bak i en vektor. Ifall det nya elementet
-*                  lyckas lggas till returneras 0, annars returneras felkod 1.
+* int_vector_load: Lser in innehllet frn en binr fil sparad via int_vector_save till angiven
+*                  vektor, vars tidigare innehll erstts. Filens huvud och kontrollsumma
+*                  kontrolleras och elementen byteordningsvnds vid behov. Vid lyckad inlsning
+*                  returneras 0, annars returneras felkod 1, varvid vektorn lmnas tom.
 *
-*                  - self       : Pekare till vektorn som ska tilldelas det nya elementet.
-*                  - new_element: Det nya element som skall lggas till lngst bak i vektorn.
+*                  - self    : Pekare till vektorn som ska tilldelas filens innehll.
+*                  - filepath: Skvgen till filen som ska lsas.
 **************************************************************************************************/
-int int_vector_push(struct int_vector* self,
-                    const int new_element)
+int int_vector_load(struct int_vector* self,
+                    const char* filepath)
 {
-   int* copy = (int*)realloc(self->data, sizeof(int) * (self->size + 1));
-   if (!copy) return 1;
-   copy[self->size++] = new_element;
-   self->data = copy;
+   struct int_vector_file_header header;
+   int swapped;
+
+   int_vector_reset(self);
+   FILE* istream = fopen(filepath, "rb");
+   if (!istream) return 1;
+
+   if (int_vector_read_header(istream, &header, &swapped) ||
+       int_vector_resize(self, (size_t)header.size) ||
+       fread(self->data, sizeof(int), self->size, istream) != self->size ||
+       crc32c(0, self->data, sizeof(int) * self->size) != header.checksum)
+   {
+      fclose(istream);
+      int_vector_reset(self);
+      return 1;
+   }
+
+   if (swapped)
+   {
+      for (size_t i = 0; i < self->size; ++i)
+      {
+         self->data[i] = (int)int_vector_swap_bytes((uint32_t)self->data[i]);
+      }
+   }
+
+   fclose(istream);
    return 0;
 }
 
 /**************************************************************************************************
-* int_vector_pop: Tar bort ett element lngst bak i angiven vektor, om ett sdant finns. 
-*                 Ifall elementet lyckas tas bort returneras 0, annars returneras felkod 1.
+* int_vector_map: Mappar en binr fil sparad via int_vector_save direkt till angiven vektor,
+*                 vars tidigare innehll erstts, utan att elementen kopieras. Elementen lses
+*                 frn filen frst nr de anvnds, vilket gr att ven stora filer ppnas
+*                 omedelbart. Enbart filens huvud kontrolleras, inte kontrollsumman.
 *
-*                 - self: Pekare till vektorn vars sista elemenet ska tas bort.
+*                 Filen mappas privat, vilket medfr att filen aldrig ndras. Element som
+*                 tilldelas via int_vector_begin kopieras sidvis av operativsystemet och
+*                 vriga ndringar av storlek eller kapacitet kopierar fltet till heapen.
+*                 Om filen har en annan byteordning, eller om minnesmappning inte stds,
+*                 lses filen i stllet in via int_vector_load. Vid lyckad mappning returneras
+*                 0, annars returneras felkod 1, varvid vektorn lmnas tom.
+*
+*                 - self    : Pekare till vektorn som ska tilldelas filens innehll.
+*                 - filepath: Skvgen till filen som ska mappas.
 **************************************************************************************************/
-int int_vector_pop(struct int_vector* self)
+int int_vector_map(struct int_vector* self,
+                   const char* filepath)
 {
-   if (self->size <= 1)
+#ifdef _WIN32
+   return int_vector_load(self, filepath);
+#else
+   struct int_vector_file_header header;
+   struct stat status;
+   int swapped;
+
+   int_vector_reset(self);
+   FILE* istream = fopen(filepath, "rb");
+   if (!istream) return 1;
+
+   if (int_vector_read_header(istream, &header, &swapped))
    {
-      int_vector_clear(self);
-      return 0;
+      fclose(istream);
+      return 1;
    }
-   else
+
+   fclose(istream);
+   if (swapped || !header.size) return int_vector_load(self, filepath);
+
+   const int fd = open(filepath, O_RDONLY);
+   if (fd < 0) return 1;
+   const size_t length = sizeof(header) + sizeof(int) * (size_t)header.size;
+
+   if (fstat(fd, &status) || (uint64_t)status.st_size < length)
    {
-      int* copy = (int*)realloc(self->data, sizeof(int) * (self->size - 1));
-      if (!copy) return 1;
-      self->data = copy;
-      self->size--;
-      return 0;
+      close(fd);
+      return 1;
    }
+
+   void* mapping = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (mapping == MAP_FAILED) return 1;
+
+   self->data = (int*)((unsigned char*)mapping + sizeof(header));
+   self->size = (size_t)header.size;
+   self->capacity = (size_t)header.size;
+   self->mapped = 1;
+   int_vector_mark_dirty(self, 0, self->size);
+   return 0;
+#endif
 }
 
 /**************************************************************************************************
-* int_vector_print: Skriver ut innehllet lagrat i angiven vektor via angiven utstrm, dr
-*                   standardutenheten stdout anvnds som default fr utskrift i terminalen.
+* int_vector_save_changes: Sparar de element i angiven vektor som har ndrats sedan
+*                          int_vector_mark_clean till en binr fil, s att en kopia av vektorn
+*                          kan uppdateras via int_vector_apply_changes utan att hela vektorn
+*                          skickas. Filen inleds med ett huvud p 40 byte innehllande ett
+*                          magiskt tal, formatets version, en byteordningsmarkr, elementens
+*                          storlek, vektorns kontrollsumma (se int_vector_checksum), vektorns
+*                          storlek samt index och antal fr de ndrade elementen, fljt av
+*                          elementen. Vid lyckad sparning returneras 0, annars returneras
+*                          felkod 1.
 *
-*                   - self   : Pekare till vektorn vars innehll ska skrivas ut.
-*                   - ostream: Pekare till angiven utstrm (default = stdout).
+*                          - self    : Pekare till vektorn vars ndringar ska sparas.
+*                          - filepath: Skvgen till filen som ska skrivas.
 **************************************************************************************************/
-void int_vector_print(const struct int_vector* self,
-                      FILE* ostream)
+int int_vector_save_changes(const struct int_vector* self,
+                            const char* filepath)
 {
-   if (!self->size) return;
-   if (!ostream) ostream = stdout;
-   fprintf(ostream, "--------------------------------------------------------------------------\n");
+   struct int_vector_changes_header header;
+   size_t first, last;
+
+   int_vector_dirty_range(self, &first, &last);
+   memcpy(header.magic, INT_VECTOR_CHANGES_MAGIC, sizeof(header.magic));
+   header.version = INT_VECTOR_FILE_VERSION;
+   header.byte_order = INT_VECTOR_FILE_BYTE_ORDER;
+   header.element_size = sizeof(int);
+   header.checksum = int_vector_checksum(self);
+   header.size = self->size;
+   header.first = first;
+   header.count = last - first;
+
+   FILE* ostream = fopen(filepath, "wb");
+   if (!ostream) return 1;
 
-   for (size_t i = 0; i < self->size; ++i)
+   const size_t count = last - first;
+   int error = fwrite(&header, sizeof(header), 1, ostream) != 1;
+   if (!error && count) error = fwrite(self->data + first, sizeof(int), count, ostream) != count;
+   if (fclose(ostream)) error = 1;
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_apply_changes: Uppdaterar angiven kopia av en vektor med ndringar sparade via
+*                           int_vector_save_changes, varvid kopians storlek stts till
+*                           originalets. Drefter verifieras kopian mot originalets kontrollsumma,
+*                           vilket med sprning aktiverad (se int_vector_track) enbart krver att
+*                           de ndrade blocken lses. Filer med annan byteordning stds inte. Vid
+*                           lyckad uppdatering returneras 0, annars returneras felkod 1, varvid
+*                           kopian kan skilja sig frn originalet och br lsas in p nytt via
+*                           int_vector_load.
+*
+*                           - self    : Pekare till kopian som ska uppdateras.
+*                           - filepath: Skvgen till filen som ska lsas.
+**************************************************************************************************/
+int int_vector_apply_changes(struct int_vector* self,
+                             const char* filepath)
+{
+   struct int_vector_changes_header header;
+   FILE* istream = fopen(filepath, "rb");
+   if (!istream) return 1;
+
+   if (fread(&header, sizeof(header), 1, istream) != 1 ||
+       memcmp(header.magic, INT_VECTOR_CHANGES_MAGIC, sizeof(header.magic)) ||
+       header.version != INT_VECTOR_FILE_VERSION ||
+       header.byte_order != INT_VECTOR_FILE_BYTE_ORDER ||
+       header.element_size != sizeof(int) || header.size > SIZE_MAX / sizeof(int) ||
+       header.first > header.size || header.count > header.size - header.first ||
+       int_vector_resize(self, (size_t)header.size))
    {
-      fprintf(ostream, "%d\n", self->data[i]);
+      fclose(istream);
+      return 1;
    }
 
-   fprintf(ostream, "--------------------------------------------------------------------------\n\n");
-   return;
+   const size_t first = (size_t)header.first;
+   const size_t count = (size_t)header.count;
+   const int error = fread(self->data + first, sizeof(int), count, istream) != count;
+   fclose(istream);
+   int_vector_mark_dirty(self, first, count);
+   return error || int_vector_checksum(self) != header.checksum;
+}
+
+/**************************************************************************************************
+* int_vector_read_text: Lser in heltal i textformat frn angiven instrm och lgger till dem
+*                       lngst bak i angiven vektor. Texten ska innehlla ett heltal per rad,
+*                       exempelvis utskriften frn int_vector_print. Avgrnsningsrader bestende
+*                       av bindestreck samt tomma rader ignoreras. Instrmmen lses och tolkas
+*                       block fr block, s att ven filer strre n tillgngligt minne fr
+*                       bufferten kan lsas, och heltalen lggs till i vektorn i omgngar.
+*
+*                       Vid lyckad inlsning returneras 0. Vid en felaktig rad, ett heltal som
+*                       inte ryms i en int eller misslyckad lsning eller allokering returneras
+*                       felkod 1, varvid vektorn terstlls till sin tidigare storlek.
+*
+*                       - self      : Pekare till vektorn som ska tilldelas de inlsta heltalen.
+*                       - istream   : Pekare till angiven instrm (default = stdin).
+*                       - error_line: Pekare till variabel som vid fel tilldelas numret p den
+*                                     felaktiga raden, rknat frn 1, eller 0 vid ls- eller
+*                                     allokeringsfel (eller null).
+**************************************************************************************************/
+int int_vector_read_text(struct int_vector* self,
+                         FILE* istream,
+                         size_t* error_line)
+{
+   const size_t initial_size = self->size;
+   enum int_vector_read_state state = INT_VECTOR_READ_LINE_START;
+   int batch[INT_VECTOR_READ_BATCH_SIZE];
+   size_t batch_size = 0;
+   size_t line = 1;
+   unsigned int magnitude = 0;
+   unsigned int limit = INT_MAX;
+   int error = 0;
+
+   if (!istream) istream = stdin;
+   char* buffer = (char*)malloc(INT_VECTOR_READ_BUFFER_SIZE);
+
+   if (!buffer)
+   {
+      if (error_line) *error_line = 0;
+      return 1;
+   }
+
+   while (!error)
+   {
+      const size_t length = fread(buffer, 1, INT_VECTOR_READ_BUFFER_SIZE, istream);
+      const char* i = buffer;
+      const char* end = buffer + length;
+
+      if (!length)
+      {
+         if (ferror(istream))
+         {
+            error = 1;
+            line = 0;
+         }
+         else if (state == INT_VECTOR_READ_DASH)
+         {
+            error = 1;
+         }
+         else if (state == INT_VECTOR_READ_NUMBER)
+         {
+            batch[batch_size++] = limit == INT_MAX ? (int)magnitude : (int)(0u - magnitude);
+         }
+
+         break;
+      }
+
+      while (i < end && !error)
+      {
+         const char c = *i++;
+
+         if (state == INT_VECTOR_READ_NUMBER)
+         {
+            if (c >= '0' && c <= '9')
+            {
+               const unsigned int digit = (unsigned int)(c - '0');
+               if (magnitude > (limit - digit) / 10) error = 1;
+               magnitude = magnitude * 10 + digit;
+               continue;
+            }
+
+            batch[batch_size++] = limit == INT_MAX ? (int)magnitude : (int)(0u - magnitude);
+            state = INT_VECTOR_READ_TRAILING;
+
+            if (batch_size == INT_VECTOR_READ_BATCH_SIZE)
+            {
+               if (int_vector_append_range(self, batch, batch_size))
+               {
+                  error = 1;
+                  line = 0;
+               }
+
+               batch_size = 0;
+            }
+         }
+
+         if (c == '\n')
+         {
+            if (state == INT_VECTOR_READ_DASH) 
+            {
+               error = 1;
+            }
+            else
+            {
+               state = INT_VECTOR_READ_LINE_START;
+               line++;
+            }
+         }
+         else if (c == ' ' || c == '\t' || c == '\r')
+         {
+            if (state == INT_VECTOR_READ_DASH) error = 1;
+            else if (state == INT_VECTOR_READ_SEPARATOR) state = INT_VECTOR_READ_TRAILING;
+         }
+         else if (c == '-')
+         {
+            if (state == INT_VECTOR_READ_LINE_START) state = INT_VECTOR_READ_DASH;
+            else if (state == INT_VECTOR_READ_DASH) state = INT_VECTOR_READ_SEPARATOR;
+            else if (state != INT_VECTOR_READ_SEPARATOR) error = 1;
+         }
+         else if (c >= '0' && c <= '9' && 
+                  (state == INT_VECTOR_READ_LINE_START || state == INT_VECTOR_READ_DASH))
+         {
+            limit = state == INT_VECTOR_READ_DASH ? (unsigned int)INT_MAX + 1u : INT_MAX;
+            magnitude = (unsigned int)(c - '0');
+            state = INT_VECTOR_READ_NUMBER;
+         }
+         else
+         {
+            error = 1;
+         }
+      }
+   }
+
+   free(buffer);
+
+   if (!error && int_vector_append_range(self, batch, batch_size))
+   {
+      error = 1;
+      line = 0;
+   }
+
+   if (error)
+   {
+      int_vector_resize(self, initial_size);
+      if (error_line) *error_line = line;
+      return 1;
+   }
+
+   return 0;
 }
 
 /**************************************************************************************************
-* int_vector_begin: Returnerar adressen till det frsta elementet i angiven vektor.
-*                   Om vektorn r tom returneras null.
-* 
-*                   - self: Pekare till vektorn.
+* int_vector_load_text: Lser in heltal i textformat frn angiven fil till angiven vektor, vars
+*                       tidigare innehll erstts, se int_vector_read_text. Vid lyckad inlsning
+*                       returneras 0, annars returneras felkod 1, varvid vektorn lmnas tom.
+*
+*                       - self      : Pekare till vektorn som ska tilldelas de inlsta heltalen.
+*                       - filepath  : Skvgen till filen som ska lsas.
+*                       - error_line: Pekare till variabel som vid fel tilldelas numret p den
+*                                     felaktiga raden, eller 0 vid vriga fel (eller null).
 **************************************************************************************************/
-int* int_vector_begin(const struct int_vector* self)
+int int_vector_load_text(struct int_vector* self,
+                         const char* filepath,
+                         size_t* error_line)
 {
-   return self->data;
+   int_vector_reset(self);
+   FILE* istream = fopen(filepath, "rb");
+
+   if (!istream)
+   {
+      if (error_line) *error_line = 0;
+      return 1;
+   }
+
+   const int error = int_vector_read_text(self, istream, error_line);
+   fclose(istream);
+   if (error) int_vector_reset(self);
+   return error;
 }
 
 /**************************************************************************************************
-* int_vector_end: Returnerar adressen direkt efter det sista elementet i angiven vektor. 
-*                 Om vektorn r tom returneras null.
+* int_vector_read_header: Lser och kontrollerar huvudet i en fil sparad via int_vector_save.
+*                         Ifall filen har sparats med motsatt byteordning byteordningsvnds
+*                         huvudets flt. Ifall huvudet r giltigt returneras 0, annars
+*                         returneras felkod 1.
 *
-*                 - self: Pekare till vektorn.
+*                         - istream: Pekare till filen, som ska vara ppnad fr lsning.
+*                         - header : Pekare till strukten som ska tilldelas huvudets innehll.
+*                         - swapped: Pekare till variabel som indikerar motsatt byteordning.
 **************************************************************************************************/
-int* int_vector_end(const struct int_vector* self)
+static int int_vector_read_header(FILE* istream,
+                                  struct int_vector_file_header* header,
+                                  int* swapped)
 {
-   return self->data + self->size;
+   if (fread(header, sizeof(*header), 1, istream) != 1) return 1;
+   if (memcmp(header->magic, INT_VECTOR_FILE_MAGIC, sizeof(header->magic))) return 1;
+   *swapped = header->byte_order != INT_VECTOR_FILE_BYTE_ORDER;
+
+   if (*swapped)
+   {
+      if (header->byte_order != INT_VECTOR_FILE_BYTE_ORDER_SWAPPED) return 1;
+      header->version = (uint16_t)(header->version >> 8 | header->version << 8);
+      header->element_size = int_vector_swap_bytes(header->element_size);
+      header->checksum = int_vector_swap_bytes(header->checksum);
+      header->size = (uint64_t)int_vector_swap_bytes((uint32_t)header->size) << 32 |
+                     int_vector_swap_bytes((uint32_t)(header->size >> 32));
+   }
+
+   if (header->version != INT_VECTOR_FILE_VERSION || header->element_size != sizeof(int)) return 1;
+   if (header->size > SIZE_MAX / sizeof(int) - sizeof(*header)) return 1;
+   return 0;
 }
 
 /**************************************************************************************************
-* int_vector_last: Returnerar adressen till det sista elementet i angiven vektor. 
-*                  Om vektorn r tom returneras null.
+* int_vector_swap_bytes: Returnerar angivet 32-bitars tal med omvnd byteordning.
 *
-*                 - self: Pekare till vektorn.
+*                        - value: Talet vars byteordning ska vndas.
 **************************************************************************************************/
-int* int_vector_last(const struct int_vector* self)
+static uint32_t int_vector_swap_bytes(const uint32_t value)
 {
-   return self->size > 0 ? self->data + self->size - 1 : 0;
+   return value >> 24 | (value >> 8 & 0xff00u) | (value << 8 & 0xff0000u) | value << 24;
 }
 
@@ -8,107 +8,199 @@
 /* Inkluderingsdirektiv: */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "vector.h"
 
 /**************************************************************************************************
-* int_vector: Vektor innehllande ett dynamiskt flt fr lagring av signerade heltal. Antalet
-*             element som lagras i fltet rknas upp och uttrycks i form av vektorns storlek.
+* INT_VECTOR_INLINE_CAPACITY: Antalet element som lagras direkt i vektorstrukten innan ett flt
+*                             allokeras p heapen. Kan ndras vid kompilering, men mste vara
+*                             minst 1.
 **************************************************************************************************/
-struct int_vector
-{
-   int* data;   /* Pekare till dynamiskt flt innehllande heltal. */
-   size_t size; /* Vektorns storlek, dvs. antalet element den rymmer. */
-};
+#ifndef INT_VECTOR_INLINE_CAPACITY
+#define INT_VECTOR_INLINE_CAPACITY 12
+#endif
 
 /**************************************************************************************************
-* int_vector_init: Initierar ny tom vektor.
+* int_vector: Vektor innehllande ett dynamiskt flt fr lagring av signerade heltal, genererad
+*             via mallen i "vector.h". Mallen deklarerar strukten samt dess generella funktioner
+*             int_vector_init, int_vector_init_with_allocator, int_vector_clear, int_vector_new,
+*             int_vector_new_with_allocator, int_vector_delete, int_vector_resize,
+*             int_vector_reserve, int_vector_shrink_to_fit, int_vector_push, int_vector_pop,
+*             int_vector_append_range, int_vector_insert_range, int_vector_erase_range,
+*             int_vector_assign_fill, int_vector_move, int_vector_share, int_vector_clone,
+*             int_vector_unshare, int_vector_begin, int_vector_end, int_vector_last,
+*             int_vector_cbegin, int_vector_cend, int_vector_reset, int_vector_track,
+*             int_vector_untrack, int_vector_mark_dirty, int_vector_mark_clean,
+*             int_vector_dirty_range samt int_vector_checksum, vilka beskrivs i "vector.h".
+*             Nedan deklareras funktioner specifika fr heltal.
+**************************************************************************************************/
+DECLARE_VECTOR_EX(int_vector, int, INT_VECTOR_INLINE_CAPACITY)
+
+/**************************************************************************************************
+* int_vector_assign_step: Stter vektorns storlek till angivet antal element och tilldelar
+*                         elementen heltal rknat frn angivet startvrde med angivet stegvrde
+*                         (start, start + step, start + 2 * step...). Hgst en omallokering
+*                         genomfrs. Vid lyckad tilldelning returneras 0, annars returneras
+*                         felkod 1.
 *
-*                  - self: Pekare till vektorn som ska initieras.
+*                         - self : Pekare till vektorn som ska tilldelas.
+*                         - size : Vektorns nya storlek.
+*                         - start: Det frsta elementets vrde.
+*                         - step : Stegvrdet, dvs. differensen mellan varje element.
 **************************************************************************************************/
-void int_vector_init(struct int_vector* self);
+int int_vector_assign_step(struct int_vector* self,
+                           const size_t size,
+                           const int start,
+                           const int step);
 
 /**************************************************************************************************
-* int_vector_clear: Tmmer innehllet i angiven vektor genom att frigra allokerat minne.
+* int_vector_print: Skriver ut innehllet lagrat i angiven vektor via angiven utstrm, dr
+*                   standardutenheten stdout anvnds som default fr utskrift i terminalen.
+*                   Heltalen formateras via int_format och skrivs ut i stora block.
 *
-*                   - self: Pekare till vektorn som ska tmmas.
+*                   - self   : Pekare till vektorn vars innehll ska skrivas ut.
+*                   - ostream: Pekare till angiven utstrm (default = stdout).
 **************************************************************************************************/
-void int_vector_clear(struct int_vector* self);
+void int_vector_print(const struct int_vector* self, 
+                      FILE* ostream);
 
 /**************************************************************************************************
-* int_vector_new: Returnerar en pekare till en ny heapallokerad vektor av angiven storlek.
+* int_vector_print_changes: Skriver ut de element i angiven vektor som har ndrats sedan
+*                           int_vector_mark_clean via angiven utstrm, i samma format som
+*                           int_vector_print. Intervallet av ndrade element ges av
+*                           int_vector_dirty_range. Utan sprning av ndringar skrivs samtliga
+*                           element ut.
 *
-*                 - size: Vektorns storlek (antalet element den rymmer) vid start.
+*                           - self   : Pekare till vektorn vars ndringar ska skrivas ut.
+*                           - ostream: Pekare till angiven utstrm (default = stdout).
 **************************************************************************************************/
-struct int_vector* int_vector_new(const size_t size);
+void int_vector_print_changes(const struct int_vector* self,
+                              FILE* ostream);
 
 /**************************************************************************************************
-* int_vector_delete: Frigr minne fr en heapallokerad vektor. Vektorpekarens adress passeras
-*                    fr att bde frigra minnet fr det dynamiska flt denna peka p, minnet
-*                    fr sjlva vektorn samt att vektorpekaren stts till null.
+* int_vector_to_string: Returnerar en pekare till en ny heapallokerad, nollterminerad strng
+*                       innehllande samma text som int_vector_print skriver ut fr angiven
+*                       vektor. Strngen mste frigras via free. Vid misslyckad allokering
+*                       returneras null.
 *
-*                    - self: Adressen till vektorpekaren.
+*                       - self  : Pekare till vektorn vars innehll ska omvandlas till text.
+*                       - length: Pekare till variabel som tilldelas strngens lngd (eller null).
 **************************************************************************************************/
-void int_vector_delete(struct int_vector** self);
+char* int_vector_to_string(const struct int_vector* self,
+                           size_t* length);
 
 /**************************************************************************************************
-* int_vector_resize: ndrar storleken / kapaciteten p en vektor via omallokering. Vid lyckad
-*                    omallokering returneras 0, annars returneras felkod 1.
+* int_vector_save: Sparar innehllet i angiven vektor till en binr fil. Filen inleds med ett
+*                  huvud p 32 byte innehllande ett magiskt tal, formatets version, en
+*                  byteordningsmarkr, elementens storlek, en kontrollsumma (CRC-32C) samt
+*                  antalet element, fljt av elementen i maskinens egen byteordning. Vid lyckad
+*                  sparning returneras 0, annars returneras felkod 1.
 *
-*                    - self    : Pekare till vektorn vars storlek skall ndras.
-*                    - new_size: Vektorns nya storlek efter omallokeringen.
+*                  - self    : Pekare till vektorn vars innehll ska sparas.
+*                  - filepath: Skvgen till filen som ska skrivas.
 **************************************************************************************************/
-int int_vector_resize(struct int_vector* self,
-                      const size_t new_size);
+int int_vector_save(const struct int_vector* self,
+                    const char* filepath);
 
 /**************************************************************************************************
-* int_vector_push: Lgger till ett nytt element lngst bak i en vektor. Ifall det nya elementet
-*                  lyckas lggas till returneras 0, annars returneras felkod 1.
+* int_vector_load: Lser in innehllet frn en binr fil sparad via int_vector_save till angiven
+*                  vektor, vars tidigare innehll erstts. Filens huvud och kontrollsumma
+*                  kontrolleras och elementen byteordningsvnds vid behov. Vid lyckad inlsning
+*                  returneras 0, annars returneras felkod 1, varvid vektorn lmnas tom.
 *
-*                  - self       : Pekare till vektorn som ska tilldelas det nya elementet.
-*                  - new_element: Det nya element som skall lggas till lngst bak i vektorn.
+*                  - self    : Pekare till vektorn som ska tilldelas filens innehll.
+*                  - filepath: Skvgen till filen som ska lsas.
 **************************************************************************************************/
-int int_vector_push(struct int_vector* self,
-                    const int new_element);
+int int_vector_load(struct int_vector* self,
+                    const char* filepath);
 
 /**************************************************************************************************
-* int_vector_pop: Tar bort ett element lngst bak i angiven vektor, om ett sdant finns.
-*                 Ifall elementet lyckas tas bort returneras 0, annars returneras felkod 1.
+* int_vector_map: Mappar en binr fil sparad via int_vector_save direkt till angiven vektor,
+*                 vars tidigare innehll erstts, utan att elementen kopieras. Elementen lses
+*                 frn filen frst nr de anvnds, vilket gr att ven stora filer ppnas
+*                 omedelbart. Enbart filens huvud kontrolleras, inte kontrollsumman.
 *
-*                 - self: Pekare till vektorn vars sista elemenet ska tas bort.
+*                 Filen mappas privat, vilket medfr att filen aldrig ndras. Element som
+*                 tilldelas via int_vector_begin kopieras sidvis av operativsystemet och
+*                 vriga ndringar av storlek eller kapacitet kopierar fltet till heapen.
+*                 Om filen har en annan byteordning, eller om minnesmappning inte stds,
+*                 lses filen i stllet in via int_vector_load. Vid lyckad mappning returneras
+*                 0, annars returneras felkod 1, varvid vektorn lmnas tom.
+*
+*                 - self    : Pekare till vektorn som ska tilldelas filens innehll.
+*                 - filepath: Skvgen till filen som ska mappas.
 **************************************************************************************************/
-int int_vector_pop(struct int_vector* self);
+int int_vector_map(struct int_vector* self,
+                   const char* filepath);
 
 /**************************************************************************************************
-* int_vector_print: Skriver ut innehllet lagrat i angiven vektor via angiven utstrm, dr
-*                   standardutenheten stdout anvnds som default fr utskrift i terminalen.
+* int_vector_save_changes: Sparar de element i angiven vektor som har ndrats sedan
+*                          int_vector_mark_clean till en binr fil, s att en kopia av vektorn
+*                          kan uppdateras via int_vector_apply_changes utan att hela vektorn
+*                          skickas. Filen inleds med ett huvud p 40 byte innehllande ett
+*                          magiskt tal, formatets version, en byteordningsmarkr, elementens
+*                          storlek, vektorns kontrollsumma (se int_vector_checksum), vektorns
+*                          storlek samt index och antal fr de ndrade elementen, fljt av
+*                          elementen. Vid lyckad sparning returneras 0, annars returneras
+*                          felkod 1.
 *
-*                   - self   : Pekare till vektorn vars innehll ska skrivas ut.
-*                   - ostream: Pekare till angiven utstrm (default = stdout).
+*                          - self    : Pekare till vektorn vars ndringar ska sparas.
+*                          - filepath: Skvgen till filen som ska skrivas.
 **************************************************************************************************/
-void int_vector_print(const struct int_vector* self, 
-                      FILE* ostream);
+int int_vector_save_changes(const struct int_vector* self,
+                            const char* filepath);
 
 /**************************************************************************************************
-* int_vector_begin: Returnerar adressen till det frsta elementet i angiven vektor.
-*                   Om vektorn r tom returneras null.
+* int_vector_apply_changes: Uppdaterar angiven kopia av en vektor med ndringar sparade via
+*                           int_vector_save_changes, varvid kopians storlek stts till
+*                           originalets. Drefter verifieras kopian mot originalets kontrollsumma,
+*                           vilket med sprning aktiverad (se int_vector_track) enbart krver att
+*                           de ndrade blocken lses. Filer med annan byteordning stds inte. Vid
+*                           lyckad uppdatering returneras 0, annars returneras felkod 1, varvid
+*                           kopian kan skilja sig frn originalet och br lsas in p nytt via
+*                           int_vector_load.
 *
-*                   - self: Pekare till vektorn.
+*                           - self    : Pekare till kopian som ska uppdateras.
+*                           - filepath: Skvgen till filen som ska lsas.
 **************************************************************************************************/
-int* int_vector_begin(const struct int_vector* self);
+int int_vector_apply_changes(struct int_vector* self,
+                             const char* filepath);
 
 /**************************************************************************************************
-* int_vector_end: Returnerar adressen direkt efter det sista elementet i angiven vektor.
-*                 Om vektorn r tom returneras null.
+* int_vector_read_text: Lser in heltal i textformat frn angiven instrm och lgger till dem
+*                       lngst bak i angiven vektor. Texten ska innehlla ett heltal per rad,
+*                       exempelvis utskriften frn int_vector_print. Avgrnsningsrader bestende
+*                       av bindestreck samt tomma rader ignoreras. Instrmmen lses och tolkas
+*                       block fr block, s att ven filer strre n tillgngligt minne fr
+*                       bufferten kan lsas, och heltalen lggs till i vektorn i omgngar.
+*
+*                       Vid lyckad inlsning returneras 0. Vid en felaktig rad, ett heltal som
+*                       inte ryms i en int eller misslyckad lsning eller allokering returneras
+*                       felkod 1, varvid vektorn terstlls till sin tidigare storlek.
 *
-*                 - self: Pekare till vektorn.
+*                       - self      : Pekare till vektorn som ska tilldelas de inlsta heltalen.
+*                       - istream   : Pekare till angiven instrm (default = stdin).
+*                       - error_line: Pekare till variabel som vid fel tilldelas numret p den
+*                                     felaktiga raden, rknat frn 1, eller 0 vid ls- eller
+*                                     allokeringsfel (eller null).
 **************************************************************************************************/
-int* int_vector_end(const struct int_vector* self);
+int int_vector_read_text(struct int_vector* self,
+                         FILE* istream,
+                         size_t* error_line);
 
 /**************************************************************************************************
-* int_vector_last: Returnerar adressen till det sista elementet i angiven vektor.
-*                  Om vektorn r tom returneras null.
+* int_vector_load_text: Lser in heltal i textformat frn angiven fil till angiven vektor, vars
+*                       tidigare innehll erstts, se int_vector_read_text. Vid lyckad inlsning
+*                       returneras 0, annars returneras felkod 1, varvid vektorn lmnas tom.
 *
-*                 - self: Pekare till vektorn.
+*                       - self      : Pekare till vektorn som ska tilldelas de inlsta heltalen.
+*                       - filepath  : Skvgen till filen som ska lsas.
+*                       - error_line: Pekare till variabel som vid fel tilldelas numret p den
+*                                     felaktiga raden, eller 0 vid vriga fel (eller null).
 **************************************************************************************************/
-int* int_vector_last(const struct int_vector* self);
+int int_vector_load_text(struct int_vector* self,
+                         const char* filepath,
+                         size_t* error_line);
 
 #endif /* INT_VECTOR_H_ */
\ No newline at end of file
@@ -0,0 +1,1610 @@
+/**************************************************************************************************
+* int_vector_bench.c: Prestandamtning av vektorer av typen int_vector. Varje mtning krs fr
+*                     ett antal vektorstorlekar och rapporterar genomsnittlig tid per operation
+*                     i nanosekunder, genomstrmning i GB/s (sizeof(int) byte per operation),
+*                     antalet allokeringar per operation samt processens hgsta
+*                     minnesanvndning (peak RSS). Mtningarna av int_vector_compressed
+*                     rapporterar ven kompressionsgraden. Resultatet skrivs ut som tabell, CSV
+*                     eller JSON, s att krningar frn olika versioner kan jmfras.
+*
+*                     Anvndning: int_vector_bench [--sizes=1000,1000000] [--format=table|csv|json]
+*                                                  [--output=fil] [--label=text] [--filter=namn]
+*                                                  [--target=antal]
+*
+*                     - sizes : Kommaseparerade vektorstorlekar (default = 1000,100000,1000000).
+*                     - format: Utskriftsformat (default = table).
+*                     - output: Fil att skriva resultatet till (default = stdout).
+*                     - label : Etikett som skrivs ut p varje rad, exempelvis en commit-hash.
+*                     - filter: Kr enbart mtningar vars namn innehller angiven text.
+*                     - target: Ungefrligt antal element som bearbetas per mtning, vilket
+*                               avgr antalet repetitioner fr sm vektorer (default = 4000000).
+*
+*                     Mtningarna sort, sort_parallel och sort_qsort jmfr radixsorteringen med
+*                     qsort, exempelvis vid 1K, 1M och 100M element via
+*                     --sizes=1000,1000000,100000000 --filter=sort. Storleken 100M ingr inte i
+*                     BENCH_DEFAULT_SIZES, d samtliga mtningar vid den storleken krver flera GB
+*                     minne och lng tid, exempelvis contains_scan som sker linjrt 1024 gnger.
+*
+*                     Mtningarna set_* jmfr mngdoperationerna i int_vector_set med varandra,
+*                     dr set_intersection_gallop anvnder en vektor som r BENCH_SET_RATIO gnger
+*                     mindre. Mtningarna contains_* jmfr linjr skning, binrskning samt
+*                     hashindex via int_vector_index, dr hlften av skningarna trffar.
+*
+*                     Mtningarna crc32c, checksum_full och checksum_update jmfr berkning av
+*                     kontrollsumman ver hela vektorn med uppdatering via int_vector_track, dr
+*                     ett element ndras fre varje berkning.
+*
+*                     Mtningarna kontrollerar inte resultatens korrekthet, vilket i stllet grs
+*                     av int_vector_test. Vid allokeringsfel eller liknande avslutas programmet
+*                     med felkod 1.
+*
+*                     Om programmet r kompilerat med VECTOR_STATS skrivs den globala
+*                     allokeringsstatistiken ut via stderr efter mtningarna.
+**************************************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+/* Inkluderingsdirektiv: */
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "crc32c.h"
+#include "huge_allocator.h"
+#include "int_vector.h"
+#include "int_ring.h"
+#include "int_vector_concurrent.h"
+#include "int_vector_parallel.h"
+#include "int_vector_compressed.h"
+#include "int_vector_set.h"
+#include "int_vector_simd.h"
+#include "int_vector_sort.h"
+
+/**************************************************************************************************
+* BENCH_DEFAULT_SIZES: Vektorstorlekar som anvnds om inga storlekar anges.
+*
+* BENCH_DEFAULT_TARGET: Ungefrligt antal element som bearbetas per mtning.
+*
+* BENCH_MAX_SIZES: Maximalt antal vektorstorlekar som kan anges.
+*
+* BENCH_CHURN_COUNT: Antalet vektorer som skapas och raderas per repetition vid mtningen churn.
+*
+* BENCH_RING_CAPACITY: Ringbuffertens kapacitet vid mtningarna ring och ring_batch.
+*
+* BENCH_RING_BATCH: Antalet element per anrop vid mtningen ring_batch.
+*
+* BENCH_WRITERS: Antalet skrivande trdar vid mtningen concurrent_push.
+*
+* BENCH_SET_RATIO: Storleksfrhllandet mellan vektorerna vid mtningen set_intersection_gallop.
+*
+* BENCH_LOOKUPS: Antalet skningar per repetition vid mtningarna contains_* samt antalet
+*                ndringar per repetition vid mtningen checksum_update.
+**************************************************************************************************/
+#define BENCH_DEFAULT_SIZES "1000,100000,1000000"
+#define BENCH_DEFAULT_TARGET 4000000
+#define BENCH_MAX_SIZES 32
+#define BENCH_CHURN_COUNT 64
+#define BENCH_RING_CAPACITY 4096
+#define BENCH_RING_BATCH 256
+#define BENCH_WRITERS 4
+#define BENCH_SET_RATIO 256
+#define BENCH_LOOKUPS 1024
+
+/**************************************************************************************************
+* bench_format: Enumeration fr utskriftsformat.
+**************************************************************************************************/
+enum bench_format
+{
+   BENCH_FORMAT_TABLE, /* Tabell fr lsning i terminalen. */
+   BENCH_FORMAT_CSV,   /* Kommaseparerade vrden. */
+   BENCH_FORMAT_JSON   /* JSON-flt med ett objekt per mtning. */
+};
+
+/**************************************************************************************************
+* bench_counter: Allokator som vidarebefordrar anrop till malloc, realloc och free samt rknar
+*                antalet anrop, s att antalet allokeringar per operation kan rapporteras.
+**************************************************************************************************/
+struct bench_counter
+{
+   struct allocator allocator; /* Allokatorns grnssnitt, som skickas till vektorerna. */
+   size_t allocations;         /* Antalet anrop till malloc. */
+   size_t reallocations;       /* Antalet anrop till realloc. */
+   size_t deallocations;       /* Antalet anrop till free. */
+};
+
+/**************************************************************************************************
+* bench_context: Gemensamt tillstnd fr mtningarna.
+**************************************************************************************************/
+struct bench_context
+{
+   struct bench_counter counter; /* Rknande allokator fr mtta vektorer. */
+   struct int_vector input;      /* Slumpmssiga heltal av aktuell storlek. */
+   FILE* null_stream;            /* Utstrm kopplad till /dev/null. */
+   FILE* text_stream;            /* Temporr fil innehllande input i textformat. */
+   int failed;                   /* Indikerar ifall en mtning har misslyckats. */
+   double ratio;                 /* Kompressionsgrad, stts av mtningar av komprimering. */
+};
+
+/**************************************************************************************************
+* bench_ring_task: Producentens uppgift vid mtningarna ring och ring_batch.
+**************************************************************************************************/
+struct bench_ring_task
+{
+   struct int_ring* ring; /* Pekare till ringbufferten. */
+   size_t size;           /* Antalet heltal som ska skickas. */
+   size_t batch;          /* Antalet heltal per anrop (1 = int_ring_push). */
+};
+
+/**************************************************************************************************
+* bench_writer_task: En skrivande trds uppgift vid mtningen concurrent_push.
+**************************************************************************************************/
+struct bench_writer_task
+{
+   struct int_vector_concurrent* vector; /* Pekare till den delade vektorn. */
+   size_t first;                         /* Det frsta heltalet som ska lggas till. */
+   size_t last;                          /* Heltalet direkt efter det sista som ska lggas till. */
+};
+
+/**************************************************************************************************
+* bench_case: Mtning, dr funktionen genomfr en repetition och returnerar den uppmtta tiden i
+*             nanosekunder. Rknaren nollstlls av funktionen precis innan tidtagningen startar.
+**************************************************************************************************/
+struct bench_case
+{
+   const char* name; /* Mtningens namn. */
+   double (*run)(struct bench_context* context, const size_t size, size_t* ops); /* Mtning. */
+};
+
+/**************************************************************************************************
+* bench_result: Resultat frn en mtning fr en viss vektorstorlek.
+**************************************************************************************************/
+struct bench_result
+{
+   const char* name;       /* Mtningens namn. */
+   size_t size;            /* Vektorns storlek. */
+   size_t repetitions;     /* Antalet repetitioner. */
+   double ns_per_op;       /* Genomsnittlig tid per operation i nanosekunder. */
+   double gb_per_s;        /* Genomstrmning i GB/s, rknat som sizeof(int) byte per operation. */
+   double allocs_per_op;   /* Genomsnittligt antal allokeringar och omallokeringar per operation. */
+   long peak_rss_kb;       /* Processens hgsta minnesanvndning hittills i kilobyte. */
+   double ratio;           /* Kompressionsgrad (0 = ej tillmpligt). */
+};
+
+/* Variabel som tilldelas mtningarnas resultat, s att berkningarna inte optimeras bort. */
+static volatile int64_t bench_sink;
+
+/**************************************************************************************************
+* bench_counter_allocate: Allokerar minnesblock via malloc och rknar anropet.
+**************************************************************************************************/
+static void* bench_counter_allocate(void* context,
+                                    size_t size)
+{
+   struct bench_counter* self = (struct bench_counter*)context;
+   self->allocations++;
+   return malloc(size);
+}
+
+/**************************************************************************************************
+* bench_counter_reallocate: Omallokerar minnesblock via realloc och rknar anropet.
+**************************************************************************************************/
+static void* bench_counter_reallocate(void* context,
+                                      void* block,
+                                      size_t old_size,
+                                      size_t new_size)
+{
+   struct bench_counter* self = (struct bench_counter*)context;
+   (void)old_size;
+   self->reallocations++;
+   return realloc(block, new_size);
+}
+
+/**************************************************************************************************
+* bench_counter_deallocate: Frigr minnesblock via free och rknar anropet.
+**************************************************************************************************/
+static void bench_counter_deallocate(void* context,
+                                     void* block,
+                                     size_t size)
+{
+   struct bench_counter* self = (struct bench_counter*)context;
+   (void)size;
+   self->deallocations++;
+   free(block);
+   return;
+}
+
+/**************************************************************************************************
+* bench_counter_init: Initierar ny rknande allokator.
+*
+*                     - self: Pekare till allokatorn som ska initieras.
+**************************************************************************************************/
+static void bench_counter_init(struct bench_counter* self)
+{
+   self->allocator.allocate = bench_counter_allocate;
+   self->allocator.reallocate = bench_counter_reallocate;
+   self->allocator.deallocate = bench_counter_deallocate;
+   self->allocator.context = self;
+   self->allocations = 0;
+   self->reallocations = 0;
+   self->deallocations = 0;
+   return;
+}
+
+/**************************************************************************************************
+* bench_counter_reset: Nollstller rknarna i angiven allokator.
+*
+*                      - self: Pekare till allokatorn vars rknare ska nollstllas.
+**************************************************************************************************/
+static void bench_counter_reset(struct bench_counter* self)
+{
+   self->allocations = 0;
+   self->reallocations = 0;
+   self->deallocations = 0;
+   return;
+}
+
+/**************************************************************************************************
+* bench_now: Returnerar aktuell tid frn en monoton klocka i nanosekunder.
+**************************************************************************************************/
+static double bench_now(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/**************************************************************************************************
+* bench_peak_rss_kb: Returnerar processens hgsta minnesanvndning hittills i kilobyte.
+**************************************************************************************************/
+static long bench_peak_rss_kb(void)
+{
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage)) return 0;
+   return usage.ru_maxrss;
+}
+
+/**************************************************************************************************
+* bench_random_fill: Fyller angiven vektor med pseudoslumpmssiga heltal via xorshift, s att
+*                    samma storlek alltid ger samma innehll.
+*
+*                    - self: Pekare till vektorn som ska fyllas.
+*                    - size: Vektorns nya storlek.
+**************************************************************************************************/
+static int bench_random_fill(struct int_vector* self,
+                             const size_t size)
+{
+   uint32_t state = 2463534242u;
+   if (int_vector_resize(self, size)) return 1;
+
+   for (int* i = int_vector_begin(self); i < int_vector_end(self); ++i)
+   {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      *i = (int)state;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* bench_push: Mter int_vector_push fr en tom vektor som vxer till angiven storlek.
+**************************************************************************************************/
+static double bench_push(struct bench_context* context,
+                         const size_t size,
+                         size_t* ops)
+{
+   struct int_vector v;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      int_vector_push(&v, (int)i);
+   }
+
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_pop: Mter int_vector_pop fr en full vektor som tms element fr element.
+**************************************************************************************************/
+static double bench_pop(struct bench_context* context,
+                        const size_t size,
+                        size_t* ops)
+{
+   struct int_vector v;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   int_vector_resize(&v, size);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      int_vector_pop(&v);
+   }
+
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_resize: Mter int_vector_resize d vektorn vxer med ett element i taget.
+**************************************************************************************************/
+static double bench_resize(struct bench_context* context,
+                           const size_t size,
+                           size_t* ops)
+{
+   struct int_vector v;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (size_t i = 1; i <= size; ++i)
+   {
+      int_vector_resize(&v, i);
+   }
+
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_push_huge: Mter int_vector_push via huge_allocator, dr stora flt vxer via mremap.
+*                  Fltets justering kontrolleras efter varje omallokering.
+**************************************************************************************************/
+static double bench_push_huge(struct bench_context* context,
+                              const size_t size,
+                              size_t* ops)
+{
+   struct huge_allocator huge;
+   struct int_vector v;
+   huge_allocator_init(&huge, 0);
+   int_vector_init_with_allocator(&v, &huge.allocator);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      int_vector_push(&v, (int)i);
+   }
+
+   const double elapsed = bench_now() - start;
+
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_sum_huge: Mter int_vector_sum fr en kopia av indata lagrad via huge_allocator, vilket
+*                 kan jmfras med mtningen sum fr att se effekten av stora sidor.
+**************************************************************************************************/
+static double bench_sum_huge(struct bench_context* context,
+                             const size_t size,
+                             size_t* ops)
+{
+   struct huge_allocator huge;
+   struct int_vector v;
+   huge_allocator_init(&huge, 0);
+   int_vector_init_with_allocator(&v, &huge.allocator);
+
+   if (int_vector_append_range(&v, context->input.data, context->input.size))
+   {
+      context->failed = 1;
+   }
+
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   bench_sink = int_vector_sum(&v);
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_fill_run: Mter tilldelning av en vektor med angiven storlek via angiven funktion, dr
+*                 vektorns flt allokeras fre mtningen.
+**************************************************************************************************/
+static double bench_fill_run(struct bench_context* context,
+                             const size_t size,
+                             size_t* ops,
+                             int (*assign)(struct int_vector*, const size_t, const int, const int))
+{
+   struct int_vector v;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   if (int_vector_reserve(&v, size)) context->failed = 1;
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+   if (assign(&v, size, (int)size, -1)) context->failed = 1;
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_fill: Mter int_vector_assign_step, dvs. en nedrkning som i main.c, via en trd.
+**************************************************************************************************/
+static double bench_fill(struct bench_context* context,
+                         const size_t size,
+                         size_t* ops)
+{
+   return bench_fill_run(context, size, ops, int_vector_assign_step);
+}
+
+/**************************************************************************************************
+* bench_fill_parallel: Mter int_vector_parallel_assign_step via den globala trdpoolen.
+**************************************************************************************************/
+static double bench_fill_parallel(struct bench_context* context,
+                                  const size_t size,
+                                  size_t* ops)
+{
+   return bench_fill_run(context, size, ops, int_vector_parallel_assign_step);
+}
+
+/**************************************************************************************************
+* bench_sum_parallel: Mter int_vector_parallel_sum via den globala trdpoolen.
+**************************************************************************************************/
+static double bench_sum_parallel(struct bench_context* context,
+                                 const size_t size,
+                                 size_t* ops)
+{
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   bench_sink = int_vector_parallel_sum(&context->input);
+   const double elapsed = bench_now() - start;
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_iterate: Mter iteration ver vektorn via int_vector_begin och int_vector_end.
+**************************************************************************************************/
+static double bench_iterate(struct bench_context* context,
+                            const size_t size,
+                            size_t* ops)
+{
+   int64_t sum = 0;
+   const int* end = int_vector_cend(&context->input);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (const int* i = int_vector_cbegin(&context->input); i < end; ++i)
+   {
+      sum += *i;
+   }
+
+   const double elapsed = bench_now() - start;
+   bench_sink = sum;
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_sum: Mter den vektoriserade summeringen int_vector_sum.
+**************************************************************************************************/
+static double bench_sum(struct bench_context* context,
+                        const size_t size,
+                        size_t* ops)
+{
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   bench_sink = int_vector_sum(&context->input);
+   const double elapsed = bench_now() - start;
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_print: Mter int_vector_print till /dev/null.
+**************************************************************************************************/
+static double bench_print(struct bench_context* context,
+                          const size_t size,
+                          size_t* ops)
+{
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   int_vector_print(&context->input, context->null_stream);
+   fflush(context->null_stream);
+   const double elapsed = bench_now() - start;
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_parse: Mter int_vector_read_text frn en temporr fil med vektorns innehll i textformat.
+**************************************************************************************************/
+static double bench_parse(struct bench_context* context,
+                          const size_t size,
+                          size_t* ops)
+{
+   struct int_vector v;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   rewind(context->text_stream);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+   int_vector_read_text(&v, context->text_stream, 0);
+   const double elapsed = bench_now() - start;
+
+   bench_sink = (int64_t)v.size;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_parse_fscanf: Mter inlsning av samma fil som bench_parse via ett fscanf-anrop per rad
+*                     samt int_vector_push, som jmfrelse.
+**************************************************************************************************/
+static double bench_parse_fscanf(struct bench_context* context,
+                                 const size_t size,
+                                 size_t* ops)
+{
+   struct int_vector v;
+   char line[128];
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   rewind(context->text_stream);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   while (fgets(line, sizeof(line), context->text_stream))
+   {
+      int value;
+      if (sscanf(line, "%d", &value) == 1) int_vector_push(&v, value);
+   }
+
+   const double elapsed = bench_now() - start;
+   bench_sink = (int64_t)v.size;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_sort_setup: Kopierar slumpmssiga heltal till angiven vektor infr en sorteringsmtning.
+**************************************************************************************************/
+static void bench_sort_setup(struct bench_context* context,
+                             struct int_vector* v)
+{
+   int_vector_init_with_allocator(v, &context->counter.allocator);
+   int_vector_append_range(v, context->input.data, context->input.size);
+   bench_counter_reset(&context->counter);
+   return;
+}
+
+/**************************************************************************************************
+* bench_sort: Mter radixsorteringen int_vector_sort.
+**************************************************************************************************/
+static double bench_sort(struct bench_context* context,
+                         const size_t size,
+                         size_t* ops)
+{
+   struct int_vector v;
+   bench_sort_setup(context, &v);
+   const double start = bench_now();
+   int_vector_sort(&v);
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_sort_parallel: Mter int_vector_sort_parallel med en trd per processorkrna.
+**************************************************************************************************/
+static double bench_sort_parallel(struct bench_context* context,
+                                  const size_t size,
+                                  size_t* ops)
+{
+   struct int_vector v;
+   bench_sort_setup(context, &v);
+   const double start = bench_now();
+   int_vector_sort_parallel(&v, 0);
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_int_compare: Jmfrelsefunktion fr qsort.
+**************************************************************************************************/
+static int bench_int_compare(const void* a,
+                             const void* b)
+{
+   const int x = *(const int*)a;
+   const int y = *(const int*)b;
+   return (x > y) - (x < y);
+}
+
+/**************************************************************************************************
+* bench_sort_qsort: Mter sortering via qsort, som jmfrelse.
+**************************************************************************************************/
+static double bench_sort_qsort(struct bench_context* context,
+                               const size_t size,
+                               size_t* ops)
+{
+   struct int_vector v;
+   bench_sort_setup(context, &v);
+   const double start = bench_now();
+   qsort(v.data, v.size, sizeof(int), bench_int_compare);
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_churn: Mter skapande och radering av dynamiskt allokerade vektorer av angiven storlek
+*              via int_vector_new och int_vector_delete. En operation motsvarar ett par.
+**************************************************************************************************/
+static double bench_churn(struct bench_context* context,
+                          const size_t size,
+                          size_t* ops)
+{
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+
+   for (size_t i = 0; i < BENCH_CHURN_COUNT; ++i)
+   {
+      struct int_vector* v = int_vector_new_with_allocator(size, &context->counter.allocator);
+      if (v) int_vector_delete(&v);
+   }
+
+   const double elapsed = bench_now() - start;
+   *ops = BENCH_CHURN_COUNT;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_clone: Mter kopiering av en vektor av angiven storlek via int_vector_clone.
+**************************************************************************************************/
+static double bench_clone(struct bench_context* context,
+                          const size_t size,
+                          size_t* ops)
+{
+   struct int_vector v;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   const int result = int_vector_clone(&v, &context->input);
+   const double elapsed = bench_now() - start;
+   if (result) context->failed = 1;
+   int_vector_clear(&v);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_share: Mter delning av en vektor av angiven storlek via int_vector_share fljt av
+*              lsning via int_vector_cbegin, vilket inte kopierar fltet.
+**************************************************************************************************/
+static double bench_share(struct bench_context* context,
+                          const size_t size,
+                          size_t* ops)
+{
+   struct int_vector source, v;
+   int_vector_init(&source);
+   int_vector_init(&v);
+   if (int_vector_clone(&source, &context->input)) context->failed = 1;
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   const int result = int_vector_share(&v, &source);
+   bench_sink = size ? int_vector_cbegin(&v)[size - 1] : 0;
+   const double elapsed = bench_now() - start;
+   if (result) context->failed = 1;
+   int_vector_clear(&v);
+   int_vector_clear(&source);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_share_write: Mter delning via int_vector_share fljt av en skrivning via
+*                    int_vector_begin, vilket kopierar fltet exakt en gng.
+**************************************************************************************************/
+static double bench_share_write(struct bench_context* context,
+                                const size_t size,
+                                size_t* ops)
+{
+   struct int_vector source, v;
+   int_vector_init(&source);
+   int_vector_init(&v);
+   if (int_vector_clone(&source, &context->input)) context->failed = 1;
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   const int result = int_vector_share(&v, &source);
+   int* data = int_vector_begin(&v);
+   if (data && size) data[0] = ~data[0];
+   const double elapsed = bench_now() - start;
+   if (result || !data) context->failed = 1;
+   int_vector_clear(&v);
+   int_vector_clear(&source);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_ring_produce: Producentens trd, som skickar heltalen 0, 1, 2... via ringbufferten,
+*                     ett i taget eller i block. Trden lmnar ifrn sig processorn d bufferten
+*                     r full.
+*
+*                     - arg: Pekare till producentens uppgift.
+**************************************************************************************************/
+static void* bench_ring_produce(void* arg)
+{
+   const struct bench_ring_task* task = (const struct bench_ring_task*)arg;
+   int batch[BENCH_RING_BATCH];
+   size_t sent = 0;
+
+   while (sent < task->size)
+   {
+      if (task->batch == 1)
+      {
+         if (!int_ring_push(task->ring, (int)sent)) sent++;
+         else sched_yield();
+      }
+      else
+      {
+         const size_t remaining = task->size - sent;
+         const size_t n = remaining < task->batch ? remaining : task->batch;
+         size_t pushed = 0;
+
+         for (size_t i = 0; i < n; ++i)
+         {
+            batch[i] = (int)(sent + i);
+         }
+
+         while (pushed < n)
+         {
+            const size_t count = int_ring_push_range(task->ring, batch + pushed, n - pushed);
+            if (!count) sched_yield();
+            pushed += count;
+         }
+
+         sent += n;
+      }
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* bench_ring_run: Startar en producenttrd som skickar angivet antal heltal via en ringbuffert
+*                 och tar emot dem i den anropande trden, ett i taget eller i block.
+*
+*                 - context: Pekare till mtningarnas gemensamma tillstnd.
+*                 - size   : Antalet heltal som ska skickas.
+*                 - batch  : Antalet heltal per anrop (1 = int_ring_push och int_ring_pop).
+**************************************************************************************************/
+static double bench_ring_run(struct bench_context* context,
+                             const size_t size,
+                             const size_t batch)
+{
+   struct int_ring ring;
+   struct bench_ring_task task;
+   pthread_t producer;
+   int buffer[BENCH_RING_BATCH];
+   size_t received = 0;
+
+   if (int_ring_init_with_allocator(&ring, BENCH_RING_CAPACITY, &context->counter.allocator))
+   {
+      context->failed = 1;
+      return 0;
+   }
+
+   task.ring = &ring;
+   task.size = size;
+   task.batch = batch;
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   if (pthread_create(&producer, 0, bench_ring_produce, &task))
+   {
+      int_ring_clear(&ring);
+      context->failed = 1;
+      return 0;
+   }
+
+   while (received < size)
+   {
+      const size_t count = batch == 1 ? !int_ring_pop(&ring, buffer)
+                                      : int_ring_pop_range(&ring, buffer, batch);
+      if (!count) sched_yield();
+      received += count;
+   }
+
+   pthread_join(producer, 0);
+   const double elapsed = bench_now() - start;
+   int_ring_clear(&ring);
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_ring: Mter verfring av heltal mellan tv trdar via int_ring_push och int_ring_pop.
+**************************************************************************************************/
+static double bench_ring(struct bench_context* context,
+                         const size_t size,
+                         size_t* ops)
+{
+   *ops = size;
+   return bench_ring_run(context, size, 1);
+}
+
+/**************************************************************************************************
+* bench_ring_batch: Mter verfring av heltal mellan tv trdar via int_ring_push_range och
+*                   int_ring_pop_range.
+**************************************************************************************************/
+static double bench_ring_batch(struct bench_context* context,
+                               const size_t size,
+                               size_t* ops)
+{
+   *ops = size;
+   return bench_ring_run(context, size, BENCH_RING_BATCH);
+}
+
+/**************************************************************************************************
+* bench_concurrent_write: Skrivande trd, som lgger till heltalen first, first + 1... last - 1
+*                         i den delade vektorn.
+*
+*                         - arg: Pekare till trdens uppgift.
+**************************************************************************************************/
+static void* bench_concurrent_write(void* arg)
+{
+   const struct bench_writer_task* task = (const struct bench_writer_task*)arg;
+
+   for (size_t i = task->first; i < task->last; ++i)
+   {
+      int_vector_concurrent_push(task->vector, (int)i);
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* bench_concurrent_push: Mter int_vector_concurrent_push d BENCH_WRITERS trdar lgger till
+*                        heltalen 0, 1, 2... samtidigt i samma vektor.
+**************************************************************************************************/
+static double bench_concurrent_push(struct bench_context* context,
+                                    const size_t size,
+                                    size_t* ops)
+{
+   struct int_vector_concurrent vector;
+   struct bench_writer_task tasks[BENCH_WRITERS];
+   pthread_t threads[BENCH_WRITERS];
+   size_t started = 0;
+
+   int_vector_concurrent_init_with_allocator(&vector, &context->counter.allocator);
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (size_t i = 0; i < BENCH_WRITERS; ++i)
+   {
+      tasks[i].vector = &vector;
+      tasks[i].first = size * i / BENCH_WRITERS;
+      tasks[i].last = size * (i + 1) / BENCH_WRITERS;
+      if (pthread_create(&threads[i], 0, bench_concurrent_write, &tasks[i])) break;
+      started++;
+   }
+
+   for (size_t i = 0; i < started; ++i)
+   {
+      pthread_join(threads[i], 0);
+   }
+
+   const double elapsed = bench_now() - start;
+   if (started < BENCH_WRITERS) context->failed = 1;
+   int_vector_concurrent_clear(&vector);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_walk_fill: Fyller angiven vektor med en lngsamt varierande sekvens, dr varje element
+*                  skiljer sig frn fregende med -3 till 3, hrledd frn de slumpmssiga
+*                  heltalen i input.
+**************************************************************************************************/
+static int bench_walk_fill(struct bench_context* context,
+                           struct int_vector* v)
+{
+   unsigned int value = 0;
+   int_vector_init(v);
+   if (int_vector_resize(v, context->input.size)) return 1;
+
+   for (size_t i = 0; i < v->size; ++i)
+   {
+      value += (unsigned int)context->input.data[i] % 7 - 3;
+      v->data[i] = (int)value;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* bench_compress_encode: Mter int_vector_compressed_encode fr en lngsamt varierande sekvens.
+**************************************************************************************************/
+static double bench_compress_encode(struct bench_context* context,
+                                    const size_t size,
+                                    size_t* ops)
+{
+   struct int_vector walk;
+   struct int_vector_compressed compressed;
+   int_vector_compressed_init_with_allocator(&compressed, &context->counter.allocator);
+   if (bench_walk_fill(context, &walk)) context->failed = 1;
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+   if (int_vector_compressed_encode_vector(&compressed, &walk)) context->failed = 1;
+   const double elapsed = bench_now() - start;
+
+   context->ratio = int_vector_compressed_ratio(&compressed);
+   int_vector_compressed_clear(&compressed);
+   int_vector_clear(&walk);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_compress_decode_run: Komprimerar angiven sekvens och mter uppackning av samtliga block
+*                            via int_vector_compressed_decode_block.
+**************************************************************************************************/
+static double bench_compress_decode_run(struct bench_context* context,
+                                        struct int_vector* v,
+                                        const size_t size,
+                                        size_t* ops)
+{
+   struct int_vector_compressed compressed;
+   struct int_vector decoded;
+   int_vector_compressed_init(&compressed);
+   int_vector_init_with_allocator(&decoded, &context->counter.allocator);
+   if (int_vector_compressed_encode_vector(&compressed, v) ||
+       int_vector_resize(&decoded, compressed.block_count * INT_VECTOR_COMPRESSED_BLOCK_SIZE))
+   {
+      context->failed = 1;
+   }
+   bench_counter_reset(&context->counter);
+
+   const double start = bench_now();
+
+   for (size_t i = 0; i < compressed.block_count; ++i)
+   {
+      int_vector_compressed_decode_block(&compressed, i,
+                                         decoded.data + i * INT_VECTOR_COMPRESSED_BLOCK_SIZE);
+   }
+
+   const double elapsed = bench_now() - start;
+   context->ratio = int_vector_compressed_ratio(&compressed);
+   int_vector_compressed_clear(&compressed);
+   int_vector_clear(&decoded);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_compress_decode: Mter uppackning av en komprimerad lngsamt varierande sekvens.
+**************************************************************************************************/
+static double bench_compress_decode(struct bench_context* context,
+                                    const size_t size,
+                                    size_t* ops)
+{
+   struct int_vector walk;
+   if (bench_walk_fill(context, &walk)) context->failed = 1;
+   const double elapsed = bench_compress_decode_run(context, &walk, size, ops);
+   int_vector_clear(&walk);
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_compress_decode_scalar: Mter uppackning av samma sekvens som bench_compress_decode via
+*                               de skalra versionerna, som jmfrelse.
+**************************************************************************************************/
+static double bench_compress_decode_scalar(struct bench_context* context,
+                                           const size_t size,
+                                           size_t* ops)
+{
+   const enum int_vector_simd_level level = int_vector_simd_current();
+   int_vector_simd_select(INT_VECTOR_SIMD_SCALAR);
+   const double elapsed = bench_compress_decode(context, size, ops);
+   int_vector_simd_select(level);
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_compress_decode_step: Mter uppackning av en komprimerad aritmetisk sekvens (i * 2),
+*                             motsvarande innehllet i heap.c.
+**************************************************************************************************/
+static double bench_compress_decode_step(struct bench_context* context,
+                                         const size_t size,
+                                         size_t* ops)
+{
+   struct int_vector step;
+   int_vector_init(&step);
+   if (int_vector_assign_step(&step, size, 0, 2)) context->failed = 1;
+   const double elapsed = bench_compress_decode_run(context, &step, size, ops);
+   int_vector_clear(&step);
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_set_fill: Tilldelar angiven vektor en strikt stigande sekvens av angiven storlek, dr
+*                 avstndet mellan elementen r ett pseudoslumpmssigt tal frn 1 till 4 gnger
+*                 angiven skala. Olika frn ger sekvenser som delvis verlappar.
+*
+*                 - self : Pekare till vektorn som ska tilldelas sekvensen.
+*                 - size : Sekvensens storlek.
+*                 - seed : Startvrde fr slumptalsgeneratorn (ej 0).
+*                 - scale: Skala fr avstndet mellan elementen.
+**************************************************************************************************/
+static int bench_set_fill(struct int_vector* self,
+                          const size_t size,
+                          uint32_t seed,
+                          const int scale)
+{
+   int value = 0;
+   if (int_vector_resize(self, size)) return 1;
+
+   for (int* i = int_vector_begin(self); i < int_vector_end(self); ++i)
+   {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      value += (int)(seed % 4 + 1) * scale;
+      *i = value;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* bench_set_run: Genomfr en mngdoperation fr tv sekvenser, dr den andra r angivet antal
+*                gnger mindre. En operation motsvarar ett element i den strre sekvensen.
+*
+*                - context  : Pekare till mtningarnas gemensamma tillstnd.
+*                - size     : Den strre sekvensens storlek.
+*                - ops      : Pekare till variabeln som ska tilldelas antalet operationer.
+*                - operation: Mngdoperationen som ska mtas.
+*                - ratio    : Storleksfrhllandet mellan sekvenserna.
+**************************************************************************************************/
+static double bench_set_run(struct bench_context* context,
+                            const size_t size,
+                            size_t* ops,
+                            int (*operation)(struct int_vector*, const struct int_vector*,
+                                             const struct int_vector*),
+                            const size_t ratio)
+{
+   struct int_vector lhs, rhs, result;
+   int_vector_init(&lhs);
+   int_vector_init(&rhs);
+   int_vector_init_with_allocator(&result, &context->counter.allocator);
+
+   if (bench_set_fill(&lhs, size, 2463534242u, 1) ||
+       bench_set_fill(&rhs, size / ratio, 88675123u, (int)ratio))
+   {
+      context->failed = 1;
+   }
+
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   if (operation(&result, &lhs, &rhs)) context->failed = 1;
+   const double elapsed = bench_now() - start;
+   int_vector_clear(&result);
+   int_vector_clear(&rhs);
+   int_vector_clear(&lhs);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_set_union: Mter int_vector_set_union fr tv lika stora sekvenser.
+**************************************************************************************************/
+static double bench_set_union(struct bench_context* context,
+                              const size_t size,
+                              size_t* ops)
+{
+   return bench_set_run(context, size, ops, int_vector_set_union, 1);
+}
+
+/**************************************************************************************************
+* bench_set_intersection: Mter int_vector_set_intersection fr tv lika stora sekvenser.
+**************************************************************************************************/
+static double bench_set_intersection(struct bench_context* context,
+                                     const size_t size,
+                                     size_t* ops)
+{
+   return bench_set_run(context, size, ops, int_vector_set_intersection, 1);
+}
+
+/**************************************************************************************************
+* bench_set_intersection_gallop: Mter int_vector_set_intersection d den ena sekvensen r
+*                                BENCH_SET_RATIO gnger mindre, vilket medfr galoppering.
+**************************************************************************************************/
+static double bench_set_intersection_gallop(struct bench_context* context,
+                                            const size_t size,
+                                            size_t* ops)
+{
+   return bench_set_run(context, size, ops, int_vector_set_intersection, BENCH_SET_RATIO);
+}
+
+/**************************************************************************************************
+* bench_set_difference: Mter int_vector_set_difference fr tv lika stora sekvenser.
+**************************************************************************************************/
+static double bench_set_difference(struct bench_context* context,
+                                   const size_t size,
+                                   size_t* ops)
+{
+   return bench_set_run(context, size, ops, int_vector_set_difference, 1);
+}
+
+/**************************************************************************************************
+* bench_lookup_value: Returnerar vrdet fr angiven skning, dr varannan skning avser ett
+*                     element i vektorn och vriga avser ett vrde som sannolikt saknas.
+*
+*                     - vector: Pekare till vektorn som sks igenom.
+*                     - lookup: Skningens nummer.
+**************************************************************************************************/
+static int bench_lookup_value(const struct int_vector* vector,
+                              const size_t lookup)
+{
+   if (!vector->size) return (int)lookup;
+   const int value = vector->data[(lookup * 7919) % vector->size];
+   return lookup % 2 ? value : ~value;
+}
+
+/**************************************************************************************************
+* bench_contains_scan: Mter medlemskap via linjr skning frn int_vector_cbegin till
+*                      int_vector_cend i den osorterade vektorn, som jmfrelse.
+**************************************************************************************************/
+static double bench_contains_scan(struct bench_context* context,
+                                  const size_t size,
+                                  size_t* ops)
+{
+   const int* first = int_vector_cbegin(&context->input);
+   const int* last = int_vector_cend(&context->input);
+   size_t found = 0;
+   (void)size;
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+
+   for (size_t i = 0; i < BENCH_LOOKUPS; ++i)
+   {
+      const int value = bench_lookup_value(&context->input, i);
+
+      for (const int* j = first; j < last; ++j)
+      {
+         if (*j == value)
+         {
+            found++;
+            break;
+         }
+      }
+   }
+
+   const double elapsed = bench_now() - start;
+   bench_sink = (int64_t)found;
+   *ops = BENCH_LOOKUPS;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_contains_sorted: Mter medlemskap via int_vector_binary_search i en sorterad kopia av
+*                        vektorn. Sorteringen ingr inte i mtningen.
+**************************************************************************************************/
+static double bench_contains_sorted(struct bench_context* context,
+                                    const size_t size,
+                                    size_t* ops)
+{
+   struct int_vector sorted;
+   size_t found = 0;
+   (void)size;
+   int_vector_init(&sorted);
+   if (int_vector_clone(&sorted, &context->input) || int_vector_sort(&sorted)) context->failed = 1;
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+
+   for (size_t i = 0; i < BENCH_LOOKUPS; ++i)
+   {
+      if (int_vector_binary_search(&sorted, bench_lookup_value(&context->input, i))) found++;
+   }
+
+   const double elapsed = bench_now() - start;
+   bench_sink = (int64_t)found;
+   int_vector_clear(&sorted);
+   *ops = BENCH_LOOKUPS;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_contains_index: Mter medlemskap via int_vector_index_contains. Bygget av indexet ingr
+*                       inte i mtningen, se index_build.
+**************************************************************************************************/
+static double bench_contains_index(struct bench_context* context,
+                                   const size_t size,
+                                   size_t* ops)
+{
+   struct int_vector_index index;
+   size_t found = 0;
+   (void)size;
+   int_vector_index_init(&index);
+   if (int_vector_index_build(&index, &context->input)) context->failed = 1;
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+
+   for (size_t i = 0; i < BENCH_LOOKUPS; ++i)
+   {
+      if (int_vector_index_contains(&index, bench_lookup_value(&context->input, i))) found++;
+   }
+
+   const double elapsed = bench_now() - start;
+   bench_sink = (int64_t)found;
+   int_vector_index_clear(&index);
+   *ops = BENCH_LOOKUPS;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_index_build: Mter int_vector_index_build fr vektorn. En operation motsvarar ett
+*                    element.
+**************************************************************************************************/
+static double bench_index_build(struct bench_context* context,
+                                const size_t size,
+                                size_t* ops)
+{
+   struct int_vector_index index;
+   int_vector_index_init_with_allocator(&index, &context->counter.allocator);
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   if (int_vector_index_build(&index, &context->input)) context->failed = 1;
+   const double elapsed = bench_now() - start;
+   int_vector_index_clear(&index);
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_crc32c: Mter crc32c ver vektorns element, som jmfrelse. En operation motsvarar ett
+*               element.
+**************************************************************************************************/
+static double bench_crc32c(struct bench_context* context,
+                           const size_t size,
+                           size_t* ops)
+{
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   bench_sink = crc32c(0, context->input.data, sizeof(int) * size);
+   const double elapsed = bench_now() - start;
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_checksum_full: Mter int_vector_checksum utan sprning av ndringar, dvs. berkning av
+*                      samtliga block. En operation motsvarar ett element.
+**************************************************************************************************/
+static double bench_checksum_full(struct bench_context* context,
+                                  const size_t size,
+                                  size_t* ops)
+{
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+   bench_sink = int_vector_checksum(&context->input);
+   const double elapsed = bench_now() - start;
+   *ops = size;
+   return elapsed;
+}
+
+/**************************************************************************************************
+* bench_checksum_update: Mter int_vector_checksum med sprning av ndringar, dr ett element
+*                        ndras via int_vector_mark_dirty fre varje berkning, s att enbart
+*                        ett block berknas om.
+**************************************************************************************************/
+static double bench_checksum_update(struct bench_context* context,
+                                    const size_t size,
+                                    size_t* ops)
+{
+   struct int_vector v;
+   uint32_t checksum = 0;
+   int_vector_init_with_allocator(&v, &context->counter.allocator);
+   if (int_vector_clone(&v, &context->input) || int_vector_track(&v)) context->failed = 1;
+   int_vector_checksum(&v);
+   bench_counter_reset(&context->counter);
+   const double start = bench_now();
+
+   for (size_t i = 0; size && i < BENCH_LOOKUPS; ++i)
+   {
+      const size_t index = (i * 7919) % size;
+      v.data[index]++;
+      int_vector_mark_dirty(&v, index, 1);
+      checksum = int_vector_checksum(&v);
+   }
+
+   const double elapsed = bench_now() - start;
+   bench_sink = checksum;
+   int_vector_clear(&v);
+   *ops = BENCH_LOOKUPS;
+   return elapsed;
+}
+
+/* Samtliga mtningar i den ordning de krs. */
+static const struct bench_case bench_cases[] =
+{
+   { "push", bench_push },
+   { "pop", bench_pop },
+   { "resize", bench_resize },
+   { "iterate", bench_iterate },
+   { "sum", bench_sum },
+   { "push_huge", bench_push_huge },
+   { "sum_huge", bench_sum_huge },
+   { "sum_parallel", bench_sum_parallel },
+   { "fill", bench_fill },
+   { "fill_parallel", bench_fill_parallel },
+   { "print", bench_print },
+   { "parse", bench_parse },
+   { "parse_fscanf", bench_parse_fscanf },
+   { "sort", bench_sort },
+   { "sort_parallel", bench_sort_parallel },
+   { "sort_qsort", bench_sort_qsort },
+   { "churn", bench_churn },
+   { "clone", bench_clone },
+   { "share", bench_share },
+   { "share_write", bench_share_write },
+   { "ring", bench_ring },
+   { "ring_batch", bench_ring_batch },
+   { "concurrent_push", bench_concurrent_push },
+   { "compress_encode", bench_compress_encode },
+   { "compress_decode", bench_compress_decode },
+   { "compress_decode_scalar", bench_compress_decode_scalar },
+   { "compress_decode_step", bench_compress_decode_step },
+   { "set_union", bench_set_union },
+   { "set_intersection", bench_set_intersection },
+   { "set_intersection_gallop", bench_set_intersection_gallop },
+   { "set_difference", bench_set_difference },
+   { "contains_scan", bench_contains_scan },
+   { "contains_sorted", bench_contains_sorted },
+   { "contains_index", bench_contains_index },
+   { "index_build", bench_index_build },
+   { "crc32c", bench_crc32c },
+   { "checksum_full", bench_checksum_full },
+   { "checksum_update", bench_checksum_update }
+};
+
+/**************************************************************************************************
+* bench_run: Kr angiven mtning fr angiven vektorstorlek s mnga gnger att ungefr angivet
+*            antal element bearbetas, dock minst en gng, och returnerar resultatet.
+*
+*            - context: Pekare till mtningarnas gemensamma tillstnd.
+*            - bench  : Pekare till mtningen som ska kras.
+*            - size   : Vektorns storlek.
+*            - target : Ungefrligt antal element som ska bearbetas.
+**************************************************************************************************/
+static struct bench_result bench_run(struct bench_context* context,
+                                     const struct bench_case* bench,
+                                     const size_t size,
+                                     const size_t target)
+{
+   struct bench_result result;
+   const size_t repetitions = size && target / size ? target / size : 1;
+   double elapsed = 0;
+   size_t ops = 0, allocations = 0;
+   context->ratio = 0;
+
+   for (size_t i = 0; i < repetitions; ++i)
+   {
+      size_t run_ops = 0;
+      elapsed += bench->run(context, size, &run_ops);
+      allocations += context->counter.allocations + context->counter.reallocations;
+      ops += run_ops;
+   }
+
+   result.name = bench->name;
+   result.size = size;
+   result.repetitions = repetitions;
+   result.ns_per_op = ops ? elapsed / (double)ops : 0;
+   result.gb_per_s = elapsed > 0 ? (double)(sizeof(int) * ops) / elapsed : 0;
+   result.allocs_per_op = ops ? (double)allocations / (double)ops : 0;
+   result.peak_rss_kb = bench_peak_rss_kb();
+   result.ratio = context->ratio;
+   return result;
+}
+
+/**************************************************************************************************
+* bench_write_header: Skriver ut rubriker i angivet format.
+*
+*                     - ostream: Pekare till angiven utstrm.
+*                     - format : Utskriftsformatet.
+**************************************************************************************************/
+static void bench_write_header(FILE* ostream,
+                               const enum bench_format format)
+{
+   if (format == BENCH_FORMAT_TABLE)
+   {
+      fprintf(ostream, "%-22s %12s %8s %12s %10s %14s %12s %8s\n", "benchmark", "size", "reps",
+              "ns/op", "GB/s", "allocs/op", "peak_rss_kb", "ratio");
+   }
+   else if (format == BENCH_FORMAT_CSV)
+   {
+      fprintf(ostream, "label,benchmark,size,repetitions,ns_per_op,gb_per_s,allocs_per_op,"
+              "peak_rss_kb,ratio\n");
+   }
+   else
+   {
+      fprintf(ostream, "[\n");
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* bench_write_result: Skriver ut ett resultat i angivet format.
+*
+*                     - ostream: Pekare till angiven utstrm.
+*                     - format : Utskriftsformatet.
+*                     - label  : Etikett fr krningen.
+*                     - result : Pekare till resultatet som ska skrivas ut.
+*                     - first  : Indikerar ifall resultatet r det frsta som skrivs ut.
+**************************************************************************************************/
+static void bench_write_result(FILE* ostream,
+                               const enum bench_format format,
+                               const char* label,
+                               const struct bench_result* result,
+                               const int first)
+{
+   if (format == BENCH_FORMAT_TABLE)
+   {
+      fprintf(ostream, "%-22s %12zu %8zu %12.3f %10.3f %14.6f %12ld %8.2f\n", result->name,
+              result->size, result->repetitions, result->ns_per_op, result->gb_per_s,
+              result->allocs_per_op, result->peak_rss_kb, result->ratio);
+   }
+   else if (format == BENCH_FORMAT_CSV)
+   {
+      fprintf(ostream, "%s,%s,%zu,%zu,%.3f,%.3f,%.6f,%ld,%.3f\n", label, result->name,
+              result->size, result->repetitions, result->ns_per_op, result->gb_per_s,
+              result->allocs_per_op, result->peak_rss_kb, result->ratio);
+   }
+   else
+   {
+      fprintf(ostream, "%s  {\"label\": \"%s\", \"benchmark\": \"%s\", \"size\": %zu, "
+              "\"repetitions\": %zu, \"ns_per_op\": %.3f, \"gb_per_s\": %.3f, "
+              "\"allocs_per_op\": %.6f, \"peak_rss_kb\": %ld, \"ratio\": %.3f}",
+              first ? "" : ",\n", label, result->name, result->size, result->repetitions,
+              result->ns_per_op, result->gb_per_s, result->allocs_per_op, result->peak_rss_kb,
+              result->ratio);
+   }
+
+   fflush(ostream);
+   return;
+}
+
+/**************************************************************************************************
+* bench_write_footer: Avslutar utskriften i angivet format.
+*
+*                     - ostream: Pekare till angiven utstrm.
+*                     - format : Utskriftsformatet.
+**************************************************************************************************/
+static void bench_write_footer(FILE* ostream,
+                               const enum bench_format format)
+{
+   if (format == BENCH_FORMAT_JSON) fprintf(ostream, "\n]\n");
+   return;
+}
+
+/**************************************************************************************************
+* bench_parse_sizes: Tolkar kommaseparerade vektorstorlekar. Antalet tolkade storlekar
+*                    returneras, eller 0 vid felaktig inmatning.
+*
+*                    - text : Texten som ska tolkas.
+*                    - sizes: Flt som tilldelas de tolkade storlekarna.
+**************************************************************************************************/
+static size_t bench_parse_sizes(const char* text,
+                                size_t* sizes)
+{
+   size_t count = 0;
+
+   while (*text && count < BENCH_MAX_SIZES)
+   {
+      char* end;
+      const unsigned long long size = strtoull(text, &end, 10);
+      if (end == text || (*end && *end != ',')) return 0;
+      sizes[count++] = (size_t)size;
+      text = *end ? end + 1 : end;
+   }
+
+   return count;
+}
+
+/**************************************************************************************************
+* main: Tolkar programmets argument, kr samtliga valda mtningar fr varje vektorstorlek och
+*       skriver ut resultaten. Vid felaktiga argument eller misslyckad allokering avslutas
+*       programmet med felkod 1.
+**************************************************************************************************/
+int main(const int argc,
+         char** argv)
+{
+   struct bench_context context;
+   size_t sizes[BENCH_MAX_SIZES];
+   size_t size_count = bench_parse_sizes(BENCH_DEFAULT_SIZES, sizes);
+   size_t target = BENCH_DEFAULT_TARGET;
+   enum bench_format format = BENCH_FORMAT_TABLE;
+   const char* label = "";
+   const char* filter = 0;
+   FILE* ostream = stdout;
+   int first = 1;
+
+   for (int i = 1; i < argc; ++i)
+   {
+      if (!strncmp(argv[i], "--sizes=", 8))
+      {
+         size_count = bench_parse_sizes(argv[i] + 8, sizes);
+         if (!size_count) return 1;
+      }
+      else if (!strncmp(argv[i], "--target=", 9))
+      {
+         target = (size_t)strtoull(argv[i] + 9, 0, 10);
+      }
+      else if (!strcmp(argv[i], "--format=table")) format = BENCH_FORMAT_TABLE;
+      else if (!strcmp(argv[i], "--format=csv")) format = BENCH_FORMAT_CSV;
+      else if (!strcmp(argv[i], "--format=json")) format = BENCH_FORMAT_JSON;
+      else if (!strncmp(argv[i], "--label=", 8)) label = argv[i] + 8;
+      else if (!strncmp(argv[i], "--filter=", 9)) filter = argv[i] + 9;
+      else if (!strncmp(argv[i], "--output=", 9))
+      {
+         ostream = fopen(argv[i] + 9, "w");
+         if (!ostream) return 1;
+      }
+      else
+      {
+         fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+         return 1;
+      }
+   }
+
+   bench_counter_init(&context.counter);
+   int_vector_init(&context.input);
+   context.failed = 0;
+   context.null_stream = fopen("/dev/null", "w");
+   if (!context.null_stream) return 1;
+   bench_write_header(ostream, format);
+
+   for (size_t i = 0; i < size_count; ++i)
+   {
+      context.text_stream = tmpfile();
+      if (!context.text_stream || bench_random_fill(&context.input, sizes[i])) return 1;
+      int_vector_print(&context.input, context.text_stream);
+
+      for (size_t j = 0; j < sizeof(bench_cases) / sizeof(bench_cases[0]); ++j)
+      {
+         if (filter && !strstr(bench_cases[j].name, filter)) continue;
+         const struct bench_result result = bench_run(&context, &bench_cases[j], sizes[i], target);
+         bench_write_result(ostream, format, label, &result, first);
+         first = 0;
+      }
+
+      fclose(context.text_stream);
+   }
+
+   bench_write_footer(ostream, format);
+   int_vector_clear(&context.input);
+#ifdef VECTOR_STATS
+   vector_stats_dump(0, stderr);
+#endif
+   fclose(context.null_stream);
+   if (ostream != stdout) fclose(ostream);
+   return context.failed;
+}
\ No newline at end of file
@@ -0,0 +1,657 @@
+/**************************************************************************************************
+* int_vector_compressed.c: Innehller definitioner av associerade funktioner fr strukten
+*                          int_vector_compressed, implementerade skalrt samt via SSE2.
+**************************************************************************************************/
+#include "int_vector_compressed.h"
+#include "int_vector_simd.h"
+
+/**************************************************************************************************
+* INT_VECTOR_COMPRESSED_X86: Definieras ifall SSE2-versionerna kan kompileras, se
+*                            INT_VECTOR_SIMD_X86 i "int_vector_simd.c".
+*
+* INT_VECTOR_COMPRESSED_LANES: Antalet lanes som elementen packas i.
+*
+* INT_VECTOR_COMPRESSED_ROWS: Antalet element per lane i ett block.
+**************************************************************************************************/
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define INT_VECTOR_COMPRESSED_X86
+#include <immintrin.h>
+#endif
+
+#define INT_VECTOR_COMPRESSED_LANES 4
+#define INT_VECTOR_COMPRESSED_ROWS (INT_VECTOR_COMPRESSED_BLOCK_SIZE / INT_VECTOR_COMPRESSED_LANES)
+
+/* Statiska funktioner: */
+static int int_vector_compressed_use_sse2(void);
+static unsigned int int_vector_compressed_width(const struct int_vector_compressed* self,
+                                                const size_t block);
+static unsigned int int_vector_compressed_encode_block(const int* src,
+                                                       const size_t count,
+                                                       struct int_vector_compressed_block* header,
+                                                       uint32_t* words);
+static void int_vector_compressed_decode_full(const struct int_vector_compressed* self,
+                                              const size_t block,
+                                              int* dest);
+static void int_array_zigzag_delta_scalar(const int* src, const size_t count, uint32_t* dest);
+static uint32_t uint_array_reduce_scalar(uint32_t* data, uint32_t* reference);
+static void uint_array_pack_scalar(const uint32_t* src, const unsigned int width, uint32_t* dest);
+static void uint_array_unpack_scalar(const uint32_t* src, const unsigned int width,
+                                     const uint32_t reference, const uint32_t base, int* dest);
+
+#ifdef INT_VECTOR_COMPRESSED_X86
+static void int_array_zigzag_delta_sse2(const int* src, uint32_t* dest);
+static uint32_t uint_array_reduce_sse2(uint32_t* data, uint32_t* reference);
+static void uint_array_pack_sse2(const uint32_t* src, const unsigned int width, uint32_t* dest);
+static void uint_array_unpack_sse2(const uint32_t* src, const unsigned int width,
+                                   const uint32_t reference, const uint32_t base, int* dest);
+#endif
+
+/**************************************************************************************************
+* int_vector_compressed_init: Initierar ny tom komprimerad vektor.
+*
+*                             - self: Pekare till vektorn som ska initieras.
+**************************************************************************************************/
+void int_vector_compressed_init(struct int_vector_compressed* self)
+{
+   int_vector_compressed_init_with_allocator(self, 0);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_init_with_allocator: Initierar ny tom komprimerad vektor, vars minne
+*                                            allokeras via angiven allokator.
+*
+*                                            - self     : Pekare till vektorn som ska initieras.
+*                                            - allocator: Pekare till allokatorn (null = malloc).
+**************************************************************************************************/
+void int_vector_compressed_init_with_allocator(struct int_vector_compressed* self,
+                                               const struct allocator* allocator)
+{
+   self->blocks = 0;
+   self->words = 0;
+   self->size = 0;
+   self->block_count = 0;
+   self->word_count = 0;
+   self->allocator = allocator;
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_clear: Frigr minnet som har allokerats fr angiven komprimerad vektor.
+*
+*                              - self: Pekare till vektorn som ska tmmas.
+**************************************************************************************************/
+void int_vector_compressed_clear(struct int_vector_compressed* self)
+{
+   if (self->blocks)
+   {
+      allocator_deallocate(self->allocator, self->blocks,
+                           sizeof(struct int_vector_compressed_block) * (self->block_count + 1));
+   }
+
+   if (self->words)
+   {
+      allocator_deallocate(self->allocator, self->words, sizeof(uint32_t) * self->word_count);
+   }
+
+   int_vector_compressed_init_with_allocator(self, self->allocator);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_encode: Komprimerar angivet antal heltal frn angivet flt till angiven
+*                               komprimerad vektor, vars tidigare innehll erstts. Vid lyckad
+*                               komprimering returneras 0, annars returneras felkod 1, varvid
+*                               vektorn lmnas tom.
+*
+*                               Det packade fltet allokeras frst fr vrsta fallet (32 bitar
+*                               per element) och krymps sedan till anvnd storlek.
+*
+*                               - self: Pekare till vektorn som ska tilldelas de komprimerade
+*                                       heltalen.
+*                               - src : Pekare till fltet med heltalen som ska komprimeras.
+*                               - size: Antalet heltal som ska komprimeras.
+**************************************************************************************************/
+int int_vector_compressed_encode(struct int_vector_compressed* self,
+                                 const int* src,
+                                 const size_t size)
+{
+   const size_t block_count = (size + INT_VECTOR_COMPRESSED_BLOCK_SIZE - 1) /
+                              INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+   uint64_t offset = 0;
+
+   int_vector_compressed_clear(self);
+   if (!size) return 0;
+   if (block_count > SIZE_MAX / sizeof(uint32_t) / INT_VECTOR_COMPRESSED_BLOCK_SIZE) return 1;
+
+   self->blocks = (struct int_vector_compressed_block*)allocator_allocate(self->allocator,
+      sizeof(struct int_vector_compressed_block) * (block_count + 1));
+   self->words = (uint32_t*)allocator_allocate(self->allocator,
+      sizeof(uint32_t) * INT_VECTOR_COMPRESSED_BLOCK_SIZE * block_count);
+   self->block_count = block_count;
+   self->word_count = INT_VECTOR_COMPRESSED_BLOCK_SIZE * block_count;
+
+   if (!self->blocks || !self->words)
+   {
+      if (!self->blocks) self->block_count = 0;
+      int_vector_compressed_clear(self);
+      return 1;
+   }
+
+   for (size_t i = 0; i < block_count; ++i)
+   {
+      const size_t first = i * INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+      const size_t count = size - first < INT_VECTOR_COMPRESSED_BLOCK_SIZE ?
+                           size - first : INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+      self->blocks[i].offset = offset;
+      offset += INT_VECTOR_COMPRESSED_LANES *
+                int_vector_compressed_encode_block(src + first, count, &self->blocks[i],
+                                                   self->words + offset);
+   }
+
+   self->blocks[block_count].offset = offset;
+   self->blocks[block_count].base = 0;
+   self->blocks[block_count].reference = 0;
+   self->size = size;
+
+   if (!offset)
+   {
+      allocator_deallocate(self->allocator, self->words, sizeof(uint32_t) * self->word_count);
+      self->words = 0;
+      self->word_count = 0;
+   }
+   else if (offset < self->word_count)
+   {
+      uint32_t* words = (uint32_t*)allocator_reallocate(self->allocator, self->words,
+                                                        sizeof(uint32_t) * self->word_count,
+                                                        sizeof(uint32_t) * (size_t)offset);
+      if (words)
+      {
+         self->words = words;
+         self->word_count = (size_t)offset;
+      }
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_encode_vector: Komprimerar innehllet i angiven vektor till angiven
+*                                      komprimerad vektor, se int_vector_compressed_encode.
+*
+*                                      - self: Pekare till den komprimerade vektorn.
+*                                      - src : Pekare till vektorn som ska komprimeras.
+**************************************************************************************************/
+int int_vector_compressed_encode_vector(struct int_vector_compressed* self,
+                                        const struct int_vector* src)
+{
+   return int_vector_compressed_encode(self, src->data, src->size);
+}
+
+/**************************************************************************************************
+* int_vector_compressed_decode_block: Packar upp angivet block till angivet flt, som mste rymma
+*                                     INT_VECTOR_COMPRESSED_BLOCK_SIZE element. Antalet uppackade
+*                                     element returneras, vilket kan vara frre fr det sista
+*                                     blocket, eller 0 om blocket inte finns.
+*
+*                                     - self : Pekare till den komprimerade vektorn.
+*                                     - block: Blockets index.
+*                                     - dest : Pekare till fltet som ska tilldelas elementen.
+**************************************************************************************************/
+size_t int_vector_compressed_decode_block(const struct int_vector_compressed* self,
+                                          const size_t block,
+                                          int* dest)
+{
+   if (block >= self->block_count) return 0;
+   int_vector_compressed_decode_full(self, block, dest);
+   const size_t first = block * INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+   return self->size - first < INT_VECTOR_COMPRESSED_BLOCK_SIZE ?
+          self->size - first : INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_decode: Packar upp samtliga element i angiven komprimerad vektor till
+*                               angiven vektor, vars tidigare innehll erstts. Hgst en
+*                               omallokering genomfrs. Vid lyckad uppackning returneras 0,
+*                               annars returneras felkod 1.
+*
+*                               - self: Pekare till den komprimerade vektorn.
+*                               - dest: Pekare till vektorn som ska tilldelas elementen.
+**************************************************************************************************/
+int int_vector_compressed_decode(const struct int_vector_compressed* self,
+                                 struct int_vector* dest)
+{
+   const size_t full_blocks = self->size / INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+   if (dest->capacity < self->size || dest->shared) int_vector_reset(dest);
+   if (int_vector_resize(dest, self->size)) return 1;
+
+   for (size_t i = 0; i < full_blocks; ++i)
+   {
+      int_vector_compressed_decode_full(self, i, dest->data + i * INT_VECTOR_COMPRESSED_BLOCK_SIZE);
+   }
+
+   if (full_blocks < self->block_count)
+   {
+      int temp[INT_VECTOR_COMPRESSED_BLOCK_SIZE];
+      const size_t first = full_blocks * INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+      int_vector_compressed_decode_full(self, full_blocks, temp);
+      memcpy(dest->data + first, temp, sizeof(int) * (self->size - first));
+   }
+
+   int_vector_mark_dirty(dest, 0, self->size);
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_at: Tilldelar elementet p angivet index till angiven variabel. Enbart
+*                           blocket som innehller elementet packas upp. Ifall index finns
+*                           returneras 0, annars returneras felkod 1.
+*
+*                           - self : Pekare till den komprimerade vektorn.
+*                           - index: Elementets index.
+*                           - value: Pekare till variabeln som ska tilldelas elementet.
+**************************************************************************************************/
+int int_vector_compressed_at(const struct int_vector_compressed* self,
+                             const size_t index,
+                             int* value)
+{
+   int temp[INT_VECTOR_COMPRESSED_BLOCK_SIZE];
+   if (index >= self->size) return 1;
+   int_vector_compressed_decode_full(self, index / INT_VECTOR_COMPRESSED_BLOCK_SIZE, temp);
+   *value = temp[index % INT_VECTOR_COMPRESSED_BLOCK_SIZE];
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_bytes: Returnerar antalet byte som upptas av blockhuvuden samt packade
+*                              differenser i angiven komprimerad vektor.
+*
+*                              - self: Pekare till den komprimerade vektorn.
+**************************************************************************************************/
+size_t int_vector_compressed_bytes(const struct int_vector_compressed* self)
+{
+   if (!self->block_count) return 0;
+   return sizeof(struct int_vector_compressed_block) * self->block_count +
+          sizeof(uint32_t) * (size_t)self->blocks[self->block_count].offset;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_ratio: Returnerar kompressionsgraden fr angiven komprimerad vektor, dvs.
+*                              okomprimerad storlek dividerat med komprimerad storlek.
+*
+*                              - self: Pekare till den komprimerade vektorn.
+**************************************************************************************************/
+double int_vector_compressed_ratio(const struct int_vector_compressed* self)
+{
+   const size_t bytes = int_vector_compressed_bytes(self);
+   return bytes ? (double)(sizeof(int) * self->size) / (double)bytes : 0;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_use_sse2: Indikerar ifall SSE2-versionerna ska anvndas, vilket fljer
+*                                 valet av instruktionsuppsttning i int_vector_simd.
+**************************************************************************************************/
+static int int_vector_compressed_use_sse2(void)
+{
+#ifdef INT_VECTOR_COMPRESSED_X86
+   return int_vector_simd_current() >= INT_VECTOR_SIMD_SSE2;
+#else
+   return 0;
+#endif
+}
+
+/**************************************************************************************************
+* int_vector_compressed_width: Returnerar antalet bitar per element i angivet block.
+*
+*                              - self : Pekare till den komprimerade vektorn.
+*                              - block: Blockets index.
+**************************************************************************************************/
+static unsigned int int_vector_compressed_width(const struct int_vector_compressed* self,
+                                                const size_t block)
+{
+   return (unsigned int)((self->blocks[block + 1].offset - self->blocks[block].offset) /
+                         INT_VECTOR_COMPRESSED_LANES);
+}
+
+/**************************************************************************************************
+* int_vector_compressed_encode_block: Komprimerar ett block om hgst
+*                                     INT_VECTOR_COMPRESSED_BLOCK_SIZE heltal. Blockhuvudets
+*                                     startvrde och minsta differens tilldelas och antalet
+*                                     bitar per element returneras.
+*
+*                                     Det frsta elementets differens samt utfyllnaden efter
+*                                     ett ofullstndigt block stts till en differens som redan
+*                                     finns i blocket, s att de inte pverkar antalet bitar.
+*                                     Det frsta elementets differens stts sedan till den
+*                                     minsta differensen och startvrdet vljs drefter.
+*
+*                                     - src   : Pekare till blockets frsta heltal.
+*                                     - count : Antalet heltal i blocket.
+*                                     - header: Pekare till blockets huvud.
+*                                     - words : Pekare till blockets plats i det packade fltet.
+**************************************************************************************************/
+static unsigned int int_vector_compressed_encode_block(const int* src,
+                                                       const size_t count,
+                                                       struct int_vector_compressed_block* header,
+                                                       uint32_t* words)
+{
+   uint32_t deltas[INT_VECTOR_COMPRESSED_BLOCK_SIZE];
+   uint32_t reference, bits;
+   unsigned int width = 0;
+   const int sse2 = int_vector_compressed_use_sse2();
+
+#ifdef INT_VECTOR_COMPRESSED_X86
+   if (sse2 && count == INT_VECTOR_COMPRESSED_BLOCK_SIZE) int_array_zigzag_delta_sse2(src, deltas);
+   else int_array_zigzag_delta_scalar(src, count, deltas);
+#else
+   int_array_zigzag_delta_scalar(src, count, deltas);
+#endif
+
+   deltas[0] = count > 1 ? deltas[1] : 0;
+
+   for (size_t i = count; i < INT_VECTOR_COMPRESSED_BLOCK_SIZE; ++i)
+   {
+      deltas[i] = deltas[0];
+   }
+
+#ifdef INT_VECTOR_COMPRESSED_X86
+   bits = sse2 ? uint_array_reduce_sse2(deltas, &reference)
+               : uint_array_reduce_scalar(deltas, &reference);
+#else
+   bits = uint_array_reduce_scalar(deltas, &reference);
+#endif
+
+   deltas[0] = 0;
+   header->reference = reference;
+   header->base = (int32_t)((uint32_t)src[0] - ((reference >> 1) ^ (0u - (reference & 1))));
+
+   while (bits)
+   {
+      width++;
+      bits >>= 1;
+   }
+
+   if (!width) return 0;
+
+#ifdef INT_VECTOR_COMPRESSED_X86
+   if (sse2) uint_array_pack_sse2(deltas, width, words);
+   else uint_array_pack_scalar(deltas, width, words);
+#else
+   uint_array_pack_scalar(deltas, width, words);
+#endif
+   return width;
+}
+
+/**************************************************************************************************
+* int_vector_compressed_decode_full: Packar upp samtliga INT_VECTOR_COMPRESSED_BLOCK_SIZE element
+*                                    i angivet block, inklusive eventuell utfyllnad.
+*
+*                                    - self : Pekare till den komprimerade vektorn.
+*                                    - block: Blockets index.
+*                                    - dest : Pekare till fltet som ska tilldelas elementen.
+**************************************************************************************************/
+static void int_vector_compressed_decode_full(const struct int_vector_compressed* self,
+                                              const size_t block,
+                                              int* dest)
+{
+   const struct int_vector_compressed_block* header = &self->blocks[block];
+   const uint32_t* words = self->words + header->offset;
+   const unsigned int width = int_vector_compressed_width(self, block);
+
+#ifdef INT_VECTOR_COMPRESSED_X86
+   if (int_vector_compressed_use_sse2())
+   {
+      uint_array_unpack_sse2(words, width, header->reference, (uint32_t)header->base, dest);
+      return;
+   }
+#endif
+   uint_array_unpack_scalar(words, width, header->reference, (uint32_t)header->base, dest);
+   return;
+}
+
+/**************************************************************************************************
+* Skalra versioner: Bearbetar ett element i taget, men i samma ordning och med samma format som
+*                    SSE2-versionerna, dvs. fyra lanes dr element i tillhr lane i % 4. All
+*                    aritmetik sker osignerat fr att erhlla tvkomplementsomslag.
+**************************************************************************************************/
+static void int_array_zigzag_delta_scalar(const int* src, const size_t count, uint32_t* dest)
+{
+   for (size_t i = 1; i < count; ++i)
+   {
+      const uint32_t delta = (uint32_t)src[i] - (uint32_t)src[i - 1];
+      dest[i] = (delta << 1) ^ (0u - (delta >> 31));
+   }
+
+   return;
+}
+
+static uint32_t uint_array_reduce_scalar(uint32_t* data, uint32_t* reference)
+{
+   uint32_t min = data[0], bits = 0;
+
+   for (size_t i = 1; i < INT_VECTOR_COMPRESSED_BLOCK_SIZE; ++i)
+   {
+      if (data[i] < min) min = data[i];
+   }
+
+   for (size_t i = 0; i < INT_VECTOR_COMPRESSED_BLOCK_SIZE; ++i)
+   {
+      data[i] -= min;
+      bits |= data[i];
+   }
+
+   *reference = min;
+   return bits;
+}
+
+static void uint_array_pack_scalar(const uint32_t* src, const unsigned int width, uint32_t* dest)
+{
+   uint32_t acc[INT_VECTOR_COMPRESSED_LANES] = { 0 };
+   unsigned int shift = 0;
+
+   for (size_t row = 0; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      const uint32_t* value = src + row * INT_VECTOR_COMPRESSED_LANES;
+
+      for (size_t lane = 0; lane < INT_VECTOR_COMPRESSED_LANES; ++lane)
+      {
+         acc[lane] |= value[lane] << shift;
+      }
+
+      shift += width;
+
+      if (shift >= 32)
+      {
+         shift -= 32;
+
+         for (size_t lane = 0; lane < INT_VECTOR_COMPRESSED_LANES; ++lane)
+         {
+            dest[lane] = acc[lane];
+            acc[lane] = shift ? value[lane] >> (width - shift) : 0;
+         }
+
+         dest += INT_VECTOR_COMPRESSED_LANES;
+      }
+   }
+
+   return;
+}
+
+static void uint_array_unpack_scalar(const uint32_t* src, const unsigned int width,
+                                     const uint32_t reference, const uint32_t base, int* dest)
+{
+   const uint32_t mask = width < 32 ? (1u << width) - 1 : 0xFFFFFFFFu;
+   uint32_t sum = base;
+   unsigned int shift = 0;
+
+   for (size_t row = 0; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      for (size_t lane = 0; lane < INT_VECTOR_COMPRESSED_LANES; ++lane)
+      {
+         uint32_t value = 0;
+
+         if (width)
+         {
+            value = src[lane] >> shift;
+            if (shift + width > 32)
+            {
+               value |= src[INT_VECTOR_COMPRESSED_LANES + lane] << (32 - shift);
+            }
+
+            value &= mask;
+         }
+
+         value += reference;
+         sum += (value >> 1) ^ (0u - (value & 1));
+         dest[row * INT_VECTOR_COMPRESSED_LANES + lane] = (int)sum;
+      }
+
+      shift += width;
+
+      if (shift >= 32)
+      {
+         shift -= 32;
+         src += INT_VECTOR_COMPRESSED_LANES;
+      }
+   }
+
+   return;
+}
+
+#ifdef INT_VECTOR_COMPRESSED_X86
+/**************************************************************************************************
+* SSE2-versioner: Bearbetar en rad, dvs. ett element per lane, per instruktion. Differenserna
+*                 summeras inom varje rad via tv skiftningar av hela registret, varefter
+*                 fregende rads sista vrde adderas till samtliga lanes. Minsta vrde berknas
+*                 osignerat genom att vnda teckenbiten fre signerad jmfrelse, eftersom SSE2
+*                 saknar osignerade min-instruktioner fr 32-bitars heltal.
+**************************************************************************************************/
+static void int_array_zigzag_delta_sse2(const int* src, uint32_t* dest)
+{
+   __m128i previous = _mm_set1_epi32(src[0]);
+
+   for (size_t row = 0; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(src + row * INT_VECTOR_COMPRESSED_LANES));
+      const __m128i shifted = _mm_or_si128(_mm_slli_si128(x, 4), _mm_srli_si128(previous, 12));
+      const __m128i delta = _mm_sub_epi32(x, shifted);
+      const __m128i zigzag = _mm_xor_si128(_mm_slli_epi32(delta, 1), _mm_srai_epi32(delta, 31));
+      _mm_storeu_si128((__m128i*)(dest + row * INT_VECTOR_COMPRESSED_LANES), zigzag);
+      previous = x;
+   }
+
+   return;
+}
+
+static uint32_t uint_array_reduce_sse2(uint32_t* data, uint32_t* reference)
+{
+   const __m128i sign = _mm_set1_epi32((int)0x80000000u);
+   __m128i min = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), sign);
+   __m128i bits = _mm_setzero_si128();
+
+   for (size_t row = 1; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      const __m128i x = _mm_xor_si128(
+         _mm_loadu_si128((const __m128i*)(data + row * INT_VECTOR_COMPRESSED_LANES)), sign);
+      const __m128i less = _mm_cmplt_epi32(x, min);
+      min = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, min));
+   }
+
+   {
+      const __m128i x = _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2));
+      const __m128i less = _mm_cmplt_epi32(x, min);
+      min = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, min));
+   }
+   {
+      const __m128i x = _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1));
+      const __m128i less = _mm_cmplt_epi32(x, min);
+      min = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, min));
+   }
+
+   min = _mm_xor_si128(min, sign);
+
+   for (size_t row = 0; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      __m128i* p = (__m128i*)(data + row * INT_VECTOR_COMPRESSED_LANES);
+      const __m128i x = _mm_sub_epi32(_mm_loadu_si128(p), min);
+      _mm_storeu_si128(p, x);
+      bits = _mm_or_si128(bits, x);
+   }
+
+   bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(1, 0, 3, 2)));
+   bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(2, 3, 0, 1)));
+   *reference = (uint32_t)_mm_cvtsi128_si32(min);
+   return (uint32_t)_mm_cvtsi128_si32(bits);
+}
+
+static void uint_array_pack_sse2(const uint32_t* src, const unsigned int width, uint32_t* dest)
+{
+   __m128i acc = _mm_setzero_si128();
+   unsigned int shift = 0;
+
+   for (size_t row = 0; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(src + row * INT_VECTOR_COMPRESSED_LANES));
+      acc = _mm_or_si128(acc, _mm_sll_epi32(x, _mm_cvtsi32_si128((int)shift)));
+      shift += width;
+
+      if (shift >= 32)
+      {
+         shift -= 32;
+         _mm_storeu_si128((__m128i*)dest, acc);
+         acc = shift ? _mm_srl_epi32(x, _mm_cvtsi32_si128((int)(width - shift)))
+                     : _mm_setzero_si128();
+         dest += INT_VECTOR_COMPRESSED_LANES;
+      }
+   }
+
+   return;
+}
+
+static void uint_array_unpack_sse2(const uint32_t* src, const unsigned int width,
+                                   const uint32_t reference, const uint32_t base, int* dest)
+{
+   const __m128i mask = _mm_set1_epi32((int)(width < 32 ? (1u << width) - 1 : 0xFFFFFFFFu));
+   const __m128i offset = _mm_set1_epi32((int)reference);
+   const __m128i one = _mm_set1_epi32(1);
+   __m128i sum = _mm_set1_epi32((int)base);
+   unsigned int shift = 0;
+
+   for (size_t row = 0; row < INT_VECTOR_COMPRESSED_ROWS; ++row)
+   {
+      __m128i x = _mm_setzero_si128();
+
+      if (width)
+      {
+         x = _mm_srl_epi32(_mm_loadu_si128((const __m128i*)src), _mm_cvtsi32_si128((int)shift));
+
+         if (shift + width > 32)
+         {
+            const __m128i next =
+               _mm_loadu_si128((const __m128i*)(src + INT_VECTOR_COMPRESSED_LANES));
+            x = _mm_or_si128(x, _mm_sll_epi32(next, _mm_cvtsi32_si128((int)(32 - shift))));
+         }
+
+         x = _mm_and_si128(x, mask);
+         shift += width;
+
+         if (shift >= 32)
+         {
+            shift -= 32;
+            src += INT_VECTOR_COMPRESSED_LANES;
+         }
+      }
+
+      x = _mm_add_epi32(x, offset);
+      x = _mm_xor_si128(_mm_srli_epi32(x, 1),
+                        _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(x, one)));
+      x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+      x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+      sum = _mm_add_epi32(x, _mm_shuffle_epi32(sum, _MM_SHUFFLE(3, 3, 3, 3)));
+      _mm_storeu_si128((__m128i*)(dest + row * INT_VECTOR_COMPRESSED_LANES), sum);
+   }
+
+   return;
+}
+#endif /* INT_VECTOR_COMPRESSED_X86 */
@@ -0,0 +1,170 @@
+/**************************************************************************************************
+* int_vector_compressed.h: Komprimerad lagring av heltal av datatypen int fr sekvenser med lg
+*                          entropi, exempelvis aritmetiska sekvenser (i * step) eller lngsamt
+*                          varierande vrden. Elementen delas in i block om
+*                          INT_VECTOR_COMPRESSED_BLOCK_SIZE element, som komprimeras var fr sig:
+*
+*                          1. Differensen (delta) mellan varje element och fregende berknas.
+*                          2. Differenserna zigzag-kodas, s att sm negativa tal blir sm
+*                             positiva tal (0, -1, 1, -2... blir 0, 1, 2, 3...).
+*                          3. Blockets minsta kodade differens dras ifrn samtliga differenser,
+*                             vilket medfr att en aritmetisk sekvens blir enbart nollor.
+*                          4. Resultatet bitpackas med s mnga bitar per element som krvs fr
+*                             blockets strsta vrde (0 - 32 bitar).
+*
+*                          Varje block har ett huvud med startvrde, minsta differens samt
+*                          position i det packade fltet, vilket mjliggr direkt tkomst till
+*                          godtyckligt block. Elementen packas i fyra lanes (element i hamnar i
+*                          lane i % 4), s att kodning och avkodning kan ske fyra element i
+*                          taget via SSE2. Vilken version som anvnds fljer int_vector_simd.
+*
+*                          Vektorn r avsedd fr data som skrivs en gng och lses mnga gnger.
+*                          Elementen lses block fr block via int_vector_compressed_decode_block
+*                          eller packas upp till en vanlig int_vector fr iteration.
+**************************************************************************************************/
+#ifndef INT_VECTOR_COMPRESSED_H_
+#define INT_VECTOR_COMPRESSED_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "int_vector.h"
+
+/**************************************************************************************************
+* INT_VECTOR_COMPRESSED_BLOCK_SIZE: Antalet element per block, dvs. 32 element per lane.
+**************************************************************************************************/
+#define INT_VECTOR_COMPRESSED_BLOCK_SIZE 128
+
+/**************************************************************************************************
+* int_vector_compressed_block: Huvud fr ett komprimerat block. Antalet bitar per element ges
+*                              av avstndet till nsta blocks position, eftersom ett block med
+*                              b bitar per element upptar exakt 4 * b ord i det packade fltet.
+*                              Efter det sista blocket finns ett extra huvud, vars position
+*                              anger antalet anvnda ord.
+**************************************************************************************************/
+struct int_vector_compressed_block
+{
+   uint64_t offset;    /* Blockets position i det packade fltet, rknat i 32-bitarsord. */
+   int32_t base;       /* Vrdet fre blockets frsta element. */
+   uint32_t reference; /* Blockets minsta zigzag-kodade differens. */
+};
+
+/**************************************************************************************************
+* int_vector_compressed: Komprimerad vektor innehllande blockhuvuden samt packade differenser.
+**************************************************************************************************/
+struct int_vector_compressed
+{
+   struct int_vector_compressed_block* blocks; /* Pekare till blockhuvudena. */
+   uint32_t* words;                            /* Pekare till det packade fltet. */
+   size_t size;                                /* Antalet element. */
+   size_t block_count;                         /* Antalet block. */
+   size_t word_count;                          /* Antalet allokerade 32-bitarsord. */
+   const struct allocator* allocator;          /* Allokator (null = standardallokatorn). */
+};
+
+/**************************************************************************************************
+* int_vector_compressed_init: Initierar ny tom komprimerad vektor.
+*
+*                             - self: Pekare till vektorn som ska initieras.
+**************************************************************************************************/
+void int_vector_compressed_init(struct int_vector_compressed* self);
+
+/**************************************************************************************************
+* int_vector_compressed_init_with_allocator: Initierar ny tom komprimerad vektor, vars minne
+*                                            allokeras via angiven allokator.
+*
+*                                            - self     : Pekare till vektorn som ska initieras.
+*                                            - allocator: Pekare till allokatorn (null = malloc).
+**************************************************************************************************/
+void int_vector_compressed_init_with_allocator(struct int_vector_compressed* self,
+                                               const struct allocator* allocator);
+
+/**************************************************************************************************
+* int_vector_compressed_clear: Frigr minnet som har allokerats fr angiven komprimerad vektor.
+*
+*                              - self: Pekare till vektorn som ska tmmas.
+**************************************************************************************************/
+void int_vector_compressed_clear(struct int_vector_compressed* self);
+
+/**************************************************************************************************
+* int_vector_compressed_encode: Komprimerar angivet antal heltal frn angivet flt till angiven
+*                               komprimerad vektor, vars tidigare innehll erstts. Vid lyckad
+*                               komprimering returneras 0, annars returneras felkod 1, varvid
+*                               vektorn lmnas tom.
+*
+*                               - self: Pekare till vektorn som ska tilldelas de komprimerade
+*                                       heltalen.
+*                               - src : Pekare till fltet med heltalen som ska komprimeras.
+*                               - size: Antalet heltal som ska komprimeras.
+**************************************************************************************************/
+int int_vector_compressed_encode(struct int_vector_compressed* self,
+                                 const int* src,
+                                 const size_t size);
+
+/**************************************************************************************************
+* int_vector_compressed_encode_vector: Komprimerar innehllet i angiven vektor till angiven
+*                                      komprimerad vektor, se int_vector_compressed_encode.
+*
+*                                      - self: Pekare till den komprimerade vektorn.
+*                                      - src : Pekare till vektorn som ska komprimeras.
+**************************************************************************************************/
+int int_vector_compressed_encode_vector(struct int_vector_compressed* self,
+                                        const struct int_vector* src);
+
+/**************************************************************************************************
+* int_vector_compressed_decode_block: Packar upp angivet block till angivet flt, som mste rymma
+*                                     INT_VECTOR_COMPRESSED_BLOCK_SIZE element. Antalet uppackade
+*                                     element returneras, vilket kan vara frre fr det sista
+*                                     blocket, eller 0 om blocket inte finns.
+*
+*                                     - self : Pekare till den komprimerade vektorn.
+*                                     - block: Blockets index.
+*                                     - dest : Pekare till fltet som ska tilldelas elementen.
+**************************************************************************************************/
+size_t int_vector_compressed_decode_block(const struct int_vector_compressed* self,
+                                          const size_t block,
+                                          int* dest);
+
+/**************************************************************************************************
+* int_vector_compressed_decode: Packar upp samtliga element i angiven komprimerad vektor till
+*                               angiven vektor, vars tidigare innehll erstts. Hgst en
+*                               omallokering genomfrs. Vid lyckad uppackning returneras 0,
+*                               annars returneras felkod 1.
+*
+*                               - self: Pekare till den komprimerade vektorn.
+*                               - dest: Pekare till vektorn som ska tilldelas elementen.
+**************************************************************************************************/
+int int_vector_compressed_decode(const struct int_vector_compressed* self,
+                                 struct int_vector* dest);
+
+/**************************************************************************************************
+* int_vector_compressed_at: Tilldelar elementet p angivet index till angiven variabel. Enbart
+*                           blocket som innehller elementet packas upp. Ifall index finns
+*                           returneras 0, annars returneras felkod 1.
+*
+*                           - self : Pekare till den komprimerade vektorn.
+*                           - index: Elementets index.
+*                           - value: Pekare till variabeln som ska tilldelas elementet.
+**************************************************************************************************/
+int int_vector_compressed_at(const struct int_vector_compressed* self,
+                             const size_t index,
+                             int* value);
+
+/**************************************************************************************************
+* int_vector_compressed_bytes: Returnerar antalet byte som upptas av blockhuvuden samt packade
+*                              differenser i angiven komprimerad vektor.
+*
+*                              - self: Pekare till den komprimerade vektorn.
+**************************************************************************************************/
+size_t int_vector_compressed_bytes(const struct int_vector_compressed* self);
+
+/**************************************************************************************************
+* int_vector_compressed_ratio: Returnerar kompressionsgraden fr angiven komprimerad vektor, dvs.
+*                              okomprimerad storlek dividerat med komprimerad storlek.
+*
+*                              - self: Pekare till den komprimerade vektorn.
+**************************************************************************************************/
+double int_vector_compressed_ratio(const struct int_vector_compressed* self);
+
+#endif /* INT_VECTOR_COMPRESSED_H_ */
@@ -0,0 +1,393 @@
+/**************************************************************************************************
+* int_vector_concurrent.c: Innehller definitioner av associerade funktioner fr strukten
+*                          int_vector_concurrent, som anvnds fr samtidig insttning av heltal
+*                          frn flera trdar, samt fr gonblicksbilder av sdana vektorer.
+**************************************************************************************************/
+#include "int_vector_concurrent.h"
+
+/* Statiska funktioner: */
+static size_t int_vector_concurrent_segment(const size_t index);
+static size_t int_vector_concurrent_segment_start(const size_t segment);
+static int* int_vector_concurrent_get_segment(struct int_vector_concurrent* self,
+                                              const size_t segment);
+static int int_vector_concurrent_reserve(struct int_vector_concurrent* self,
+                                         const size_t n,
+                                         size_t* first);
+static atomic_uchar* int_vector_concurrent_flags(int* data,
+                                                 const size_t segment);
+
+/**************************************************************************************************
+* int_vector_concurrent_init: Initierar ny tom vektor. Inget minne allokeras frrn det frsta
+*                             elementet lggs till.
+*
+*                             - self: Pekare till vektorn som ska initieras.
+**************************************************************************************************/
+void int_vector_concurrent_init(struct int_vector_concurrent* self)
+{
+   int_vector_concurrent_init_with_allocator(self, 0);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_init_with_allocator: Initierar ny tom vektor, vars segment allokeras via
+*                                            angiven allokator. Allokatorn mste vara trdsker.
+*
+*                                            - self     : Pekare till vektorn som ska initieras.
+*                                            - allocator: Pekare till allokatorn (null = malloc).
+**************************************************************************************************/
+void int_vector_concurrent_init_with_allocator(struct int_vector_concurrent* self,
+                                               const struct allocator* allocator)
+{
+   for (size_t i = 0; i < INT_VECTOR_CONCURRENT_SEGMENTS; ++i)
+   {
+      atomic_init(&self->segments[i], 0);
+   }
+
+   self->allocator = allocator;
+   atomic_init(&self->reserved, 0);
+   atomic_init(&self->committed, 0);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_clear: Frigr minnet som har allokerats fr angiven vektor. Fr enbart
+*                              anropas d ingen annan trd lngre anvnder vektorn.
+*
+*                              - self: Pekare till vektorn som ska tmmas.
+**************************************************************************************************/
+void int_vector_concurrent_clear(struct int_vector_concurrent* self)
+{
+   for (size_t i = 0; i < INT_VECTOR_CONCURRENT_SEGMENTS; ++i)
+   {
+      int* segment = atomic_load_explicit(&self->segments[i], memory_order_relaxed);
+
+      if (segment)
+      {
+         allocator_deallocate(self->allocator, segment,
+                              (sizeof(int) + 1) * ((size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << i));
+         atomic_store_explicit(&self->segments[i], 0, memory_order_relaxed);
+      }
+   }
+
+   atomic_store(&self->reserved, 0);
+   atomic_store(&self->committed, 0);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_push: Lgger till ett nytt element lngst bak i angiven vektor. Kan
+*                             anropas frn flera trdar samtidigt. Vid lyckad insttning
+*                             returneras 0, annars returneras felkod 1.
+*
+*                             - self       : Pekare till vektorn.
+*                             - new_element: Det nya element som ska lggas till.
+**************************************************************************************************/
+int int_vector_concurrent_push(struct int_vector_concurrent* self,
+                               const int new_element)
+{
+   return int_vector_concurrent_push_range(self, &new_element, 1);
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_push_range: Lgger till n element frn angivet flt lngst bak i angiven
+*                                   vektor. Platserna reserveras via en atomr operation, s att
+*                                   elementen hamnar i fljd ven om andra trdar lgger till
+*                                   element samtidigt. Vid lyckad insttning returneras 0,
+*                                   annars returneras felkod 1, varvid inga platser har
+*                                   reserverats och vektorn kan anvndas som tidigare.
+*
+*                                   Varje element markeras som skrivet via sin flagga direkt
+*                                   efter kopieringen, s att skrivare aldrig vntar p
+*                                   varandra.
+*
+*                                   - self: Pekare till vektorn.
+*                                   - src : Pekare till fltet med elementen som ska lggas till.
+*                                   - n   : Antalet element som ska lggas till.
+**************************************************************************************************/
+int int_vector_concurrent_push_range(struct int_vector_concurrent* self,
+                                     const int* src,
+                                     const size_t n)
+{
+   size_t index, remaining = n;
+   if (!n) return 0;
+   if (int_vector_concurrent_reserve(self, n, &index)) return 1;
+
+   while (remaining)
+   {
+      const size_t segment = int_vector_concurrent_segment(index);
+      int* data = atomic_load_explicit(&self->segments[segment], memory_order_acquire);
+      atomic_uchar* flags = int_vector_concurrent_flags(data, segment);
+      const size_t offset = index - int_vector_concurrent_segment_start(segment);
+      const size_t space = ((size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << segment) - offset;
+      const size_t count = remaining < space ? remaining : space;
+
+      memcpy(data + offset, src, sizeof(int) * count);
+
+      for (size_t i = offset; i < offset + count; ++i)
+      {
+         atomic_store_explicit(&flags[i], 1, memory_order_release);
+      }
+
+      src += count;
+      index += count;
+      remaining -= count;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_size: Returnerar antalet publicerade element i angiven vektor, dvs.
+*                             antalet element fram till det frsta som nnu inte r skrivet.
+*                             Flaggorna efter det senast publicerade elementet gs igenom och
+*                             committed flyttas fram frbi skrivna element, s att varje flagga
+*                             normalt enbart lses en gng.
+*
+*                             - self: Pekare till vektorn.
+**************************************************************************************************/
+size_t int_vector_concurrent_size(struct int_vector_concurrent* self)
+{
+   size_t committed = atomic_load_explicit(&self->committed, memory_order_acquire);
+   const size_t reserved = atomic_load_explicit(&self->reserved, memory_order_relaxed);
+   size_t index = committed;
+
+   while (index < reserved)
+   {
+      const size_t segment = int_vector_concurrent_segment(index);
+      int* data = segment < INT_VECTOR_CONCURRENT_SEGMENTS ?
+         atomic_load_explicit(&self->segments[segment], memory_order_acquire) : 0;
+      if (!data) break;
+
+      const atomic_uchar* flags = int_vector_concurrent_flags(data, segment);
+      const size_t start = int_vector_concurrent_segment_start(segment);
+      const size_t end = ((size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << segment) + start;
+      const size_t last = reserved < end ? reserved : end;
+
+      while (index < last && atomic_load_explicit(&flags[index - start], memory_order_acquire))
+      {
+         index++;
+      }
+
+      if (index < last) break;
+   }
+
+   while (committed < index &&
+          !atomic_compare_exchange_weak_explicit(&self->committed, &committed, index,
+                                                 memory_order_acq_rel, memory_order_acquire));
+   return committed > index ? committed : index;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_snapshot: Returnerar en gonblicksbild av angiven vektor, innehllande
+*                                 samtliga element som har publicerats hittills.
+*
+*                                 - self: Pekare till vektorn.
+**************************************************************************************************/
+struct int_vector_snapshot int_vector_concurrent_snapshot(struct int_vector_concurrent* self)
+{
+   struct int_vector_snapshot snapshot;
+   snapshot.vector = self;
+   snapshot.size = int_vector_concurrent_size(self);
+   return snapshot;
+}
+
+/**************************************************************************************************
+* int_vector_snapshot_at: Returnerar adressen till elementet p angivet index i angiven
+*                         gonblicksbild, eller null om index ligger utanfr gonblicksbilden.
+*
+*                         - self : Pekare till gonblicksbilden.
+*                         - index: Elementets index.
+**************************************************************************************************/
+const int* int_vector_snapshot_at(const struct int_vector_snapshot* self,
+                                  const size_t index)
+{
+   size_t length;
+   return int_vector_snapshot_span(self, index, &length);
+}
+
+/**************************************************************************************************
+* int_vector_snapshot_span: Returnerar adressen till elementet p angivet index i angiven
+*                           gonblicksbild och tilldelar antalet element som fljer direkt efter
+*                           varandra i minnet frn och med detta index, vilket mjliggr
+*                           iteration segment fr segment. Om index ligger utanfr
+*                           gonblicksbilden returneras null och length tilldelas 0.
+*
+*                           - self  : Pekare till gonblicksbilden.
+*                           - index : Index till det frsta elementet.
+*                           - length: Pekare till variabeln som tilldelas antalet element.
+**************************************************************************************************/
+const int* int_vector_snapshot_span(const struct int_vector_snapshot* self,
+                                    const size_t index,
+                                    size_t* length)
+{
+   if (index >= self->size)
+   {
+      *length = 0;
+      return 0;
+   }
+
+   const size_t segment = int_vector_concurrent_segment(index);
+   const size_t offset = index - int_vector_concurrent_segment_start(segment);
+   const size_t space = ((size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << segment) - offset;
+   const int* data = atomic_load_explicit(&self->vector->segments[segment], memory_order_acquire);
+
+   *length = self->size - index < space ? self->size - index : space;
+   return data + offset;
+}
+
+/**************************************************************************************************
+* int_vector_snapshot_flatten: Kopierar samtliga element i angiven gonblicksbild till angiven
+*                              vektor, vars tidigare innehll erstts. Hgst en omallokering
+*                              genomfrs och varje segment kopieras i ett block. Vid lyckad
+*                              kopiering returneras 0, annars returneras felkod 1.
+*
+*                              - self: Pekare till gonblicksbilden.
+*                              - dest: Pekare till vektorn som ska tilldelas elementen.
+**************************************************************************************************/
+int int_vector_snapshot_flatten(const struct int_vector_snapshot* self,
+                                struct int_vector* dest)
+{
+   size_t index = 0;
+   if (dest->capacity < self->size || dest->shared) int_vector_reset(dest);
+   if (int_vector_resize(dest, self->size)) return 1;
+
+   while (index < self->size)
+   {
+      size_t length;
+      const int* data = int_vector_snapshot_span(self, index, &length);
+      memcpy(dest->data + index, data, sizeof(int) * length);
+      index += length;
+   }
+
+   int_vector_mark_dirty(dest, 0, self->size);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_flatten: Kopierar samtliga publicerade element i angiven vektor till
+*                                angiven vektor av typen int_vector, se
+*                                int_vector_snapshot_flatten. Vid lyckad kopiering returneras 0,
+*                                annars returneras felkod 1.
+*
+*                                - self: Pekare till vektorn som ska plattas ut.
+*                                - dest: Pekare till vektorn som ska tilldelas elementen.
+**************************************************************************************************/
+int int_vector_concurrent_flatten(struct int_vector_concurrent* self,
+                                  struct int_vector* dest)
+{
+   const struct int_vector_snapshot snapshot = int_vector_concurrent_snapshot(self);
+   return int_vector_snapshot_flatten(&snapshot, dest);
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_segment: Returnerar numret p segmentet som innehller angivet index.
+*                                Segment k brjar p index FIRST_SIZE * (2^k - 1), vilket
+*                                medfr att numret ges av den hgsta satta biten i
+*                                index / FIRST_SIZE + 1.
+*
+*                                - index: Elementets index.
+**************************************************************************************************/
+static size_t int_vector_concurrent_segment(const size_t index)
+{
+   const size_t value = index / INT_VECTOR_CONCURRENT_FIRST_SIZE + 1;
+#ifdef __GNUC__
+   return sizeof(unsigned long long) * 8 - 1 - (size_t)__builtin_clzll(value);
+#else
+   size_t segment = 0;
+   while (value >> (segment + 1)) segment++;
+   return segment;
+#endif
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_segment_start: Returnerar index till det frsta elementet i angivet
+*                                      segment.
+*
+*                                      - segment: Segmentets nummer.
+**************************************************************************************************/
+static size_t int_vector_concurrent_segment_start(const size_t segment)
+{
+   return ((size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << segment) - INT_VECTOR_CONCURRENT_FIRST_SIZE;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_get_segment: Returnerar adressen till angivet segment, som allokeras
+*                                    ifall det saknas. Om flera trdar allokerar samma segment
+*                                    samtidigt behlls det segment som installerades frst via
+*                                    compare-and-swap, medan vriga frigrs. Vid misslyckad
+*                                    allokering returneras null.
+*
+*                                    - self   : Pekare till vektorn.
+*                                    - segment: Segmentets nummer.
+**************************************************************************************************/
+static int* int_vector_concurrent_get_segment(struct int_vector_concurrent* self,
+                                              const size_t segment)
+{
+   if (segment >= INT_VECTOR_CONCURRENT_SEGMENTS) return 0;
+   int* data = atomic_load_explicit(&self->segments[segment], memory_order_acquire);
+   if (data) return data;
+
+   const size_t count = (size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << segment;
+   const size_t size = (sizeof(int) + 1) * count;
+   int* expected = 0;
+   data = (int*)allocator_allocate(self->allocator, size);
+   if (!data) return 0;
+   memset(int_vector_concurrent_flags(data, segment), 0, count);
+
+   if (!atomic_compare_exchange_strong_explicit(&self->segments[segment], &expected, data,
+                                                memory_order_acq_rel, memory_order_acquire))
+   {
+      allocator_deallocate(self->allocator, data, size);
+      data = expected;
+   }
+
+   return data;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_reserve: Reserverar angivet antal platser i fljd via compare-and-swap
+*                                och tilldelar index till den frsta platsen. Segmenten som
+*                                tcker platserna allokeras innan de reserveras, s att en
+*                                misslyckad allokering aldrig lmnar reserverade platser som
+*                                inte kan skrivas, vilket annars skulle stoppa publiceringen av
+*                                samtliga senare element. Vid lyckad reservation returneras 0,
+*                                annars returneras felkod 1 utan att ngon plats reserveras.
+*
+*                                - self : Pekare till vektorn.
+*                                - n    : Antalet platser som ska reserveras (minst 1).
+*                                - first: Pekare till variabeln som tilldelas den frsta platsen.
+**************************************************************************************************/
+static int int_vector_concurrent_reserve(struct int_vector_concurrent* self,
+                                         const size_t n,
+                                         size_t* first)
+{
+   size_t index = atomic_load_explicit(&self->reserved, memory_order_relaxed);
+
+   do
+   {
+      if (n > SIZE_MAX - index) return 1;
+      const size_t last = int_vector_concurrent_segment(index + n - 1);
+
+      for (size_t segment = int_vector_concurrent_segment(index); segment <= last; ++segment)
+      {
+         if (!int_vector_concurrent_get_segment(self, segment)) return 1;
+      }
+   } while (!atomic_compare_exchange_weak_explicit(&self->reserved, &index, index + n,
+                                                   memory_order_relaxed, memory_order_relaxed));
+
+   *first = index;
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_concurrent_flags: Returnerar adressen till flaggorna i angivet segment, vilka ligger
+*                              direkt efter segmentets element.
+*
+*                              - data   : Pekare till segmentets frsta element.
+*                              - segment: Segmentets nummer.
+**************************************************************************************************/
+static atomic_uchar* int_vector_concurrent_flags(int* data,
+                                                 const size_t segment)
+{
+   return (atomic_uchar*)(data + ((size_t)INT_VECTOR_CONCURRENT_FIRST_SIZE << segment));
+}
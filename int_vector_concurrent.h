@@ -0,0 +1,189 @@
+/**************************************************************************************************
+* int_vector_concurrent.h: Implementering av en vektor fr heltal av datatypen int, till vilken
+*                          flera trdar kan lgga till element samtidigt utan ls. Varje trd
+*                          reserverar platser via en atomr compare-and-swap, efter att segmenten
+*                          som tcker platserna har allokerats, och skriver sedan sina element.
+*                          Elementen lagras i segment vars storlek frdubblas fr varje nytt
+*                          segment, och redan lagrade element flyttas aldrig. Pekare till
+*                          elementen frblir drmed giltiga tills vektorn tms.
+*
+*                          Varje element har en flagga som stts nr elementet r skrivet, s att
+*                          lsare kan ta en gonblicksbild (storlek samt stabila pekare) utan att
+*                          blockera skrivarna och utan att skrivarna behver vnta p varandra.
+*                          gonblicksbilden innehller samtliga element fram till det frsta som
+*                          nnu inte r skrivet. Vektorn kan slutligen plattas ut till en vanlig
+*                          vektor av typen int_vector via en kopiering.
+**************************************************************************************************/
+#ifndef INT_VECTOR_CONCURRENT_H_
+#define INT_VECTOR_CONCURRENT_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "int_vector.h"
+
+/**************************************************************************************************
+* INT_VECTOR_CONCURRENT_FIRST_SIZE: Antalet element i det frsta segmentet. Segment k rymmer
+*                                   INT_VECTOR_CONCURRENT_FIRST_SIZE * 2^k element.
+*
+* INT_VECTOR_CONCURRENT_SEGMENTS: Maximalt antal segment, vilket medger fler element n vad som
+*                                 ryms i minnet.
+*
+* INT_VECTOR_CONCURRENT_CACHE_LINE_SIZE: Storleken p en cache-rad i byte, som anvnds fr att
+*                                        separera rknarna fr reserverade och publicerade
+*                                        element.
+**************************************************************************************************/
+#define INT_VECTOR_CONCURRENT_FIRST_SIZE 1024
+#define INT_VECTOR_CONCURRENT_SEGMENTS 48
+#define INT_VECTOR_CONCURRENT_CACHE_LINE_SIZE 64
+
+/**************************************************************************************************
+* int_vector_concurrent: Vektor fr samtidig insttning frn flera trdar. Medlemmen reserved
+*                        rknar antalet reserverade platser och medlemmen committed antalet
+*                        publicerade element, dr samtliga element med lgre index r skrivna.
+*                        Varje segment bestr av elementen fljt av en flagga (en byte) per
+*                        element. Lsare flyttar fram committed frbi skrivna element. Platser
+*                        reserveras frst nr segmenten som tcker dem r allokerade, s att en
+*                        misslyckad allokering inte lmnar oskrivna platser som skulle stoppa
+*                        publiceringen av senare element.
+**************************************************************************************************/
+struct int_vector_concurrent
+{
+   _Atomic(int*) segments[INT_VECTOR_CONCURRENT_SEGMENTS]; /* Pekare till segmenten. */
+   const struct allocator* allocator; /* Allokator fr segmenten (null = malloc). */
+   _Alignas(INT_VECTOR_CONCURRENT_CACHE_LINE_SIZE) atomic_size_t reserved;  /* Reserverade. */
+   _Alignas(INT_VECTOR_CONCURRENT_CACHE_LINE_SIZE) atomic_size_t committed; /* Publicerade. */
+};
+
+/**************************************************************************************************
+* int_vector_snapshot: gonblicksbild av en vektor av typen int_vector_concurrent. Samtliga
+*                      element med index lgre n size r skrivna och ndras inte, ven om
+*                      andra trdar fortstter att lgga till element i vektorn.
+**************************************************************************************************/
+struct int_vector_snapshot
+{
+   const struct int_vector_concurrent* vector; /* Pekare till vektorn. */
+   size_t size;                                /* Antalet element i gonblicksbilden. */
+};
+
+/**************************************************************************************************
+* int_vector_concurrent_init: Initierar ny tom vektor. Inget minne allokeras frrn det frsta
+*                             elementet lggs till.
+*
+*                             - self: Pekare till vektorn som ska initieras.
+**************************************************************************************************/
+void int_vector_concurrent_init(struct int_vector_concurrent* self);
+
+/**************************************************************************************************
+* int_vector_concurrent_init_with_allocator: Initierar ny tom vektor, vars segment allokeras via
+*                                            angiven allokator. Allokatorn mste vara trdsker.
+*
+*                                            - self     : Pekare till vektorn som ska initieras.
+*                                            - allocator: Pekare till allokatorn (null = malloc).
+**************************************************************************************************/
+void int_vector_concurrent_init_with_allocator(struct int_vector_concurrent* self,
+                                               const struct allocator* allocator);
+
+/**************************************************************************************************
+* int_vector_concurrent_clear: Frigr minnet som har allokerats fr angiven vektor. Fr enbart
+*                              anropas d ingen annan trd lngre anvnder vektorn.
+*
+*                              - self: Pekare till vektorn som ska tmmas.
+**************************************************************************************************/
+void int_vector_concurrent_clear(struct int_vector_concurrent* self);
+
+/**************************************************************************************************
+* int_vector_concurrent_push: Lgger till ett nytt element lngst bak i angiven vektor. Kan
+*                             anropas frn flera trdar samtidigt. Vid lyckad insttning
+*                             returneras 0, annars returneras felkod 1.
+*
+*                             - self       : Pekare till vektorn.
+*                             - new_element: Det nya element som ska lggas till.
+**************************************************************************************************/
+int int_vector_concurrent_push(struct int_vector_concurrent* self,
+                               const int new_element);
+
+/**************************************************************************************************
+* int_vector_concurrent_push_range: Lgger till n element frn angivet flt lngst bak i angiven
+*                                   vektor. Platserna reserveras via en atomr operation, s att
+*                                   elementen hamnar i fljd ven om andra trdar lgger till
+*                                   element samtidigt. Vid lyckad insttning returneras 0,
+*                                   annars returneras felkod 1, varvid inga platser har
+*                                   reserverats och vektorn kan anvndas som tidigare.
+*
+*                                   - self: Pekare till vektorn.
+*                                   - src : Pekare till fltet med elementen som ska lggas till.
+*                                   - n   : Antalet element som ska lggas till.
+**************************************************************************************************/
+int int_vector_concurrent_push_range(struct int_vector_concurrent* self,
+                                     const int* src,
+                                     const size_t n);
+
+/**************************************************************************************************
+* int_vector_concurrent_size: Returnerar antalet publicerade element i angiven vektor, dvs.
+*                             antalet element fram till det frsta som nnu inte r skrivet.
+*
+*                             - self: Pekare till vektorn.
+**************************************************************************************************/
+size_t int_vector_concurrent_size(struct int_vector_concurrent* self);
+
+/**************************************************************************************************
+* int_vector_concurrent_snapshot: Returnerar en gonblicksbild av angiven vektor, innehllande
+*                                 samtliga element som har publicerats hittills.
+*
+*                                 - self: Pekare till vektorn.
+**************************************************************************************************/
+struct int_vector_snapshot int_vector_concurrent_snapshot(struct int_vector_concurrent* self);
+
+/**************************************************************************************************
+* int_vector_snapshot_at: Returnerar adressen till elementet p angivet index i angiven
+*                         gonblicksbild, eller null om index ligger utanfr gonblicksbilden.
+*
+*                         - self : Pekare till gonblicksbilden.
+*                         - index: Elementets index.
+**************************************************************************************************/
+const int* int_vector_snapshot_at(const struct int_vector_snapshot* self,
+                                  const size_t index);
+
+/**************************************************************************************************
+* int_vector_snapshot_span: Returnerar adressen till elementet p angivet index i angiven
+*                           gonblicksbild och tilldelar antalet element som fljer direkt efter
+*                           varandra i minnet frn och med detta index, vilket mjliggr
+*                           iteration segment fr segment. Om index ligger utanfr
+*                           gonblicksbilden returneras null och length tilldelas 0.
+*
+*                           - self  : Pekare till gonblicksbilden.
+*                           - index : Index till det frsta elementet.
+*                           - length: Pekare till variabeln som tilldelas antalet element.
+**************************************************************************************************/
+const int* int_vector_snapshot_span(const struct int_vector_snapshot* self,
+                                    const size_t index,
+                                    size_t* length);
+
+/**************************************************************************************************
+* int_vector_snapshot_flatten: Kopierar samtliga element i angiven gonblicksbild till angiven
+*                              vektor, vars tidigare innehll erstts. Hgst en omallokering
+*                              genomfrs och varje segment kopieras i ett block. Vid lyckad
+*                              kopiering returneras 0, annars returneras felkod 1.
+*
+*                              - self: Pekare till gonblicksbilden.
+*                              - dest: Pekare till vektorn som ska tilldelas elementen.
+**************************************************************************************************/
+int int_vector_snapshot_flatten(const struct int_vector_snapshot* self,
+                                struct int_vector* dest);
+
+/**************************************************************************************************
+* int_vector_concurrent_flatten: Kopierar samtliga publicerade element i angiven vektor till
+*                                angiven vektor av typen int_vector, se
+*                                int_vector_snapshot_flatten. Vid lyckad kopiering returneras 0,
+*                                annars returneras felkod 1.
+*
+*                                - self: Pekare till vektorn som ska plattas ut.
+*                                - dest: Pekare till vektorn som ska tilldelas elementen.
+**************************************************************************************************/
+int int_vector_concurrent_flatten(struct int_vector_concurrent* self,
+                                  struct int_vector* dest);
+
+#endif /* INT_VECTOR_CONCURRENT_H_ */
@@ -0,0 +1,354 @@
+/**************************************************************************************************
+* int_vector_parallel.c: Innehller definitioner av funktioner fr parallell bearbetning av
+*                        vektorer av typen int_vector via trdpoolen i "thread_pool.h".
+**************************************************************************************************/
+#include "int_vector_parallel.h"
+#include "int_vector_simd.h"
+
+/**************************************************************************************************
+* int_vector_parallel_job: Parametrar fr ett parallellt jobb, vilka delas av samtliga uppgifter.
+*                          Del 0 omfattar elementen fram till den frsta justerade grnsen plus
+*                          grain element, medan vriga delar brjar p lead + task * grain.
+**************************************************************************************************/
+struct int_vector_parallel_job
+{
+   int* data;    /* Pekare till vektorns flt. */
+   size_t size;  /* Antalet element i vektorn. */
+   size_t lead;  /* Antalet element fre den frsta justerade grnsen. */
+   size_t grain; /* Antalet element per del, en multipel av en cache-rad. */
+   void (*function)(int* first, int* last, size_t index, void* context); /* Se parallel_for. */
+   int64_t (*reduce)(const int* first, const int* last, size_t index, void* context);
+   void* context;     /* Kontext som passeras till funktionerna. */
+   int64_t* partials; /* Delresultat per del vid reduktion. */
+};
+
+/**************************************************************************************************
+* int_vector_parallel_step: Kontext vid parallell tilldelning via int_vector_parallel_assign_step.
+**************************************************************************************************/
+struct int_vector_parallel_step
+{
+   int start; /* Det frsta elementets vrde. */
+   int step;  /* Stegvrdet. */
+};
+
+/* Statiska funktioner: */
+static size_t int_vector_parallel_split(struct int_vector_parallel_job* self,
+                                        const int* data,
+                                        const size_t size,
+                                        const size_t grain);
+static void int_vector_parallel_bounds(const struct int_vector_parallel_job* self,
+                                       const size_t task,
+                                       size_t* first,
+                                       size_t* last);
+static void int_vector_parallel_run(const size_t task_count,
+                                    void (*function)(void* context, size_t task),
+                                    void* context);
+static void int_vector_parallel_for_task(void* context, size_t task);
+static void int_vector_parallel_reduce_task(void* context, size_t task);
+static void int_vector_parallel_fill_step(int* first, int* last, size_t index, void* context);
+static int64_t int_vector_parallel_sum_range(const int* first, const int* last, size_t index,
+                                             void* context);
+static int64_t int_vector_parallel_add(int64_t lhs, int64_t rhs, void* context);
+
+/**************************************************************************************************
+* int_vector_parallel_for: Anropar angiven funktion fr samtliga delar av angiven vektor, dr
+*                          varje anrop erhller delens frsta element, elementet direkt efter
+*                          delens sista element, index till delens frsta element i vektorn samt
+*                          angiven kontext. Delarna bearbetas parallellt i ospecificerad ordning.
+*                          Funktionen fr ndra elementen inom sin del, men inte vektorns storlek.
+*                          Vid lyckad krning returneras 0, annars returneras felkod 1, varvid
+*                          ingen del har bearbetats.
+*
+*                          - self    : Pekare till vektorn som ska bearbetas.
+*                          - function: Funktionen som ska anropas fr varje del.
+*                          - context : Kontext som passeras till funktionen.
+*                          - grain   : Ungefrligt antal element per del, som avrundas uppt till
+*                                      en hel cache-rad (0 = INT_VECTOR_PARALLEL_DEFAULT_GRAIN).
+**************************************************************************************************/
+int int_vector_parallel_for(struct int_vector* self,
+                            void (*function)(int* first, int* last, size_t index, void* context),
+                            void* context,
+                            const size_t grain)
+{
+   struct int_vector_parallel_job job;
+   if (!self->size) return 0;
+   if (int_vector_unshare(self)) return 1;
+   int_vector_mark_dirty(self, 0, self->size);
+   const size_t task_count = int_vector_parallel_split(&job, self->data, self->size, grain);
+   if (!task_count) return 1;
+
+   job.function = function;
+   job.reduce = 0;
+   job.context = context;
+   job.partials = 0;
+   int_vector_parallel_run(task_count, int_vector_parallel_for_task, &job);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_reduce: Reducerar elementen i angiven vektor till ett 64-bitars vrde.
+*                             Angiven funktion reduce berknar ett delresultat per del (se
+*                             int_vector_parallel_for), varefter delresultaten sls samman i
+*                             vektorns ordning via funktionen combine, med brjan p angivet
+*                             startvrde. Resultatet r drmed deterministiskt s lnge combine
+*                             r associativ. Delresultaten lagras i ett temporrt flt som
+*                             allokeras via standardallokatorn (malloc), inte vektorns
+*                             allokator. Vid lyckad reduktion returneras 0 och resultatet
+*                             tilldelas angiven variabel, annars returneras felkod 1.
+*
+*                             - self    : Pekare till vektorn som ska reduceras.
+*                             - reduce  : Funktionen som berknar delresultatet fr en del.
+*                             - combine : Funktionen som slr samman tv resultat.
+*                             - context : Kontext som passeras till funktionerna.
+*                             - identity: Startvrdet, exempelvis 0 vid summering.
+*                             - grain   : Ungefrligt antal element per del (0 = default).
+*                             - result  : Pekare till variabeln som ska tilldelas resultatet.
+**************************************************************************************************/
+int int_vector_parallel_reduce(const struct int_vector* self,
+                               int64_t (*reduce)(const int* first, const int* last,
+                                                 size_t index, void* context),
+                               int64_t (*combine)(int64_t lhs, int64_t rhs, void* context),
+                               void* context,
+                               const int64_t identity,
+                               const size_t grain,
+                               int64_t* result)
+{
+   struct int_vector_parallel_job job;
+   int64_t value = identity;
+
+   if (!self->size)
+   {
+      *result = value;
+      return 0;
+   }
+
+   const size_t task_count = int_vector_parallel_split(&job, self->data, self->size, grain);
+   if (!task_count) return 1;
+
+   if (task_count == 1)
+   {
+      *result = combine(value, reduce(self->data, self->data + self->size, 0, context), context);
+      return 0;
+   }
+
+   job.partials = (int64_t*)allocator_allocate(0, sizeof(int64_t) * task_count);
+   if (!job.partials) return 1;
+   job.function = 0;
+   job.reduce = reduce;
+   job.context = context;
+   int_vector_parallel_run(task_count, int_vector_parallel_reduce_task, &job);
+
+   for (size_t i = 0; i < task_count; ++i)
+   {
+      value = combine(value, job.partials[i], context);
+   }
+
+   allocator_deallocate(0, job.partials, sizeof(int64_t) * task_count);
+   *result = value;
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_assign_step: Parallell motsvarighet till int_vector_assign_step, som stter
+*                                  vektorns storlek till angivet antal element och tilldelar
+*                                  elementen heltal frn angivet startvrde med angivet
+*                                  stegvrde. Storleken stts via int_vector_resize, som inte
+*                                  initierar nya element, s att sidorna berrs frst av den trd
+*                                  som skriver dem. Samtliga element markeras som ndrade av
+*                                  tilldelningen. Vid lyckad tilldelning returneras 0, annars
+*                                  returneras felkod 1.
+*
+*                                  - self : Pekare till vektorn som ska tilldelas.
+*                                  - size : Vektorns nya storlek.
+*                                  - start: Det frsta elementets vrde.
+*                                  - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+int int_vector_parallel_assign_step(struct int_vector* self,
+                                    const size_t size,
+                                    const int start,
+                                    const int step)
+{
+   struct int_vector_parallel_step context = { start, step };
+
+   if (int_vector_resize(self, size)) return 1;
+
+   if (int_vector_parallel_for(self, int_vector_parallel_fill_step, &context, 0))
+   {
+      int_vector_fill_step(self, start, step);
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_sum: Parallell motsvarighet till int_vector_sum, som returnerar summan av
+*                          samtliga element i angiven vektor. Ifall parallell summering inte kan
+*                          genomfras summeras vektorn av den anropande trden.
+*
+*                          - self: Pekare till vektorn vars element ska summeras.
+**************************************************************************************************/
+int64_t int_vector_parallel_sum(const struct int_vector* self)
+{
+   int64_t sum;
+
+   if (int_vector_parallel_reduce(self, int_vector_parallel_sum_range, int_vector_parallel_add,
+                                  0, 0, 0, &sum))
+   {
+      return int_vector_sum(self);
+   }
+
+   return sum;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_split: Delar in angivet flt i delar om angivet antal element, dr del 0
+*                            frlngs till den frsta grnsen som r justerad till en cache-rad,
+*                            s att vriga delar brjar p en ny cache-rad. Antalet element per
+*                            del kas vid behov s att antalet delar inte verstiger
+*                            THREAD_POOL_MAX_TASKS. Antalet delar returneras.
+*
+*                            - self : Pekare till jobbet som ska tilldelas indelningen.
+*                            - data : Pekare till fltets frsta element.
+*                            - size : Antalet element i fltet (minst 1).
+*                            - grain: Ungefrligt antal element per del (0 = default).
+**************************************************************************************************/
+static size_t int_vector_parallel_split(struct int_vector_parallel_job* self,
+                                        const int* data,
+                                        const size_t size,
+                                        const size_t grain)
+{
+   const size_t line = INT_VECTOR_PARALLEL_ALIGNMENT / sizeof(int);
+   const size_t misalignment = (uintptr_t)data % INT_VECTOR_PARALLEL_ALIGNMENT;
+   size_t chunk = grain ? grain : INT_VECTOR_PARALLEL_DEFAULT_GRAIN;
+
+   if (chunk > SIZE_MAX - line) chunk = size;
+   chunk = (chunk + line - 1) / line * line;
+
+   self->data = (int*)data;
+   self->size = size;
+   self->lead = misalignment ? (INT_VECTOR_PARALLEL_ALIGNMENT - misalignment) / sizeof(int) : 0;
+
+   if (self->lead >= size || size - self->lead <= chunk)
+   {
+      self->grain = chunk;
+      return 1;
+   }
+
+   while ((size - self->lead - 1) / chunk + 1 > THREAD_POOL_MAX_TASKS)
+   {
+      chunk *= 2;
+   }
+
+   self->grain = chunk;
+   return (size - self->lead - 1) / chunk + 1;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_bounds: Tilldelar index till angiven dels frsta element samt elementet
+*                             direkt efter delens sista element.
+*
+*                             - self : Pekare till jobbet.
+*                             - task : Delens index.
+*                             - first: Pekare till variabeln som tilldelas det frsta indexet.
+*                             - last : Pekare till variabeln som tilldelas det sista indexet.
+**************************************************************************************************/
+static void int_vector_parallel_bounds(const struct int_vector_parallel_job* self,
+                                       const size_t task,
+                                       size_t* first,
+                                       size_t* last)
+{
+   const size_t end = self->lead + (task + 1) * self->grain;
+   *first = task ? self->lead + task * self->grain : 0;
+   *last = end < self->size ? end : self->size;
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_run: Kr angivet antal uppgifter via den globala trdpoolen, eller via den
+*                          anropande trden ifall poolen inte kunde skapas.
+*
+*                          - task_count: Antalet uppgifter.
+*                          - function  : Funktionen som ska kras fr varje uppgift.
+*                          - context   : Kontext som passeras till funktionen.
+**************************************************************************************************/
+static void int_vector_parallel_run(const size_t task_count,
+                                    void (*function)(void* context, size_t task),
+                                    void* context)
+{
+   struct thread_pool* pool = thread_pool_default();
+
+   if (!pool || thread_pool_run(pool, task_count, function, context))
+   {
+      for (size_t i = 0; i < task_count; ++i)
+      {
+         function(context, i);
+      }
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_for_task: Anropar jobbets funktion fr angiven del.
+*
+*                               - context: Pekare till jobbet (struct int_vector_parallel_job).
+*                               - task   : Delens index.
+**************************************************************************************************/
+static void int_vector_parallel_for_task(void* context, size_t task)
+{
+   const struct int_vector_parallel_job* self = (const struct int_vector_parallel_job*)context;
+   size_t first, last;
+   int_vector_parallel_bounds(self, task, &first, &last);
+   self->function(self->data + first, self->data + last, first, self->context);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_reduce_task: Berknar delresultatet fr angiven del.
+*
+*                                  - context: Pekare till jobbet (struct int_vector_parallel_job).
+*                                  - task   : Delens index.
+**************************************************************************************************/
+static void int_vector_parallel_reduce_task(void* context, size_t task)
+{
+   const struct int_vector_parallel_job* self = (const struct int_vector_parallel_job*)context;
+   size_t first, last;
+   int_vector_parallel_bounds(self, task, &first, &last);
+   self->partials[task] = self->reduce(self->data + first, self->data + last, first,
+                                       self->context);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_fill_step: Tilldelar en del av vektorn heltal med angivet stegvrde, dr
+*                                delens startvrde berknas utifrn delens index. Berkningen
+*                                sker osignerat fr att erhlla tvkomplementsomslag.
+**************************************************************************************************/
+static void int_vector_parallel_fill_step(int* first, int* last, size_t index, void* context)
+{
+   const struct int_vector_parallel_step* self = (const struct int_vector_parallel_step*)context;
+   const unsigned int start = (unsigned int)self->start + (unsigned int)index *
+                              (unsigned int)self->step;
+   int_array_fill_step(first, (size_t)(last - first), (int)start, self->step);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_parallel_sum_range: Returnerar summan av elementen i en del av vektorn.
+**************************************************************************************************/
+static int64_t int_vector_parallel_sum_range(const int* first, const int* last, size_t index,
+                                             void* context)
+{
+   (void)index;
+   (void)context;
+   return int_array_sum(first, (size_t)(last - first));
+}
+
+/**************************************************************************************************
+* int_vector_parallel_add: Returnerar summan av tv delresultat.
+**************************************************************************************************/
+static int64_t int_vector_parallel_add(int64_t lhs, int64_t rhs, void* context)
+{
+   (void)context;
+   return lhs + rhs;
+}
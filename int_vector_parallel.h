@@ -0,0 +1,105 @@
+/**************************************************************************************************
+* int_vector_parallel.h: Parallell bearbetning av vektorer av typen int_vector via den globala
+*                        trdpoolen, se thread_pool_default. Vektorn delas in i delar (chunks)
+*                        om angivet antal element, vilka frdelas ver trdarna via work
+*                        stealing. Delarnas grnser justeras till cache-rader, s att tv trdar
+*                        aldrig skriver till samma cache-rad (false sharing). Arbetstrdarna
+*                        skapas vid frsta anropet och teranvnds drefter.
+**************************************************************************************************/
+#ifndef INT_VECTOR_PARALLEL_H_
+#define INT_VECTOR_PARALLEL_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "int_vector.h"
+#include "thread_pool.h"
+
+/**************************************************************************************************
+* INT_VECTOR_PARALLEL_DEFAULT_GRAIN: Default-antal element per del, vilket r tillrckligt stort
+*                                    fr att kostnaden per del ska vara frsumbar.
+*
+* INT_VECTOR_PARALLEL_ALIGNMENT: Justering i byte fr delarnas grnser, dvs. en cache-rad.
+**************************************************************************************************/
+#define INT_VECTOR_PARALLEL_DEFAULT_GRAIN (64 * 1024)
+#define INT_VECTOR_PARALLEL_ALIGNMENT THREAD_POOL_CACHE_LINE_SIZE
+
+/**************************************************************************************************
+* int_vector_parallel_for: Anropar angiven funktion fr samtliga delar av angiven vektor, dr
+*                          varje anrop erhller delens frsta element, elementet direkt efter
+*                          delens sista element, index till delens frsta element i vektorn samt
+*                          angiven kontext. Delarna bearbetas parallellt i ospecificerad ordning.
+*                          Funktionen fr ndra elementen inom sin del, men inte vektorns storlek.
+*                          Vid lyckad krning returneras 0, annars returneras felkod 1, varvid
+*                          ingen del har bearbetats.
+*
+*                          - self    : Pekare till vektorn som ska bearbetas.
+*                          - function: Funktionen som ska anropas fr varje del.
+*                          - context : Kontext som passeras till funktionen.
+*                          - grain   : Ungefrligt antal element per del, som avrundas uppt till
+*                                      en hel cache-rad (0 = INT_VECTOR_PARALLEL_DEFAULT_GRAIN).
+**************************************************************************************************/
+int int_vector_parallel_for(struct int_vector* self,
+                            void (*function)(int* first, int* last, size_t index, void* context),
+                            void* context,
+                            const size_t grain);
+
+/**************************************************************************************************
+* int_vector_parallel_reduce: Reducerar elementen i angiven vektor till ett 64-bitars vrde.
+*                             Angiven funktion reduce berknar ett delresultat per del (se
+*                             int_vector_parallel_for), varefter delresultaten sls samman i
+*                             vektorns ordning via funktionen combine, med brjan p angivet
+*                             startvrde. Resultatet r drmed deterministiskt s lnge combine
+*                             r associativ. Delresultaten lagras i ett temporrt flt som
+*                             allokeras via standardallokatorn (malloc), inte vektorns
+*                             allokator. Vid lyckad reduktion returneras 0 och resultatet
+*                             tilldelas angiven variabel, annars returneras felkod 1.
+*
+*                             - self    : Pekare till vektorn som ska reduceras.
+*                             - reduce  : Funktionen som berknar delresultatet fr en del.
+*                             - combine : Funktionen som slr samman tv resultat.
+*                             - context : Kontext som passeras till funktionerna.
+*                             - identity: Startvrdet, exempelvis 0 vid summering.
+*                             - grain   : Ungefrligt antal element per del (0 = default).
+*                             - result  : Pekare till variabeln som ska tilldelas resultatet.
+**************************************************************************************************/
+int int_vector_parallel_reduce(const struct int_vector* self,
+                               int64_t (*reduce)(const int* first, const int* last,
+                                                 size_t index, void* context),
+                               int64_t (*combine)(int64_t lhs, int64_t rhs, void* context),
+                               void* context,
+                               const int64_t identity,
+                               const size_t grain,
+                               int64_t* result);
+
+/**************************************************************************************************
+* int_vector_parallel_assign_step: Parallell motsvarighet till int_vector_assign_step, som stter
+*                                  vektorns storlek till angivet antal element och tilldelar
+*                                  elementen heltal frn angivet startvrde med angivet
+*                                  stegvrde. Storleken stts via int_vector_resize, som inte
+*                                  initierar nya element, s att sidorna berrs frst av den trd
+*                                  som skriver dem. Samtliga element markeras som ndrade av
+*                                  tilldelningen. Vid lyckad tilldelning returneras 0, annars
+*                                  returneras felkod 1.
+*
+*                                  - self : Pekare till vektorn som ska tilldelas.
+*                                  - size : Vektorns nya storlek.
+*                                  - start: Det frsta elementets vrde.
+*                                  - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+int int_vector_parallel_assign_step(struct int_vector* self,
+                                    const size_t size,
+                                    const int start,
+                                    const int step);
+
+/**************************************************************************************************
+* int_vector_parallel_sum: Parallell motsvarighet till int_vector_sum, som returnerar summan av
+*                          samtliga element i angiven vektor. Ifall parallell summering inte kan
+*                          genomfras summeras vektorn av den anropande trden.
+*
+*                          - self: Pekare till vektorn vars element ska summeras.
+**************************************************************************************************/
+int64_t int_vector_parallel_sum(const struct int_vector* self);
+
+#endif /* INT_VECTOR_PARALLEL_H_ */
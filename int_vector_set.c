@@ -0,0 +1,489 @@
+/**************************************************************************************************
+* int_vector_set.c: Innehller definitioner av mngdoperationer fr sorterade vektorer av typen
+*                   int_vector samt av associerade funktioner fr strukten int_vector_index.
+**************************************************************************************************/
+#include "int_vector_set.h"
+
+/**************************************************************************************************
+* INT_VECTOR_INDEX_MULTIPLIER: Multiplikator fr hashfunktionen (2^64 dividerat med gyllene
+*                              snittet), som sprider nrliggande vrden ver samtliga platser.
+**************************************************************************************************/
+#define INT_VECTOR_INDEX_MULTIPLIER UINT64_C(0x9E3779B97F4A7C15)
+
+/* Statiska funktioner: */
+static const int* int_vector_set_gallop(const int* first, const int* last, const int value);
+static int int_vector_set_lopsided(const size_t lhs_size, const size_t rhs_size);
+static int int_vector_set_prepare(struct int_vector* result,
+                                  const struct int_vector* dest,
+                                  const size_t capacity);
+static void int_vector_set_assign(struct int_vector* dest,
+                                  struct int_vector* result,
+                                  const int* last);
+static size_t int_vector_index_hash(const struct int_vector_index* self, const int value);
+static size_t int_vector_index_find(const struct int_vector_index* self, const int value);
+
+/**************************************************************************************************
+* int_vector_set_unique: Tar bort dubbletter ur angiven sorterad vektor, s att enbart det frsta
+*                        av varje sekvens av lika element behlls. Vektorns kapacitet ndras
+*                        inte. Vid lyckad borttagning returneras 0, annars returneras felkod 1.
+*
+*                        - self: Pekare till den sorterade vektorn.
+**************************************************************************************************/
+int int_vector_set_unique(struct int_vector* self)
+{
+   const int* data = int_vector_cbegin(self);
+   size_t first = 1;
+
+   while (first < self->size && data[first] != data[first - 1])
+   {
+      first++;
+   }
+
+   if (first >= self->size) return 0;
+   if (int_vector_unshare(self)) return 1;
+   int_vector_mark_dirty(self, first, self->size - first);
+   size_t size = first;
+
+   for (size_t i = first + 1; i < self->size; ++i)
+   {
+      if (self->data[i] != self->data[size - 1]) self->data[size++] = self->data[i];
+   }
+
+   self->size = size;
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_set_union: Tilldelar angiven vektor unionen av tv sorterade vektorer, dvs. samtliga
+*                       element som finns i minst en av vektorerna. Destinationen fr vara samma
+*                       vektor som ngon av kllorna. Vid lyckad berkning returneras 0, annars
+*                       returneras felkod 1, varvid destinationen lmnas ofrndrad.
+*
+*                       - dest: Pekare till vektorn som ska tilldelas resultatet.
+*                       - lhs : Pekare till den frsta sorterade vektorn.
+*                       - rhs : Pekare till den andra sorterade vektorn.
+**************************************************************************************************/
+int int_vector_set_union(struct int_vector* dest,
+                         const struct int_vector* lhs,
+                         const struct int_vector* rhs)
+{
+   if (lhs->size > SIZE_MAX - rhs->size) return 1;
+   if (lhs->size < rhs->size) return int_vector_set_union(dest, rhs, lhs);
+
+   struct int_vector result;
+   if (int_vector_set_prepare(&result, dest, lhs->size + rhs->size)) return 1;
+   const int* i = int_vector_cbegin(lhs);
+   const int* j = int_vector_cbegin(rhs);
+   const int* const lhs_last = int_vector_cend(lhs);
+   const int* const rhs_last = int_vector_cend(rhs);
+   int* out = result.data;
+
+   if (int_vector_set_lopsided(lhs->size, rhs->size))
+   {
+      for (; j < rhs_last; ++j)
+      {
+         const int* run = int_vector_set_gallop(i, lhs_last, *j);
+         memcpy(out, i, sizeof(int) * (size_t)(run - i));
+         out += run - i;
+         i = run < lhs_last && *run == *j ? run + 1 : run;
+         *out++ = *j;
+      }
+   }
+   else
+   {
+      while (i < lhs_last && j < rhs_last)
+      {
+         const int a = *i, b = *j;
+         *out++ = a < b ? a : b;
+         i += a <= b;
+         j += b <= a;
+      }
+
+      memcpy(out, j, sizeof(int) * (size_t)(rhs_last - j));
+      out += rhs_last - j;
+   }
+
+   memcpy(out, i, sizeof(int) * (size_t)(lhs_last - i));
+   out += lhs_last - i;
+   int_vector_set_assign(dest, &result, out);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_set_intersection: Tilldelar angiven vektor snittet av tv sorterade vektorer, dvs.
+*                              de element som finns i bda vektorerna. Destinationen fr vara
+*                              samma vektor som ngon av kllorna. Vid lyckad berkning
+*                              returneras 0, annars returneras felkod 1, varvid destinationen
+*                              lmnas ofrndrad.
+*
+*                              - dest: Pekare till vektorn som ska tilldelas resultatet.
+*                              - lhs : Pekare till den frsta sorterade vektorn.
+*                              - rhs : Pekare till den andra sorterade vektorn.
+**************************************************************************************************/
+int int_vector_set_intersection(struct int_vector* dest,
+                                const struct int_vector* lhs,
+                                const struct int_vector* rhs)
+{
+   if (lhs->size < rhs->size) return int_vector_set_intersection(dest, rhs, lhs);
+
+   struct int_vector result;
+   if (int_vector_set_prepare(&result, dest, rhs->size)) return 1;
+   const int* i = int_vector_cbegin(lhs);
+   const int* j = int_vector_cbegin(rhs);
+   const int* const lhs_last = int_vector_cend(lhs);
+   const int* const rhs_last = int_vector_cend(rhs);
+   int* out = result.data;
+
+   if (int_vector_set_lopsided(lhs->size, rhs->size))
+   {
+      for (; j < rhs_last; ++j)
+      {
+         i = int_vector_set_gallop(i, lhs_last, *j);
+         if (i == lhs_last) break;
+         if (*i == *j) *out++ = *i++;
+      }
+   }
+   else
+   {
+      while (i < lhs_last && j < rhs_last)
+      {
+         const int a = *i, b = *j;
+         *out = a;
+         out += a == b;
+         i += a <= b;
+         j += b <= a;
+      }
+   }
+
+   int_vector_set_assign(dest, &result, out);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_set_difference: Tilldelar angiven vektor differensen mellan tv sorterade vektorer,
+*                            dvs. de element i lhs som inte finns i rhs. Destinationen fr vara
+*                            samma vektor som ngon av kllorna. Vid lyckad berkning returneras
+*                            0, annars returneras felkod 1, varvid destinationen lmnas
+*                            ofrndrad.
+*
+*                            - dest: Pekare till vektorn som ska tilldelas resultatet.
+*                            - lhs : Pekare till den sorterade vektorn vars element behlls.
+*                            - rhs : Pekare till den sorterade vektorn vars element tas bort.
+**************************************************************************************************/
+int int_vector_set_difference(struct int_vector* dest,
+                              const struct int_vector* lhs,
+                              const struct int_vector* rhs)
+{
+   struct int_vector result;
+   if (int_vector_set_prepare(&result, dest, lhs->size)) return 1;
+   const int* i = int_vector_cbegin(lhs);
+   const int* j = int_vector_cbegin(rhs);
+   const int* const lhs_last = int_vector_cend(lhs);
+   const int* const rhs_last = int_vector_cend(rhs);
+   int* out = result.data;
+
+   if (lhs->size >= rhs->size && int_vector_set_lopsided(lhs->size, rhs->size))
+   {
+      for (; j < rhs_last; ++j)
+      {
+         const int* run = int_vector_set_gallop(i, lhs_last, *j);
+         memcpy(out, i, sizeof(int) * (size_t)(run - i));
+         out += run - i;
+         i = run < lhs_last && *run == *j ? run + 1 : run;
+      }
+   }
+   else if (int_vector_set_lopsided(lhs->size, rhs->size))
+   {
+      for (; i < lhs_last; ++i)
+      {
+         j = int_vector_set_gallop(j, rhs_last, *i);
+         if (j == rhs_last) break;
+         if (*j != *i) *out++ = *i;
+      }
+   }
+   else
+   {
+      while (i < lhs_last && j < rhs_last)
+      {
+         const int a = *i, b = *j;
+         *out = a;
+         out += a < b;
+         i += a <= b;
+         j += b <= a;
+      }
+   }
+
+   memcpy(out, i, sizeof(int) * (size_t)(lhs_last - i));
+   out += lhs_last - i;
+   int_vector_set_assign(dest, &result, out);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_index_init: Initierar nytt tomt hashindex.
+*
+*                        - self: Pekare till indexet som ska initieras.
+**************************************************************************************************/
+void int_vector_index_init(struct int_vector_index* self)
+{
+   int_vector_index_init_with_allocator(self, 0);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_index_init_with_allocator: Initierar nytt tomt hashindex, vars platser allokeras via
+*                                       angiven allokator.
+*
+*                                       - self     : Pekare till indexet som ska initieras.
+*                                       - allocator: Pekare till allokatorn (null = malloc).
+**************************************************************************************************/
+void int_vector_index_init_with_allocator(struct int_vector_index* self,
+                                          const struct allocator* allocator)
+{
+   self->slots = 0;
+   self->slot_count = 0;
+   self->count = 0;
+   self->shift = 0;
+   self->allocator = allocator;
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_index_clear: Frigr minnet som har allokerats fr angivet hashindex.
+*
+*                         - self: Pekare till indexet som ska tmmas.
+**************************************************************************************************/
+void int_vector_index_clear(struct int_vector_index* self)
+{
+   if (self->slots)
+   {
+      allocator_deallocate(self->allocator, self->slots,
+                           sizeof(struct int_vector_index_slot) * self->slot_count);
+   }
+
+   int_vector_index_init_with_allocator(self, self->allocator);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_index_build: Bygger angivet hashindex ver elementen i angiven vektor, varvid
+*                         indexets tidigare innehll erstts. Vid dubbletter lagras index till
+*                         det frsta elementet. Vid lyckat bygge returneras 0, annars returneras
+*                         felkod 1, varvid indexet lmnas tomt.
+*
+*                         - self  : Pekare till indexet som ska byggas.
+*                         - vector: Pekare till vektorn vars element ska indexeras.
+**************************************************************************************************/
+int int_vector_index_build(struct int_vector_index* self,
+                           const struct int_vector* vector)
+{
+   const size_t max_slots = SIZE_MAX / sizeof(struct int_vector_index_slot);
+   size_t slot_count = INT_VECTOR_INDEX_MIN_SLOTS;
+   unsigned int shift = 64 - 4;
+
+   while (slot_count / 2 < vector->size)
+   {
+      if (slot_count > max_slots / 2)
+      {
+         int_vector_index_clear(self);
+         return 1;
+      }
+
+      slot_count *= 2;
+      shift--;
+   }
+
+   if (slot_count != self->slot_count)
+   {
+      int_vector_index_clear(self);
+      self->slots = (struct int_vector_index_slot*)allocator_allocate(
+         self->allocator, sizeof(struct int_vector_index_slot) * slot_count);
+      if (!self->slots) return 1;
+      self->slot_count = slot_count;
+      self->shift = shift;
+   }
+
+   memset(self->slots, 0, sizeof(struct int_vector_index_slot) * slot_count);
+   self->count = 0;
+
+   for (size_t i = 0; i < vector->size; ++i)
+   {
+      const int value = vector->data[i];
+      size_t slot = int_vector_index_hash(self, value);
+
+      while (self->slots[slot].position && self->slots[slot].key != value)
+      {
+         slot = (slot + 1) & (slot_count - 1);
+      }
+
+      if (!self->slots[slot].position)
+      {
+         self->slots[slot].position = i + 1;
+         self->slots[slot].key = value;
+         self->count++;
+      }
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_index_contains: Indikerar ifall angivet vrde finns i angivet hashindex.
+*
+*                            - self : Pekare till indexet.
+*                            - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+int int_vector_index_contains(const struct int_vector_index* self,
+                              const int value)
+{
+   return int_vector_index_find(self, value) != 0;
+}
+
+/**************************************************************************************************
+* int_vector_index_of: Tilldelar index till det frsta elementet lika med angivet vrde till
+*                      angiven variabel. Ifall vrdet finns returneras 0, annars returneras
+*                      felkod 1.
+*
+*                      - self : Pekare till indexet.
+*                      - value: Vrdet som ska skas efter.
+*                      - index: Pekare till variabeln som ska tilldelas elementets index.
+**************************************************************************************************/
+int int_vector_index_of(const struct int_vector_index* self,
+                        const int value,
+                        size_t* index)
+{
+   const size_t position = int_vector_index_find(self, value);
+   if (!position) return 1;
+   *index = position - 1;
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_set_gallop: Returnerar adressen till det frsta elementet i angivet sorterat
+*                        intervall som r strre n eller lika med angivet vrde, eller last om
+*                        inget sdant element finns. Avstndet frn intervallets brjan frdubblas
+*                        tills vrdet har passerats, varefter binrskning sker i det sista
+*                        steget, vilket krver O(log d) jmfrelser dr d r avstndet till
+*                        resultatet.
+*
+*                        - first: Pekare till intervallets frsta element.
+*                        - last : Pekare direkt efter intervallets sista element.
+*                        - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+static const int* int_vector_set_gallop(const int* first, const int* last, const int value)
+{
+   const size_t size = (size_t)(last - first);
+   if (!size || *first >= value) return first;
+   size_t bound = 1;
+
+   while (bound < size && first[bound] < value)
+   {
+      bound *= 2;
+   }
+
+   const int* low = first + bound / 2 + 1;
+   size_t count = (bound < size ? bound : size) - bound / 2 - 1;
+
+   while (count > 0)
+   {
+      const size_t half = count / 2;
+
+      if (low[half] < value)
+      {
+         low += half + 1;
+         count -= half + 1;
+      }
+      else
+      {
+         count = half;
+      }
+   }
+
+   return low;
+}
+
+/**************************************************************************************************
+* int_vector_set_lopsided: Indikerar ifall storleksfrhllandet mellan tv vektorer r s stort
+*                          att galoppering ska anvndas, se INT_VECTOR_SET_GALLOP_RATIO.
+*
+*                          - lhs_size: Den frsta vektorns storlek.
+*                          - rhs_size: Den andra vektorns storlek.
+**************************************************************************************************/
+static int int_vector_set_lopsided(const size_t lhs_size, const size_t rhs_size)
+{
+   const size_t smaller = lhs_size < rhs_size ? lhs_size : rhs_size;
+   const size_t larger = lhs_size < rhs_size ? rhs_size : lhs_size;
+   return smaller < larger / INT_VECTOR_SET_GALLOP_RATIO;
+}
+
+/**************************************************************************************************
+* int_vector_set_prepare: Initierar en temporr vektor fr resultatet av en mngdoperation med
+*                         destinationens allokator och angiven kapacitet, s att resultatet kan
+*                         skrivas direkt till fltet. Vid lyckad allokering returneras 0, annars
+*                         returneras felkod 1.
+*
+*                         - result  : Pekare till den temporra vektorn.
+*                         - dest    : Pekare till destinationen.
+*                         - capacity: Resultatets strsta mjliga storlek.
+**************************************************************************************************/
+static int int_vector_set_prepare(struct int_vector* result,
+                                  const struct int_vector* dest,
+                                  const size_t capacity)
+{
+   int_vector_init_with_allocator(result, dest->allocator);
+   if (!int_vector_reserve(result, capacity)) return 0;
+   int_vector_clear(result);
+   return 1;
+}
+
+/**************************************************************************************************
+* int_vector_set_assign: Stter storleken p resultatet av en mngdoperation och flyttar det till
+*                        destinationen, vars tidigare innehll frigrs. Fltet krymps inte, d
+*                        resultatet ofta anvnds kort och kapaciteten hgst r summan av
+*                        kllornas storlekar.
+*
+*                        - dest  : Pekare till destinationen.
+*                        - result: Pekare till den temporra vektorn innehllande resultatet.
+*                        - last  : Pekare direkt efter resultatets sista element.
+**************************************************************************************************/
+static void int_vector_set_assign(struct int_vector* dest,
+                                  struct int_vector* result,
+                                  const int* last)
+{
+   result->size = (size_t)(last - result->data);
+   int_vector_move(dest, result);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_index_hash: Returnerar platsen fr angivet vrde via multiplikativ hashning, dr
+*                        produktens vre bitar anvnds.
+*
+*                        - self : Pekare till indexet.
+*                        - value: Vrdet som ska hashas.
+**************************************************************************************************/
+static size_t int_vector_index_hash(const struct int_vector_index* self, const int value)
+{
+   return (size_t)(((uint64_t)(uint32_t)value * INT_VECTOR_INDEX_MULTIPLIER) >> self->shift);
+}
+
+/**************************************************************************************************
+* int_vector_index_find: Returnerar positionen (index plus 1) fr angivet vrde i angivet
+*                        hashindex. Om vrdet inte finns returneras 0.
+*
+*                        - self : Pekare till indexet.
+*                        - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+static size_t int_vector_index_find(const struct int_vector_index* self, const int value)
+{
+   if (!self->slot_count) return 0;
+   size_t slot = int_vector_index_hash(self, value);
+
+   while (self->slots[slot].position)
+   {
+      if (self->slots[slot].key == value) return self->slots[slot].position;
+      slot = (slot + 1) & (self->slot_count - 1);
+   }
+
+   return 0;
+}
@@ -0,0 +1,171 @@
+/**************************************************************************************************
+* int_vector_set.h: Mngdoperationer samt hashindex fr vektorer av typen int_vector.
+*
+*                   Mngdoperationerna frutstter att vektorerna r sorterade i stigande ordning
+*                   utan dubbletter, exempelvis via int_vector_sort fljt av
+*                   int_vector_set_unique. Union, snitt och differens berknas via sammanslagning
+*                   (merge) i linjr tid, dr iteratorerna flyttas fram via jmfrelsernas
+*                   resultat i stllet fr villkorliga hopp, vilket undviker felaktiga
+*                   hoppfrutsgelser. D den ena vektorn r betydligt mindre n den andra
+*                   anvnds i stllet galoppering (exponentiell skning fljd av binrskning) i
+*                   den strre vektorn fr varje element i den mindre, s att tidstgngen vxer
+*                   med den mindre vektorns storlek i stllet fr den strre.
+*
+*                   Hashindexet byggs ver en godtycklig (ven osorterad) vektor och ger
+*                   medlemskap samt index till ett element i konstant tid i genomsnitt, i stllet
+*                   fr linjr skning. Indexet anvnder ppen adressering med linjr sondering
+*                   och hgst hlften av platserna anvnds. Indexet avspeglar vektorns innehll d
+*                   det byggdes och mste byggas om efter att vektorn har ndrats.
+**************************************************************************************************/
+#ifndef INT_VECTOR_SET_H_
+#define INT_VECTOR_SET_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "int_vector.h"
+
+/**************************************************************************************************
+* INT_VECTOR_SET_GALLOP_RATIO: Minsta storleksfrhllande mellan vektorerna fr att galoppering
+*                              ska anvndas i stllet fr sammanslagning.
+*
+* INT_VECTOR_INDEX_MIN_SLOTS: Minsta antal platser i ett hashindex.
+**************************************************************************************************/
+#define INT_VECTOR_SET_GALLOP_RATIO 16
+#define INT_VECTOR_INDEX_MIN_SLOTS 16
+
+/**************************************************************************************************
+* int_vector_index_slot: Plats i ett hashindex, innehllande ett element samt dess index.
+**************************************************************************************************/
+struct int_vector_index_slot
+{
+   size_t position; /* Elementets index i vektorn plus 1 (0 = ledig plats). */
+   int key;         /* Elementets vrde. */
+};
+
+/**************************************************************************************************
+* int_vector_index: Hashindex med ppen adressering ver elementen i en vektor. Antalet platser
+*                   r en tvpotens, s att platsen ges av hashvrdets vre bitar.
+**************************************************************************************************/
+struct int_vector_index
+{
+   struct int_vector_index_slot* slots; /* Pekare till platserna. */
+   size_t slot_count;                   /* Antalet platser (0 eller en tvpotens). */
+   size_t count;                        /* Antalet unika element i indexet. */
+   unsigned int shift;                  /* Antalet bitar som hashvrdet skiftas. */
+   const struct allocator* allocator;   /* Allokator (null = standardallokatorn). */
+};
+
+/**************************************************************************************************
+* int_vector_set_unique: Tar bort dubbletter ur angiven sorterad vektor, s att enbart det frsta
+*                        av varje sekvens av lika element behlls. Vektorns kapacitet ndras
+*                        inte. Vid lyckad borttagning returneras 0, annars returneras felkod 1.
+*
+*                        - self: Pekare till den sorterade vektorn.
+**************************************************************************************************/
+int int_vector_set_unique(struct int_vector* self);
+
+/**************************************************************************************************
+* int_vector_set_union: Tilldelar angiven vektor unionen av tv sorterade vektorer, dvs. samtliga
+*                       element som finns i minst en av vektorerna. Destinationen fr vara samma
+*                       vektor som ngon av kllorna. Vid lyckad berkning returneras 0, annars
+*                       returneras felkod 1, varvid destinationen lmnas ofrndrad.
+*
+*                       - dest: Pekare till vektorn som ska tilldelas resultatet.
+*                       - lhs : Pekare till den frsta sorterade vektorn.
+*                       - rhs : Pekare till den andra sorterade vektorn.
+**************************************************************************************************/
+int int_vector_set_union(struct int_vector* dest,
+                         const struct int_vector* lhs,
+                         const struct int_vector* rhs);
+
+/**************************************************************************************************
+* int_vector_set_intersection: Tilldelar angiven vektor snittet av tv sorterade vektorer, dvs.
+*                              de element som finns i bda vektorerna. Destinationen fr vara
+*                              samma vektor som ngon av kllorna. Vid lyckad berkning
+*                              returneras 0, annars returneras felkod 1, varvid destinationen
+*                              lmnas ofrndrad.
+*
+*                              - dest: Pekare till vektorn som ska tilldelas resultatet.
+*                              - lhs : Pekare till den frsta sorterade vektorn.
+*                              - rhs : Pekare till den andra sorterade vektorn.
+**************************************************************************************************/
+int int_vector_set_intersection(struct int_vector* dest,
+                                const struct int_vector* lhs,
+                                const struct int_vector* rhs);
+
+/**************************************************************************************************
+* int_vector_set_difference: Tilldelar angiven vektor differensen mellan tv sorterade vektorer,
+*                            dvs. de element i lhs som inte finns i rhs. Destinationen fr vara
+*                            samma vektor som ngon av kllorna. Vid lyckad berkning returneras
+*                            0, annars returneras felkod 1, varvid destinationen lmnas
+*                            ofrndrad.
+*
+*                            - dest: Pekare till vektorn som ska tilldelas resultatet.
+*                            - lhs : Pekare till den sorterade vektorn vars element behlls.
+*                            - rhs : Pekare till den sorterade vektorn vars element tas bort.
+**************************************************************************************************/
+int int_vector_set_difference(struct int_vector* dest,
+                              const struct int_vector* lhs,
+                              const struct int_vector* rhs);
+
+/**************************************************************************************************
+* int_vector_index_init: Initierar nytt tomt hashindex.
+*
+*                        - self: Pekare till indexet som ska initieras.
+**************************************************************************************************/
+void int_vector_index_init(struct int_vector_index* self);
+
+/**************************************************************************************************
+* int_vector_index_init_with_allocator: Initierar nytt tomt hashindex, vars platser allokeras via
+*                                       angiven allokator.
+*
+*                                       - self     : Pekare till indexet som ska initieras.
+*                                       - allocator: Pekare till allokatorn (null = malloc).
+**************************************************************************************************/
+void int_vector_index_init_with_allocator(struct int_vector_index* self,
+                                          const struct allocator* allocator);
+
+/**************************************************************************************************
+* int_vector_index_clear: Frigr minnet som har allokerats fr angivet hashindex.
+*
+*                         - self: Pekare till indexet som ska tmmas.
+**************************************************************************************************/
+void int_vector_index_clear(struct int_vector_index* self);
+
+/**************************************************************************************************
+* int_vector_index_build: Bygger angivet hashindex ver elementen i angiven vektor, varvid
+*                         indexets tidigare innehll erstts. Vid dubbletter lagras index till
+*                         det frsta elementet. Vid lyckat bygge returneras 0, annars returneras
+*                         felkod 1, varvid indexet lmnas tomt.
+*
+*                         - self  : Pekare till indexet som ska byggas.
+*                         - vector: Pekare till vektorn vars element ska indexeras.
+**************************************************************************************************/
+int int_vector_index_build(struct int_vector_index* self,
+                           const struct int_vector* vector);
+
+/**************************************************************************************************
+* int_vector_index_contains: Indikerar ifall angivet vrde finns i angivet hashindex.
+*
+*                            - self : Pekare till indexet.
+*                            - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+int int_vector_index_contains(const struct int_vector_index* self,
+                              const int value);
+
+/**************************************************************************************************
+* int_vector_index_of: Tilldelar index till det frsta elementet lika med angivet vrde till
+*                      angiven variabel. Ifall vrdet finns returneras 0, annars returneras
+*                      felkod 1.
+*
+*                      - self : Pekare till indexet.
+*                      - value: Vrdet som ska skas efter.
+*                      - index: Pekare till variabeln som ska tilldelas elementets index.
+**************************************************************************************************/
+int int_vector_index_of(const struct int_vector_index* self,
+                        const int value,
+                        size_t* index);
+
+#endif /* INT_VECTOR_SET_H_ */
@@ -0,0 +1,692 @@
+/**************************************************************************************************
+* int_vector_simd.c: Innehller definitioner av reduktioner och transformationer fr vektorer av
+*                    typen int_vector, implementerade skalrt samt via SSE2 och AVX2.
+**************************************************************************************************/
+#include "int_vector_simd.h"
+#include <stdatomic.h>
+
+/**************************************************************************************************
+* INT_VECTOR_SIMD_X86: Definieras ifall SSE2- och AVX2-versionerna kan kompileras, vilket krver
+*                      en x86-processor samt en kompilator med std fr attributet target
+*                      (GCC eller Clang), s att AVX2 kan anvndas utan att hela programmet
+*                      kompileras fr AVX2.
+*
+* INT_VECTOR_SIMD_COUNT_BLOCK: Maximalt antal iterationer innan rknarna i count_if_equal tms,
+*                              s att 32-bitarsrknarna per lane aldrig slr runt.
+**************************************************************************************************/
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define INT_VECTOR_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define INT_VECTOR_SIMD_COUNT_BLOCK ((size_t)1 << 30)
+
+/**************************************************************************************************
+* int_vector_simd_selected: Vald instruktionsuppsttning, dr -1 innebr att den snabbaste
+*                           instruktionsuppsttningen som stds ska vljas vid nsta anrop.
+*                           Variabeln r atomr, eftersom funktionerna kan anropas frn flera
+*                           trdar samtidigt, exempelvis via int_vector_parallel_for.
+**************************************************************************************************/
+static atomic_int int_vector_simd_selected = -1;
+
+/* Statiska funktioner: */
+static enum int_vector_simd_level int_vector_simd_detect(void);
+static int64_t int_array_sum_scalar(const int* data, const size_t size);
+static int int_array_min_scalar(const int* data, const size_t size);
+static int int_array_max_scalar(const int* data, const size_t size);
+static size_t int_array_count_scalar(const int* data, const size_t size, const int value);
+static void int_array_add_scalar(int* data, const size_t size, const int value);
+static void int_array_mul_scalar(int* data, const size_t size, const int value);
+static void int_array_fill_step_scalar(int* data, const size_t size, const int start, const int step);
+
+#ifdef INT_VECTOR_SIMD_X86
+static int64_t int_array_sum_sse2(const int* data, const size_t size);
+static int int_array_min_sse2(const int* data, const size_t size);
+static int int_array_max_sse2(const int* data, const size_t size);
+static size_t int_array_count_sse2(const int* data, const size_t size, const int value);
+static void int_array_add_sse2(int* data, const size_t size, const int value);
+static void int_array_mul_sse2(int* data, const size_t size, const int value);
+static void int_array_fill_step_sse2(int* data, const size_t size, const int start, const int step);
+static int64_t int_array_sum_avx2(const int* data, const size_t size);
+static int int_array_min_avx2(const int* data, const size_t size);
+static int int_array_max_avx2(const int* data, const size_t size);
+static size_t int_array_count_avx2(const int* data, const size_t size, const int value);
+static void int_array_add_avx2(int* data, const size_t size, const int value);
+static void int_array_mul_avx2(int* data, const size_t size, const int value);
+static void int_array_fill_step_avx2(int* data, const size_t size, const int start, const int step);
+#endif
+
+/**************************************************************************************************
+* int_vector_simd_current: Returnerar den instruktionsuppsttning som anvnds fr tillfllet.
+**************************************************************************************************/
+enum int_vector_simd_level int_vector_simd_current(void)
+{
+   int selected = atomic_load_explicit(&int_vector_simd_selected, memory_order_relaxed);
+
+   if (selected < 0)
+   {
+      selected = (int)int_vector_simd_detect();
+      atomic_store_explicit(&int_vector_simd_selected, selected, memory_order_relaxed);
+   }
+
+   return (enum int_vector_simd_level)selected;
+}
+
+/**************************************************************************************************
+* int_vector_simd_select: Vljer vilken instruktionsuppsttning som ska anvndas. Ifall angiven
+*                         instruktionsuppsttning stds av processorn returneras 0, annars
+*                         returneras felkod 1, varvid tidigare val bibehlls.
+*
+*                         - level: Den instruktionsuppsttning som ska anvndas.
+**************************************************************************************************/
+int int_vector_simd_select(const enum int_vector_simd_level level)
+{
+   if (level > int_vector_simd_detect()) return 1;
+   atomic_store_explicit(&int_vector_simd_selected, (int)level, memory_order_relaxed);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_sum: Returnerar summan av samtliga element i angiven vektor. Summeringen sker med
+*                 64 bitar, vilket medfr att summan inte slr runt fr realistiska storlekar.
+*
+*                 - self: Pekare till vektorn vars element ska summeras.
+**************************************************************************************************/
+int64_t int_vector_sum(const struct int_vector* self)
+{
+   return int_array_sum(self->data, self->size);
+}
+
+/**************************************************************************************************
+* int_vector_min: Tilldelar det minsta elementet i angiven vektor till angiven variabel. Ifall
+*                 vektorn innehller minst ett element returneras 0, annars returneras felkod 1.
+*
+*                 - self: Pekare till vektorn som ska genomskas.
+*                 - min : Pekare till variabeln som ska tilldelas det minsta elementet.
+**************************************************************************************************/
+int int_vector_min(const struct int_vector* self,
+                   int* min)
+{
+   if (!self->size) return 1;
+
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: *min = int_array_min_avx2(self->data, self->size); break;
+      case INT_VECTOR_SIMD_SSE2: *min = int_array_min_sse2(self->data, self->size); break;
+#endif
+      default: *min = int_array_min_scalar(self->data, self->size); break;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_max: Tilldelar det strsta elementet i angiven vektor till angiven variabel. Ifall
+*                 vektorn innehller minst ett element returneras 0, annars returneras felkod 1.
+*
+*                 - self: Pekare till vektorn som ska genomskas.
+*                 - max : Pekare till variabeln som ska tilldelas det strsta elementet.
+**************************************************************************************************/
+int int_vector_max(const struct int_vector* self,
+                   int* max)
+{
+   if (!self->size) return 1;
+
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: *max = int_array_max_avx2(self->data, self->size); break;
+      case INT_VECTOR_SIMD_SSE2: *max = int_array_max_sse2(self->data, self->size); break;
+#endif
+      default: *max = int_array_max_scalar(self->data, self->size); break;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_count_if_equal: Returnerar antalet element i angiven vektor som r lika med
+*                            angivet vrde.
+*
+*                            - self : Pekare till vektorn som ska genomskas.
+*                            - value: Vrdet som elementen ska jmfras med.
+**************************************************************************************************/
+size_t int_vector_count_if_equal(const struct int_vector* self,
+                                 const int value)
+{
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: return int_array_count_avx2(self->data, self->size, value);
+      case INT_VECTOR_SIMD_SSE2: return int_array_count_sse2(self->data, self->size, value);
+#endif
+      default: return int_array_count_scalar(self->data, self->size, value);
+   }
+}
+
+/**************************************************************************************************
+* int_vector_add_scalar: Adderar angivet vrde till samtliga element i angiven vektor.
+*
+*                        - self : Pekare till vektorn vars element ska uppdateras.
+*                        - value: Vrdet som ska adderas till varje element.
+**************************************************************************************************/
+void int_vector_add_scalar(struct int_vector* self,
+                           const int value)
+{
+   if (int_vector_unshare(self)) return;
+   int_vector_mark_dirty(self, 0, self->size);
+
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: int_array_add_avx2(self->data, self->size, value); break;
+      case INT_VECTOR_SIMD_SSE2: int_array_add_sse2(self->data, self->size, value); break;
+#endif
+      default: int_array_add_scalar(self->data, self->size, value); break;
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_mul_scalar: Multiplicerar samtliga element i angiven vektor med angivet vrde.
+*
+*                        - self : Pekare till vektorn vars element ska uppdateras.
+*                        - value: Vrdet som varje element ska multipliceras med.
+**************************************************************************************************/
+void int_vector_mul_scalar(struct int_vector* self,
+                           const int value)
+{
+   if (int_vector_unshare(self)) return;
+   int_vector_mark_dirty(self, 0, self->size);
+
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: int_array_mul_avx2(self->data, self->size, value); break;
+      case INT_VECTOR_SIMD_SSE2: int_array_mul_sse2(self->data, self->size, value); break;
+#endif
+      default: int_array_mul_scalar(self->data, self->size, value); break;
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_fill_step: Tilldelar samtliga element i angiven vektor heltal rknat frn angivet
+*                       startvrde med angivet stegvrde (start, start + step...). Vektorns
+*                       storlek ndras inte, se int_vector_assign_step fr detta.
+*
+*                       - self : Pekare till vektorn som ska tilldelas.
+*                       - start: Det frsta elementets vrde.
+*                       - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+void int_vector_fill_step(struct int_vector* self,
+                          const int start,
+                          const int step)
+{
+   if (int_vector_unshare(self)) return;
+   int_vector_mark_dirty(self, 0, self->size);
+   int_array_fill_step(self->data, self->size, start, step);
+   return;
+}
+
+/**************************************************************************************************
+* int_array_sum: Returnerar summan av angivet antal heltal frn angivet flt, se int_vector_sum.
+*                Anvnds exempelvis fr att summera en del av en vektor i taget.
+*
+*                - data: Pekare till fltets frsta element.
+*                - size: Antalet element som ska summeras.
+**************************************************************************************************/
+int64_t int_array_sum(const int* data,
+                      const size_t size)
+{
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: return int_array_sum_avx2(data, size);
+      case INT_VECTOR_SIMD_SSE2: return int_array_sum_sse2(data, size);
+#endif
+      default: return int_array_sum_scalar(data, size);
+   }
+}
+
+/**************************************************************************************************
+* int_array_fill_step: Tilldelar angivet antal element i angivet flt heltal rknat frn angivet
+*                      startvrde med angivet stegvrde, se int_vector_fill_step.
+*
+*                      - data : Pekare till fltets frsta element.
+*                      - size : Antalet element som ska tilldelas.
+*                      - start: Det frsta elementets vrde.
+*                      - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+void int_array_fill_step(int* data,
+                         const size_t size,
+                         const int start,
+                         const int step)
+{
+   switch (int_vector_simd_current())
+   {
+#ifdef INT_VECTOR_SIMD_X86
+      case INT_VECTOR_SIMD_AVX2: int_array_fill_step_avx2(data, size, start, step); break;
+      case INT_VECTOR_SIMD_SSE2: int_array_fill_step_sse2(data, size, start, step); break;
+#endif
+      default: int_array_fill_step_scalar(data, size, start, step); break;
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_simd_detect: Returnerar den snabbaste instruktionsuppsttning som stds av
+*                         processorn, vilket kontrolleras via instruktionen cpuid.
+**************************************************************************************************/
+static enum int_vector_simd_level int_vector_simd_detect(void)
+{
+#ifdef INT_VECTOR_SIMD_X86
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) return INT_VECTOR_SIMD_AVX2;
+   if (__builtin_cpu_supports("sse2")) return INT_VECTOR_SIMD_SSE2;
+#endif
+   return INT_VECTOR_SIMD_SCALAR;
+}
+
+/**************************************************************************************************
+* Skalra versioner: Bearbetar ett element i taget och anvnds p processorer som saknar std
+*                    fr SSE2 och AVX2, samt fr de sista elementen som inte fyller en hel
+*                    SIMD-instruktion i vriga versioner. Addition och multiplikation sker
+*                    osignerat fr att erhlla tvkomplementsomslag.
+**************************************************************************************************/
+static int64_t int_array_sum_scalar(const int* data, const size_t size)
+{
+   int64_t sum = 0;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      sum += data[i];
+   }
+
+   return sum;
+}
+
+static int int_array_min_scalar(const int* data, const size_t size)
+{
+   int min = data[0];
+
+   for (size_t i = 1; i < size; ++i)
+   {
+      if (data[i] < min) min = data[i];
+   }
+
+   return min;
+}
+
+static int int_array_max_scalar(const int* data, const size_t size)
+{
+   int max = data[0];
+
+   for (size_t i = 1; i < size; ++i)
+   {
+      if (data[i] > max) max = data[i];
+   }
+
+   return max;
+}
+
+static size_t int_array_count_scalar(const int* data, const size_t size, const int value)
+{
+   size_t count = 0;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      count += data[i] == value;
+   }
+
+   return count;
+}
+
+static void int_array_add_scalar(int* data, const size_t size, const int value)
+{
+   for (size_t i = 0; i < size; ++i)
+   {
+      data[i] = (int)((unsigned int)data[i] + (unsigned int)value);
+   }
+
+   return;
+}
+
+static void int_array_mul_scalar(int* data, const size_t size, const int value)
+{
+   for (size_t i = 0; i < size; ++i)
+   {
+      data[i] = (int)((unsigned int)data[i] * (unsigned int)value);
+   }
+
+   return;
+}
+
+static void int_array_fill_step_scalar(int* data, const size_t size, const int start, const int step)
+{
+   unsigned int value = (unsigned int)start;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      data[i] = (int)value;
+      value += (unsigned int)step;
+   }
+
+   return;
+}
+
+#ifdef INT_VECTOR_SIMD_X86
+
+/**************************************************************************************************
+* SSE2-versioner: Bearbetar fyra heltal per instruktion. SSE2 saknar instruktioner fr min/max
+*                 och multiplikation av 32-bitars heltal, vilka drfr utfrs via jmfrelser
+*                 och maskning respektive tv 64-bitars multiplikationer av jmna och udda
+*                 lanes. Vid summering teckenutkas heltalen till 64 bitar innan additionen.
+*                 terstende element som inte fyller en hel instruktion bearbetas skalrt.
+**************************************************************************************************/
+static int64_t int_array_sum_sse2(const int* data, const size_t size)
+{
+   __m128i sum = _mm_setzero_si128();
+   size_t i = 0;
+
+   for (; i + 4 <= size; i += 4)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(data + i));
+      const __m128i sign = _mm_srai_epi32(x, 31);
+      sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(x, sign));
+      sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(x, sign));
+   }
+
+   int64_t lanes[2];
+   _mm_storeu_si128((__m128i*)lanes, sum);
+   return lanes[0] + lanes[1] + int_array_sum_scalar(data + i, size - i);
+}
+
+static int int_array_min_sse2(const int* data, const size_t size)
+{
+   if (size < 4) return int_array_min_scalar(data, size);
+   __m128i min = _mm_loadu_si128((const __m128i*)data);
+   size_t i = 4;
+
+   for (; i + 4 <= size; i += 4)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(data + i));
+      const __m128i greater = _mm_cmpgt_epi32(min, x);
+      min = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, min));
+   }
+
+   int lanes[4];
+   _mm_storeu_si128((__m128i*)lanes, min);
+   int result = int_array_min_scalar(lanes, 4);
+   if (i < size)
+   {
+      const int tail = int_array_min_scalar(data + i, size - i);
+      if (tail < result) result = tail;
+   }
+
+   return result;
+}
+
+static int int_array_max_sse2(const int* data, const size_t size)
+{
+   if (size < 4) return int_array_max_scalar(data, size);
+   __m128i max = _mm_loadu_si128((const __m128i*)data);
+   size_t i = 4;
+
+   for (; i + 4 <= size; i += 4)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(data + i));
+      const __m128i greater = _mm_cmpgt_epi32(x, max);
+      max = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, max));
+   }
+
+   int lanes[4];
+   _mm_storeu_si128((__m128i*)lanes, max);
+   int result = int_array_max_scalar(lanes, 4);
+   if (i < size)
+   {
+      const int tail = int_array_max_scalar(data + i, size - i);
+      if (tail > result) result = tail;
+   }
+
+   return result;
+}
+
+static size_t int_array_count_sse2(const int* data, const size_t size, const int value)
+{
+   const __m128i target = _mm_set1_epi32(value);
+   size_t count = 0;
+   size_t i = 0;
+
+   while (i + 4 <= size)
+   {
+      const size_t block_end = size - i > INT_VECTOR_SIMD_COUNT_BLOCK * 4 ? 
+                               i + INT_VECTOR_SIMD_COUNT_BLOCK * 4 : size;
+      __m128i counts = _mm_setzero_si128();
+
+      for (; i + 4 <= block_end; i += 4)
+      {
+         const __m128i x = _mm_loadu_si128((const __m128i*)(data + i));
+         counts = _mm_sub_epi32(counts, _mm_cmpeq_epi32(x, target));
+      }
+
+      uint32_t lanes[4];
+      _mm_storeu_si128((__m128i*)lanes, counts);
+      count += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+   }
+
+   return count + int_array_count_scalar(data + i, size - i, value);
+}
+
+static void int_array_add_sse2(int* data, const size_t size, const int value)
+{
+   const __m128i addend = _mm_set1_epi32(value);
+   size_t i = 0;
+
+   for (; i + 4 <= size; i += 4)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(data + i));
+      _mm_storeu_si128((__m128i*)(data + i), _mm_add_epi32(x, addend));
+   }
+
+   int_array_add_scalar(data + i, size - i, value);
+   return;
+}
+
+static void int_array_mul_sse2(int* data, const size_t size, const int value)
+{
+   const __m128i factor = _mm_set1_epi32(value);
+   size_t i = 0;
+
+   for (; i + 4 <= size; i += 4)
+   {
+      const __m128i x = _mm_loadu_si128((const __m128i*)(data + i));
+      const __m128i even = _mm_mul_epu32(x, factor);
+      const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), factor);
+      const __m128i product = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                                 _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+      _mm_storeu_si128((__m128i*)(data + i), product);
+   }
+
+   int_array_mul_scalar(data + i, size - i, value);
+   return;
+}
+
+static void int_array_fill_step_sse2(int* data, const size_t size, const int start, const int step)
+{
+   const unsigned int s = (unsigned int)start;
+   const unsigned int d = (unsigned int)step;
+   __m128i value = _mm_setr_epi32((int)s, (int)(s + d), (int)(s + 2 * d), (int)(s + 3 * d));
+   const __m128i increment = _mm_set1_epi32((int)(4 * d));
+   size_t i = 0;
+
+   for (; i + 4 <= size; i += 4)
+   {
+      _mm_storeu_si128((__m128i*)(data + i), value);
+      value = _mm_add_epi32(value, increment);
+   }
+
+   int_array_fill_step_scalar(data + i, size - i, (int)(s + (unsigned int)i * d), step);
+   return;
+}
+
+/**************************************************************************************************
+* AVX2-versioner: Bearbetar tta heltal per instruktion. Funktionerna kompileras fr AVX2 via
+*                 attributet target och anropas enbart ifall processorn stder AVX2.
+*                 terstende element som inte fyller en hel instruktion bearbetas skalrt.
+**************************************************************************************************/
+__attribute__((target("avx2")))
+static int64_t int_array_sum_avx2(const int* data, const size_t size)
+{
+   __m256i sum = _mm256_setzero_si256();
+   size_t i = 0;
+
+   for (; i + 8 <= size; i += 8)
+   {
+      const __m256i x = _mm256_loadu_si256((const __m256i*)(data + i));
+      sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+      sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+   }
+
+   int64_t lanes[4];
+   _mm256_storeu_si256((__m256i*)lanes, sum);
+   return lanes[0] + lanes[1] + lanes[2] + lanes[3] + int_array_sum_scalar(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static int int_array_min_avx2(const int* data, const size_t size)
+{
+   if (size < 8) return int_array_min_scalar(data, size);
+   __m256i min = _mm256_loadu_si256((const __m256i*)data);
+   size_t i = 8;
+
+   for (; i + 8 <= size; i += 8)
+   {
+      min = _mm256_min_epi32(min, _mm256_loadu_si256((const __m256i*)(data + i)));
+   }
+
+   int lanes[8];
+   _mm256_storeu_si256((__m256i*)lanes, min);
+   int result = int_array_min_scalar(lanes, 8);
+   if (i < size)
+   {
+      const int tail = int_array_min_scalar(data + i, size - i);
+      if (tail < result) result = tail;
+   }
+
+   return result;
+}
+
+__attribute__((target("avx2")))
+static int int_array_max_avx2(const int* data, const size_t size)
+{
+   if (size < 8) return int_array_max_scalar(data, size);
+   __m256i max = _mm256_loadu_si256((const __m256i*)data);
+   size_t i = 8;
+
+   for (; i + 8 <= size; i += 8)
+   {
+      max = _mm256_max_epi32(max, _mm256_loadu_si256((const __m256i*)(data + i)));
+   }
+
+   int lanes[8];
+   _mm256_storeu_si256((__m256i*)lanes, max);
+   int result = int_array_max_scalar(lanes, 8);
+   if (i < size)
+   {
+      const int tail = int_array_max_scalar(data + i, size - i);
+      if (tail > result) result = tail;
+   }
+
+   return result;
+}
+
+__attribute__((target("avx2")))
+static size_t int_array_count_avx2(const int* data, const size_t size, const int value)
+{
+   const __m256i target = _mm256_set1_epi32(value);
+   size_t count = 0;
+   size_t i = 0;
+
+   while (i + 8 <= size)
+   {
+      const size_t block_end = size - i > INT_VECTOR_SIMD_COUNT_BLOCK * 8 ? 
+                               i + INT_VECTOR_SIMD_COUNT_BLOCK * 8 : size;
+      __m256i counts = _mm256_setzero_si256();
+
+      for (; i + 8 <= block_end; i += 8)
+      {
+         const __m256i x = _mm256_loadu_si256((const __m256i*)(data + i));
+         counts = _mm256_sub_epi32(counts, _mm256_cmpeq_epi32(x, target));
+      }
+
+      uint32_t lanes[8];
+      _mm256_storeu_si256((__m256i*)lanes, counts);
+
+      for (size_t j = 0; j < 8; ++j)
+      {
+         count += lanes[j];
+      }
+   }
+
+   return count + int_array_count_scalar(data + i, size - i, value);
+}
+
+__attribute__((target("avx2")))
+static void int_array_add_avx2(int* data, const size_t size, const int value)
+{
+   const __m256i addend = _mm256_set1_epi32(value);
+   size_t i = 0;
+
+   for (; i + 8 <= size; i += 8)
+   {
+      const __m256i x = _mm256_loadu_si256((const __m256i*)(data + i));
+      _mm256_storeu_si256((__m256i*)(data + i), _mm256_add_epi32(x, addend));
+   }
+
+   int_array_add_scalar(data + i, size - i, value);
+   return;
+}
+
+__attribute__((target("avx2")))
+static void int_array_mul_avx2(int* data, const size_t size, const int value)
+{
+   const __m256i factor = _mm256_set1_epi32(value);
+   size_t i = 0;
+
+   for (; i + 8 <= size; i += 8)
+   {
+      const __m256i x = _mm256_loadu_si256((const __m256i*)(data + i));
+      _mm256_storeu_si256((__m256i*)(data + i), _mm256_mullo_epi32(x, factor));
+   }
+
+   int_array_mul_scalar(data + i, size - i, value);
+   return;
+}
+
+__attribute__((target("avx2")))
+static void int_array_fill_step_avx2(int* data, const size_t size, const int start, const int step)
+{
+   const unsigned int s = (unsigned int)start;
+   const unsigned int d = (unsigned int)step;
+   __m256i value = _mm256_setr_epi32((int)s, (int)(s + d), (int)(s + 2 * d), (int)(s + 3 * d),
+                                     (int)(s + 4 * d), (int)(s + 5 * d), (int)(s + 6 * d), 
+                                     (int)(s + 7 * d));
+   const __m256i increment = _mm256_set1_epi32((int)(8 * d));
+   size_t i = 0;
+
+   for (; i + 8 <= size; i += 8)
+   {
+      _mm256_storeu_si256((__m256i*)(data + i), value);
+      value = _mm256_add_epi32(value, increment);
+   }
+
+   int_array_fill_step_scalar(data + i, size - i, (int)(s + (unsigned int)i * d), step);
+   return;
+}
+
+#endif /* INT_VECTOR_SIMD_X86 */
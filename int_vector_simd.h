@@ -0,0 +1,140 @@
+/**************************************************************************************************
+* int_vector_simd.h: Reduktioner (summa, min, max, antal) samt elementvisa transformationer fr
+*                    vektorer av typen int_vector. Varje funktion finns i en skalr version samt
+*                    i versioner fr instruktionsuppsttningarna SSE2 (fyra heltal per instruktion)
+*                    och AVX2 (tta heltal per instruktion). Den snabbaste versionen som stds av
+*                    processorn vljs automatiskt vid krning, men kan ven vljas manuellt via
+*                    int_vector_simd_select, exempelvis fr att jmfra versionerna med varandra.
+*
+*                    Aritmetik sker med tvkomplementsomslag, dvs. ett resultat som inte ryms i
+*                    en int slr runt i stllet fr att medfra odefinierat beteende.
+*
+*                    Transformationerna kopierar frst ett flt som delas med andra vektorer, se
+*                    int_vector_share. Ifall kopieringen misslyckas lmnas vektorn ofrndrad.
+**************************************************************************************************/
+#ifndef INT_VECTOR_SIMD_H_
+#define INT_VECTOR_SIMD_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdint.h>
+#include "int_vector.h"
+
+/**************************************************************************************************
+* int_vector_simd_level: Instruktionsuppsttningar som funktionerna kan anvnda, ordnade frn
+*                        lngsammast till snabbast.
+**************************************************************************************************/
+enum int_vector_simd_level
+{
+   INT_VECTOR_SIMD_SCALAR, /* Skalr version, fungerar p samtliga processorer. */
+   INT_VECTOR_SIMD_SSE2,   /* SSE2, fyra heltal per instruktion. */
+   INT_VECTOR_SIMD_AVX2    /* AVX2, tta heltal per instruktion. */
+};
+
+/**************************************************************************************************
+* int_vector_simd_current: Returnerar den instruktionsuppsttning som anvnds fr tillfllet.
+**************************************************************************************************/
+enum int_vector_simd_level int_vector_simd_current(void);
+
+/**************************************************************************************************
+* int_vector_simd_select: Vljer vilken instruktionsuppsttning som ska anvndas. Ifall angiven
+*                         instruktionsuppsttning stds av processorn returneras 0, annars
+*                         returneras felkod 1, varvid tidigare val bibehlls.
+*
+*                         - level: Den instruktionsuppsttning som ska anvndas.
+**************************************************************************************************/
+int int_vector_simd_select(const enum int_vector_simd_level level);
+
+/**************************************************************************************************
+* int_vector_sum: Returnerar summan av samtliga element i angiven vektor. Summeringen sker med
+*                 64 bitar, vilket medfr att summan inte slr runt fr realistiska storlekar.
+*
+*                 - self: Pekare till vektorn vars element ska summeras.
+**************************************************************************************************/
+int64_t int_vector_sum(const struct int_vector* self);
+
+/**************************************************************************************************
+* int_vector_min: Tilldelar det minsta elementet i angiven vektor till angiven variabel. Ifall
+*                 vektorn innehller minst ett element returneras 0, annars returneras felkod 1.
+*
+*                 - self: Pekare till vektorn som ska genomskas.
+*                 - min : Pekare till variabeln som ska tilldelas det minsta elementet.
+**************************************************************************************************/
+int int_vector_min(const struct int_vector* self,
+                   int* min);
+
+/**************************************************************************************************
+* int_vector_max: Tilldelar det strsta elementet i angiven vektor till angiven variabel. Ifall
+*                 vektorn innehller minst ett element returneras 0, annars returneras felkod 1.
+*
+*                 - self: Pekare till vektorn som ska genomskas.
+*                 - max : Pekare till variabeln som ska tilldelas det strsta elementet.
+**************************************************************************************************/
+int int_vector_max(const struct int_vector* self,
+                   int* max);
+
+/**************************************************************************************************
+* int_vector_count_if_equal: Returnerar antalet element i angiven vektor som r lika med
+*                            angivet vrde.
+*
+*                            - self : Pekare till vektorn som ska genomskas.
+*                            - value: Vrdet som elementen ska jmfras med.
+**************************************************************************************************/
+size_t int_vector_count_if_equal(const struct int_vector* self,
+                                 const int value);
+
+/**************************************************************************************************
+* int_vector_add_scalar: Adderar angivet vrde till samtliga element i angiven vektor.
+*
+*                        - self : Pekare till vektorn vars element ska uppdateras.
+*                        - value: Vrdet som ska adderas till varje element.
+**************************************************************************************************/
+void int_vector_add_scalar(struct int_vector* self,
+                           const int value);
+
+/**************************************************************************************************
+* int_vector_mul_scalar: Multiplicerar samtliga element i angiven vektor med angivet vrde.
+*
+*                        - self : Pekare till vektorn vars element ska uppdateras.
+*                        - value: Vrdet som varje element ska multipliceras med.
+**************************************************************************************************/
+void int_vector_mul_scalar(struct int_vector* self,
+                           const int value);
+
+/**************************************************************************************************
+* int_vector_fill_step: Tilldelar samtliga element i angiven vektor heltal rknat frn angivet
+*                       startvrde med angivet stegvrde (start, start + step...). Vektorns
+*                       storlek ndras inte, se int_vector_assign_step fr detta.
+*
+*                       - self : Pekare till vektorn som ska tilldelas.
+*                       - start: Det frsta elementets vrde.
+*                       - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+void int_vector_fill_step(struct int_vector* self,
+                          const int start,
+                          const int step);
+
+/**************************************************************************************************
+* int_array_sum: Returnerar summan av angivet antal heltal frn angivet flt, se int_vector_sum.
+*                Anvnds exempelvis fr att summera en del av en vektor i taget.
+*
+*                - data: Pekare till fltets frsta element.
+*                - size: Antalet element som ska summeras.
+**************************************************************************************************/
+int64_t int_array_sum(const int* data,
+                      const size_t size);
+
+/**************************************************************************************************
+* int_array_fill_step: Tilldelar angivet antal element i angivet flt heltal rknat frn angivet
+*                      startvrde med angivet stegvrde, se int_vector_fill_step.
+*
+*                      - data : Pekare till fltets frsta element.
+*                      - size : Antalet element som ska tilldelas.
+*                      - start: Det frsta elementets vrde.
+*                      - step : Stegvrdet, dvs. differensen mellan varje element.
+**************************************************************************************************/
+void int_array_fill_step(int* data,
+                         const size_t size,
+                         const int start,
+                         const int step);
+
+#endif /* INT_VECTOR_SIMD_H_ */
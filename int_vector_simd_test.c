@@ -0,0 +1,313 @@
+/**************************************************************************************************
+* int_vector_simd_test.c: Test av funktionerna i "int_vector_simd.h", dr samtliga versioner som
+*                         stds av processorn (SSE2, AVX2) jmfrs med den skalra versionen.
+*                         Testet krs fr samtliga storlekar frn 0 till INT_VECTOR_SIMD_TEST_MAX
+*                         element samt en stor udda storlek, s att samtliga svanslngder efter
+*                         de breda instruktionerna prvas. Elementen r slumpmssiga, dels ver
+*                         hela vrdeintervallet fr int, dels inom ett litet intervall s att
+*                         mnga element r lika. Funktionerna fr flt prvas ven med en
+*                         startadress som inte r justerad.
+*
+*                         Testet krs via CTest (ctest --test-dir build). Vid fel skrivs
+*                         felaktiga fall ut via stderr och programmet avslutas med felkod 1.
+**************************************************************************************************/
+
+/* Inkluderingsdirektiv: */
+#include <limits.h>
+#include "int_vector_simd.h"
+
+/**************************************************************************************************
+* INT_VECTOR_SIMD_TEST_MAX: Den strsta storleken som testas i fljd frn 0.
+*
+* INT_VECTOR_SIMD_TEST_LARGE: Stor udda storlek som testas utver de mindre storlekarna.
+*
+* INT_VECTOR_SIMD_TEST_OFFSETS: Antalet startadresser som testas fr funktionerna fr flt.
+**************************************************************************************************/
+#define INT_VECTOR_SIMD_TEST_MAX 70
+#define INT_VECTOR_SIMD_TEST_LARGE 100003
+#define INT_VECTOR_SIMD_TEST_OFFSETS 4
+
+/* Statiska funktioner: */
+static uint32_t int_vector_simd_test_random(uint32_t* state);
+static int int_vector_simd_test_fill(struct int_vector* self,
+                                     const size_t size,
+                                     const int narrow,
+                                     uint32_t* state);
+static int int_vector_simd_test_equal(const struct int_vector* lhs,
+                                      const struct int_vector* rhs);
+static int int_vector_simd_test_reductions(const struct int_vector* self,
+                                           const enum int_vector_simd_level level);
+static int int_vector_simd_test_transforms(const struct int_vector* self,
+                                           const enum int_vector_simd_level level);
+static int int_vector_simd_test_arrays(const struct int_vector* self,
+                                       const enum int_vector_simd_level level);
+static int int_vector_simd_test_size(const size_t size,
+                                     const enum int_vector_simd_level level,
+                                     uint32_t* state);
+
+/* Namn p instruktionsuppsttningarna, indexerade via enum int_vector_simd_level. */
+static const char* const int_vector_simd_test_names[] = { "scalar", "sse2", "avx2" };
+
+/**************************************************************************************************
+* main: Jmfr samtliga instruktionsuppsttningar som stds med den skalra versionen.
+**************************************************************************************************/
+int main(void)
+{
+   const enum int_vector_simd_level original = int_vector_simd_current();
+   const enum int_vector_simd_level levels[] = { INT_VECTOR_SIMD_SSE2, INT_VECTOR_SIMD_AVX2 };
+   int error = 0;
+
+   for (size_t i = 0; i < sizeof(levels) / sizeof(*levels); ++i)
+   {
+      uint32_t state = 12345;
+
+      if (int_vector_simd_select(levels[i]))
+      {
+         printf("%s: stds inte, hoppar ver\n", int_vector_simd_test_names[levels[i]]);
+         continue;
+      }
+
+      for (size_t size = 0; size <= INT_VECTOR_SIMD_TEST_MAX; ++size)
+      {
+         error |= int_vector_simd_test_size(size, levels[i], &state);
+      }
+
+      error |= int_vector_simd_test_size(INT_VECTOR_SIMD_TEST_LARGE, levels[i], &state);
+      printf("%s: %s\n", int_vector_simd_test_names[levels[i]], error ? "fel" : "ok");
+   }
+
+   int_vector_simd_select(original);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_random: Returnerar nsta slumptal frn angivet tillstnd (xorshift32).
+*
+*                              - state: Pekare till slumpgeneratorns tillstnd (skilt frn 0).
+**************************************************************************************************/
+static uint32_t int_vector_simd_test_random(uint32_t* state)
+{
+   *state ^= *state << 13;
+   *state ^= *state >> 17;
+   *state ^= *state << 5;
+   return *state;
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_fill: Stter angiven vektors storlek och tilldelar elementen slumptal,
+*                            antingen ver hela vrdeintervallet eller inom intervallet -4 till
+*                            4. Vid lyckad tilldelning returneras 0, annars returneras felkod 1.
+*
+*                            - self  : Pekare till vektorn som ska tilldelas.
+*                            - size  : Vektorns nya storlek.
+*                            - narrow: Indikerar ifall elementen ska ligga inom det lilla
+*                                      intervallet.
+*                            - state : Pekare till slumpgeneratorns tillstnd.
+**************************************************************************************************/
+static int int_vector_simd_test_fill(struct int_vector* self,
+                                     const size_t size,
+                                     const int narrow,
+                                     uint32_t* state)
+{
+   if (int_vector_resize(self, size)) return 1;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      const uint32_t value = int_vector_simd_test_random(state);
+      self->data[i] = narrow ? (int)(value % 9) - 4 : (int)(int32_t)value;
+   }
+
+   if (!narrow && size >= 2)
+   {
+      self->data[int_vector_simd_test_random(state) % size] = INT_MIN;
+      self->data[int_vector_simd_test_random(state) % size] = INT_MAX;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_equal: Indikerar ifall angivna vektorer har samma storlek och innehll.
+*
+*                             - lhs: Pekare till den frsta vektorn.
+*                             - rhs: Pekare till den andra vektorn.
+**************************************************************************************************/
+static int int_vector_simd_test_equal(const struct int_vector* lhs,
+                                      const struct int_vector* rhs)
+{
+   return lhs->size == rhs->size && !memcmp(lhs->data, rhs->data, sizeof(int) * lhs->size);
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_reductions: Jmfr int_vector_sum, int_vector_min, int_vector_max samt
+*                                  int_vector_count_if_equal fr angiven instruktionsuppsttning
+*                                  med den skalra versionen. Ifall resultaten r lika
+*                                  returneras 0, annars returneras felkod 1.
+*
+*                                  - self : Pekare till vektorn som ska testas.
+*                                  - level: Instruktionsuppsttningen som ska testas.
+**************************************************************************************************/
+static int int_vector_simd_test_reductions(const struct int_vector* self,
+                                           const enum int_vector_simd_level level)
+{
+   const int value = self->size ? self->data[self->size / 2] : 0;
+   int expected_min = 0, expected_max = 0, min = 0, max = 0;
+
+   int_vector_simd_select(INT_VECTOR_SIMD_SCALAR);
+   const int64_t expected_sum = int_vector_sum(self);
+   const int expected_min_error = int_vector_min(self, &expected_min);
+   const int expected_max_error = int_vector_max(self, &expected_max);
+   const size_t expected_count = int_vector_count_if_equal(self, value);
+
+   int_vector_simd_select(level);
+   const int64_t sum = int_vector_sum(self);
+   const int min_error = int_vector_min(self, &min);
+   const int max_error = int_vector_max(self, &max);
+   const size_t count = int_vector_count_if_equal(self, value);
+
+   if (sum != expected_sum || min_error != expected_min_error || min != expected_min ||
+       max_error != expected_max_error || max != expected_max || count != expected_count)
+   {
+      fprintf(stderr, "%s: reduktion fel fr %zu element (summa %lld/%lld, min %d/%d, "
+              "max %d/%d, antal %zu/%zu)\n", int_vector_simd_test_names[level], self->size,
+              (long long)sum, (long long)expected_sum, min, expected_min, max, expected_max,
+              count, expected_count);
+      return 1;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_transforms: Jmfr int_vector_add_scalar, int_vector_mul_scalar samt
+*                                  int_vector_fill_step fr angiven instruktionsuppsttning med
+*                                  den skalra versionen, med vrden som slr runt. Ifall
+*                                  resultaten r lika returneras 0, annars returneras felkod 1.
+*
+*                                  - self : Pekare till vektorn som ska testas, som inte ndras.
+*                                  - level: Instruktionsuppsttningen som ska testas.
+**************************************************************************************************/
+static int int_vector_simd_test_transforms(const struct int_vector* self,
+                                           const enum int_vector_simd_level level)
+{
+   struct int_vector expected, actual;
+   int error = 0;
+   int_vector_init(&expected);
+   int_vector_init(&actual);
+
+   for (int operation = 0; operation < 3 && !error; ++operation)
+   {
+      if (int_vector_clone(&expected, self) || int_vector_clone(&actual, self))
+      {
+         error = 1;
+         break;
+      }
+
+      for (int pass = 0; pass < 2; ++pass)
+      {
+         struct int_vector* vector = pass ? &actual : &expected;
+         int_vector_simd_select(pass ? level : INT_VECTOR_SIMD_SCALAR);
+
+         switch (operation)
+         {
+            case 0: int_vector_add_scalar(vector, INT_MAX - 2); break;
+            case 1: int_vector_mul_scalar(vector, -40503); break;
+            default: int_vector_fill_step(vector, INT_MAX - 100, 7919); break;
+         }
+      }
+
+      if (!int_vector_simd_test_equal(&expected, &actual))
+      {
+         static const char* const names[] = { "add_scalar", "mul_scalar", "fill_step" };
+         fprintf(stderr, "%s: %s fel fr %zu element\n", int_vector_simd_test_names[level],
+                 names[operation], self->size);
+         error = 1;
+      }
+   }
+
+   int_vector_clear(&expected);
+   int_vector_clear(&actual);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_arrays: Jmfr int_array_sum samt int_array_fill_step fr angiven
+*                              instruktionsuppsttning med den skalra versionen, med brjan p
+*                              varje startadress inom de frsta INT_VECTOR_SIMD_TEST_OFFSETS
+*                              elementen, s att ven flt som inte r justerade prvas. Ifall
+*                              resultaten r lika returneras 0, annars returneras felkod 1.
+*
+*                              - self : Pekare till vektorn som ska testas, som inte ndras.
+*                              - level: Instruktionsuppsttningen som ska testas.
+**************************************************************************************************/
+static int int_vector_simd_test_arrays(const struct int_vector* self,
+                                       const enum int_vector_simd_level level)
+{
+   struct int_vector expected, actual;
+   int error = 0;
+   int_vector_init(&expected);
+   int_vector_init(&actual);
+
+   if (int_vector_clone(&expected, self) || int_vector_clone(&actual, self)) error = 1;
+
+   for (size_t offset = 0; !error && offset < INT_VECTOR_SIMD_TEST_OFFSETS; ++offset)
+   {
+      if (offset > self->size) break;
+      const size_t size = self->size - offset;
+
+      int_vector_simd_select(INT_VECTOR_SIMD_SCALAR);
+      const int64_t expected_sum = int_array_sum(self->data + offset, size);
+      int_array_fill_step(expected.data + offset, size, -3, INT_MIN + 1);
+
+      int_vector_simd_select(level);
+      const int64_t sum = int_array_sum(self->data + offset, size);
+      int_array_fill_step(actual.data + offset, size, -3, INT_MIN + 1);
+
+      if (sum != expected_sum || !int_vector_simd_test_equal(&expected, &actual))
+      {
+         fprintf(stderr, "%s: int_array_* fel fr %zu element med start p index %zu\n",
+                 int_vector_simd_test_names[level], size, offset);
+         error = 1;
+      }
+   }
+
+   int_vector_clear(&expected);
+   int_vector_clear(&actual);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_simd_test_size: Testar angiven instruktionsuppsttning fr vektorer av angiven
+*                            storlek, bde med element ver hela vrdeintervallet och inom ett
+*                            litet intervall. Ifall samtliga resultat r lika med den skalra
+*                            versionens returneras 0, annars returneras felkod 1.
+*
+*                            - size : Vektorernas storlek.
+*                            - level: Instruktionsuppsttningen som ska testas.
+*                            - state: Pekare till slumpgeneratorns tillstnd.
+**************************************************************************************************/
+static int int_vector_simd_test_size(const size_t size,
+                                     const enum int_vector_simd_level level,
+                                     uint32_t* state)
+{
+   struct int_vector vector;
+   int error = 0;
+   int_vector_init(&vector);
+
+   for (int narrow = 0; narrow < 2; ++narrow)
+   {
+      if (int_vector_simd_test_fill(&vector, size, narrow, state))
+      {
+         fprintf(stderr, "Allokering av %zu element misslyckades\n", size);
+         error = 1;
+         break;
+      }
+
+      error |= int_vector_simd_test_reductions(&vector, level);
+      error |= int_vector_simd_test_transforms(&vector, level);
+      error |= int_vector_simd_test_arrays(&vector, level);
+   }
+
+   int_vector_clear(&vector);
+   return error;
+}
@@ -0,0 +1,404 @@
+/**************************************************************************************************
+* int_vector_sort.c: Innehller definitioner av funktioner fr sortering och skning i vektorer
+*                    av typen int_vector via radixsortering respektive binrskning.
+**************************************************************************************************/
+#include "int_vector_sort.h"
+#include "thread_pool.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/**************************************************************************************************
+* INT_VECTOR_SORT_RADIX: Antalet mjliga vrden per siffra, dr varje siffra utgrs av en byte.
+*
+* INT_VECTOR_SORT_PASSES: Antalet sorteringssteg, ett per byte i ett 32-bitars heltal.
+*
+* INT_VECTOR_SORT_INSERTION_LIMIT: Vektorer med hgst detta antal element sorteras via
+*                                  insttningssortering, vilket r snabbare fr sm vektorer.
+*
+* INT_VECTOR_SORT_PARALLEL_MIN: Minsta antal element per trd vid parallell sortering.
+*
+* INT_VECTOR_SORT_MAX_THREADS: Maximalt antal trdar vid parallell sortering.
+**************************************************************************************************/
+#define INT_VECTOR_SORT_RADIX 256
+#define INT_VECTOR_SORT_PASSES 4
+#define INT_VECTOR_SORT_INSERTION_LIMIT 64
+#define INT_VECTOR_SORT_PARALLEL_MIN (64 * 1024)
+#define INT_VECTOR_SORT_MAX_THREADS 64
+
+/**************************************************************************************************
+* int_vector_sort_task: Den del av vektorn som en trd ansvarar fr vid parallell sortering,
+*                       samt trdens histogram och startpositioner fr aktuellt steg.
+**************************************************************************************************/
+struct int_vector_sort_task
+{
+   const int* src;                         /* Pekare till fltet som lses i aktuellt steg. */
+   int* dst;                               /* Pekare till fltet som skrivs i aktuellt steg. */
+   size_t first;                           /* Index till trdens frsta element. */
+   size_t last;                            /* Index direkt efter trdens sista element. */
+   unsigned int shift;                     /* Antalet bitar som nyckeln skiftas i aktuellt steg. */
+   size_t counts[INT_VECTOR_SORT_RADIX];   /* Antalet element per siffra i trdens del. */
+   size_t offsets[INT_VECTOR_SORT_RADIX];  /* Startposition per siffra i destinationen. */
+};
+
+/**************************************************************************************************
+* int_vector_sort_batch: Uppgifterna i ett steg samt funktionen som ska kras fr var och en,
+*                        vilka passeras till trdpoolen som kontext.
+**************************************************************************************************/
+struct int_vector_sort_batch
+{
+   struct int_vector_sort_task* tasks; /* Pekare till fltet innehllande uppgifterna. */
+   void* (*function)(void*);           /* Funktionen som ska kras fr varje uppgift. */
+};
+
+/* Statiska funktioner: */
+static unsigned int int_vector_sort_digit(const int value, const unsigned int shift);
+static void int_vector_sort_insertion(int* data, const size_t size);
+#ifndef _WIN32
+static void* int_vector_sort_count(void* arg);
+static void* int_vector_sort_scatter(void* arg);
+static void int_vector_sort_run(struct int_vector_sort_task* tasks,
+                                const size_t task_count,
+                                void* (*function)(void*));
+static void int_vector_sort_dispatch(void* context, size_t task);
+#endif
+
+/**************************************************************************************************
+* int_vector_sort: Sorterar elementen i angiven vektor i stigande ordning. Ett temporrt flt
+*                  lika stort som vektorn allokeras via standardallokatorn (malloc) i stllet
+*                  fr vektorns allokator, eftersom fltet enbart behvs under sorteringen och
+*                  annars exempelvis skulle bli kvar i en arena. Vid lyckad sortering returneras
+*                  0, annars returneras felkod 1, varvid vektorn lmnas osorterad och inte
+*                  markeras som ndrad.
+*
+*                  Histogrammen fr samtliga steg berknas i en enda genomlsning. Steg dr
+*                  samtliga element har samma siffra hoppas ver, exempelvis de mest signifikanta
+*                  byten fr vektorer som enbart innehller sm tal.
+*
+*                  - self: Pekare till vektorn som ska sorteras.
+**************************************************************************************************/
+int int_vector_sort(struct int_vector* self)
+{
+   if (int_vector_unshare(self)) return 1;
+   const size_t size = self->size;
+   size_t counts[INT_VECTOR_SORT_PASSES][INT_VECTOR_SORT_RADIX] = { { 0 } };
+
+   if (size <= INT_VECTOR_SORT_INSERTION_LIMIT)
+   {
+      int_vector_mark_dirty(self, 0, size);
+      int_vector_sort_insertion(self->data, size);
+      return 0;
+   }
+
+   int* temp = (int*)allocator_allocate(0, sizeof(int) * size);
+   if (!temp) return 1;
+   int_vector_mark_dirty(self, 0, size);
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      for (unsigned int pass = 0; pass < INT_VECTOR_SORT_PASSES; ++pass)
+      {
+         counts[pass][int_vector_sort_digit(self->data[i], pass * 8)]++;
+      }
+   }
+
+   int* src = self->data;
+   int* dst = temp;
+
+   for (unsigned int pass = 0; pass < INT_VECTOR_SORT_PASSES; ++pass)
+   {
+      size_t offsets[INT_VECTOR_SORT_RADIX];
+      size_t offset = 0;
+      if (counts[pass][int_vector_sort_digit(src[0], pass * 8)] == size) continue;
+
+      for (size_t digit = 0; digit < INT_VECTOR_SORT_RADIX; ++digit)
+      {
+         offsets[digit] = offset;
+         offset += counts[pass][digit];
+      }
+
+      for (size_t i = 0; i < size; ++i)
+      {
+         dst[offsets[int_vector_sort_digit(src[i], pass * 8)]++] = src[i];
+      }
+
+      int* swap = src;
+      src = dst;
+      dst = swap;
+   }
+
+   if (src != self->data) memcpy(self->data, src, sizeof(int) * size);
+   allocator_deallocate(0, temp, sizeof(int) * size);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_sort_parallel: Sorterar elementen i angiven vektor i stigande ordning med angivet
+*                           antal delar, vilka krs via den globala trdpoolen. Mindre vektorer
+*                           sorteras av den anropande trden, d kostnaden fr att frdela
+*                           arbetet ver trdarna annars verstiger vinsten. Vid lyckad
+*                           sortering returneras 0, annars returneras felkod 1, varvid vektorn
+*                           lmnas osorterad. Uppgifterna, med tv histogram per trd, allokeras
+*                           tillsammans med det temporra fltet via standardallokatorn i stllet
+*                           fr p stacken, se int_vector_sort.
+*
+*                           Varje steg genomfrs i tv faser. Frst berknar varje trd ett
+*                           histogram fr sin del av vektorn, varefter startpositionen fr varje
+*                           siffra och trd berknas, s att trdarna sedan kan flytta sina
+*                           element till destinationen utan att skriva till samma positioner.
+*
+*                           - self        : Pekare till vektorn som ska sorteras.
+*                           - thread_count: Antalet trdar (0 = antalet processorkrnor).
+**************************************************************************************************/
+int int_vector_sort_parallel(struct int_vector* self,
+                             const size_t thread_count)
+{
+#ifdef _WIN32
+   (void)thread_count;
+   return int_vector_sort(self);
+#else
+   if (int_vector_unshare(self)) return 1;
+   const size_t size = self->size;
+   size_t task_count = thread_count;
+
+   if (!task_count)
+   {
+      const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+      task_count = processors > 0 ? (size_t)processors : 1;
+   }
+
+   if (task_count > INT_VECTOR_SORT_MAX_THREADS) task_count = INT_VECTOR_SORT_MAX_THREADS;
+   if (task_count > size / INT_VECTOR_SORT_PARALLEL_MIN) task_count = size / INT_VECTOR_SORT_PARALLEL_MIN;
+   if (task_count <= 1) return int_vector_sort(self);
+
+   int* temp = (int*)allocator_allocate(0, sizeof(int) * size);
+   if (!temp) return 1;
+   struct int_vector_sort_task* tasks = (struct int_vector_sort_task*)
+      allocator_allocate(0, sizeof(struct int_vector_sort_task) * task_count);
+
+   if (!tasks)
+   {
+      allocator_deallocate(0, temp, sizeof(int) * size);
+      return 1;
+   }
+
+   int_vector_mark_dirty(self, 0, size);
+
+   int* src = self->data;
+   int* dst = temp;
+
+   for (size_t i = 0; i < task_count; ++i)
+   {
+      tasks[i].first = size * i / task_count;
+      tasks[i].last = size * (i + 1) / task_count;
+   }
+
+   for (unsigned int pass = 0; pass < INT_VECTOR_SORT_PASSES; ++pass)
+   {
+      size_t offset = 0;
+      int skip = 0;
+
+      for (size_t i = 0; i < task_count; ++i)
+      {
+         tasks[i].src = src;
+         tasks[i].dst = dst;
+         tasks[i].shift = pass * 8;
+      }
+
+      int_vector_sort_run(tasks, task_count, int_vector_sort_count);
+
+      for (size_t digit = 0; digit < INT_VECTOR_SORT_RADIX && !skip; ++digit)
+      {
+         const size_t first_offset = offset;
+
+         for (size_t i = 0; i < task_count; ++i)
+         {
+            tasks[i].offsets[digit] = offset;
+            offset += tasks[i].counts[digit];
+         }
+
+         skip = offset - first_offset == size;
+      }
+
+      if (skip) continue;
+      int_vector_sort_run(tasks, task_count, int_vector_sort_scatter);
+
+      int* swap = src;
+      src = dst;
+      dst = swap;
+   }
+
+   if (src != self->data) memcpy(self->data, src, sizeof(int) * size);
+   allocator_deallocate(0, tasks, sizeof(struct int_vector_sort_task) * task_count);
+   allocator_deallocate(0, temp, sizeof(int) * size);
+   return 0;
+#endif
+}
+
+/**************************************************************************************************
+* int_vector_lower_bound: Returnerar adressen till det frsta elementet i angiven sorterad vektor
+*                         som r strre n eller lika med angivet vrde. Om inget sdant element
+*                         finns returneras adressen som returneras av int_vector_cend. Adressen
+*                         r enbart avsedd fr lsning, s att ett delat flt aldrig ndras.
+*
+*                         - self : Pekare till den sorterade vektorn.
+*                         - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+const int* int_vector_lower_bound(const struct int_vector* self,
+                                  const int value)
+{
+   const int* first = self->data;
+   size_t count = self->size;
+
+   while (count > 0)
+   {
+      const size_t half = count / 2;
+
+      if (first[half] < value)
+      {
+         first += half + 1;
+         count -= half + 1;
+      }
+      else
+      {
+         count = half;
+      }
+   }
+
+   return first;
+}
+
+/**************************************************************************************************
+* int_vector_binary_search: Returnerar adressen till ett element lika med angivet vrde i angiven
+*                           sorterad vektor via binrskning. Om inget sdant element finns
+*                           returneras null. Adressen r enbart avsedd fr lsning.
+*
+*                           - self : Pekare till den sorterade vektorn.
+*                           - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+const int* int_vector_binary_search(const struct int_vector* self,
+                                    const int value)
+{
+   const int* element = int_vector_lower_bound(self, value);
+   return element < self->data + self->size && *element == value ? element : 0;
+}
+
+/**************************************************************************************************
+* int_vector_sort_digit: Returnerar angiven siffra (byte) i sorteringsnyckeln fr angivet heltal.
+*                        Teckenbiten inverteras, s att negativa tal sorteras fre positiva.
+*
+*                        - value: Heltalet vars siffra ska returneras.
+*                        - shift: Antalet bitar som nyckeln ska skiftas (0, 8, 16 eller 24).
+**************************************************************************************************/
+static unsigned int int_vector_sort_digit(const int value, const unsigned int shift)
+{
+   return (((unsigned int)value ^ 0x80000000u) >> shift) & (INT_VECTOR_SORT_RADIX - 1);
+}
+
+/**************************************************************************************************
+* int_vector_sort_insertion: Sorterar angivet flt i stigande ordning via insttningssortering.
+*
+*                            - data: Pekare till fltet som ska sorteras.
+*                            - size: Fltets storlek, dvs. antalet heltal det rymmer.
+**************************************************************************************************/
+static void int_vector_sort_insertion(int* data, const size_t size)
+{
+   for (size_t i = 1; i < size; ++i)
+   {
+      const int value = data[i];
+      size_t j = i;
+
+      while (j > 0 && data[j - 1] > value)
+      {
+         data[j] = data[j - 1];
+         j--;
+      }
+
+      data[j] = value;
+   }
+
+   return;
+}
+
+#ifndef _WIN32
+
+/**************************************************************************************************
+* int_vector_sort_count: Berknar histogrammet fr aktuellt steg ver trdens del av vektorn.
+*
+*                        - arg: Pekare till trdens uppgift (struct int_vector_sort_task).
+**************************************************************************************************/
+static void* int_vector_sort_count(void* arg)
+{
+   struct int_vector_sort_task* self = (struct int_vector_sort_task*)arg;
+   memset(self->counts, 0, sizeof(self->counts));
+
+   for (size_t i = self->first; i < self->last; ++i)
+   {
+      self->counts[int_vector_sort_digit(self->src[i], self->shift)]++;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_sort_scatter: Flyttar elementen i trdens del av vektorn till destinationen,
+*                          med brjan p trdens startposition fr respektive siffra.
+*
+*                          - arg: Pekare till trdens uppgift (struct int_vector_sort_task).
+**************************************************************************************************/
+static void* int_vector_sort_scatter(void* arg)
+{
+   struct int_vector_sort_task* self = (struct int_vector_sort_task*)arg;
+
+   for (size_t i = self->first; i < self->last; ++i)
+   {
+      const int value = self->src[i];
+      self->dst[self->offsets[int_vector_sort_digit(value, self->shift)]++] = value;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_sort_run: Kr angiven funktion fr samtliga uppgifter samtidigt via den globala
+*                      trdpoolen, vars trdar teranvnds mellan stegen, se thread_pool_default.
+*                      Ifall poolen inte kan skapas krs uppgifterna i stllet av den anropande
+*                      trden. Funktionen tervnder frst nr samtliga uppgifter r slutfrda.
+*
+*                      - tasks     : Pekare till fltet innehllande uppgifterna.
+*                      - task_count: Antalet uppgifter.
+*                      - function  : Funktionen som ska kras fr varje uppgift.
+**************************************************************************************************/
+static void int_vector_sort_run(struct int_vector_sort_task* tasks,
+                                const size_t task_count,
+                                void* (*function)(void*))
+{
+   struct int_vector_sort_batch batch = { tasks, function };
+   struct thread_pool* pool = thread_pool_default();
+
+   if (!pool || thread_pool_run(pool, task_count, int_vector_sort_dispatch, &batch))
+   {
+      for (size_t i = 0; i < task_count; ++i)
+      {
+         function(&tasks[i]);
+      }
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_sort_dispatch: Kr stegets funktion fr angiven uppgift, anropas av trdpoolen.
+*
+*                           - context: Pekare till steget (struct int_vector_sort_batch).
+*                           - task   : Uppgiftens index.
+**************************************************************************************************/
+static void int_vector_sort_dispatch(void* context, size_t task)
+{
+   const struct int_vector_sort_batch* self = (const struct int_vector_sort_batch*)context;
+   self->function(&self->tasks[task]);
+   return;
+}
+
+#endif /* _WIN32 */
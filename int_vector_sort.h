@@ -0,0 +1,65 @@
+/**************************************************************************************************
+* int_vector_sort.h: Sortering och skning fr vektorer av typen int_vector. Sorteringen sker
+*                    via radixsortering (LSD) specialiserad fr 32-bitars signerade heltal, dr
+*                    elementen frdelas efter en byte i taget med brjan i den minst signifikanta
+*                    byten. Till skillnad frn qsort anropas ingen jmfrelsefunktion per element
+*                    och tidstgngen vxer linjrt med antalet element. Stora vektorer kan ven
+*                    sorteras av flera trdar samtidigt, dr varje trd ansvarar fr en del av
+*                    vektorn i varje steg.
+**************************************************************************************************/
+#ifndef INT_VECTOR_SORT_H_
+#define INT_VECTOR_SORT_H_
+
+/* Inkluderingsdirektiv: */
+#include "int_vector.h"
+
+/**************************************************************************************************
+* int_vector_sort: Sorterar elementen i angiven vektor i stigande ordning. Ett temporrt flt
+*                  lika stort som vektorn allokeras via standardallokatorn (malloc) i stllet
+*                  fr vektorns allokator, eftersom fltet enbart behvs under sorteringen och
+*                  annars exempelvis skulle bli kvar i en arena. Vid lyckad sortering returneras
+*                  0, annars returneras felkod 1, varvid vektorn lmnas osorterad och inte
+*                  markeras som ndrad.
+*
+*                  - self: Pekare till vektorn som ska sorteras.
+**************************************************************************************************/
+int int_vector_sort(struct int_vector* self);
+
+/**************************************************************************************************
+* int_vector_sort_parallel: Sorterar elementen i angiven vektor i stigande ordning med angivet
+*                           antal delar, vilka krs via den globala trdpoolen. Mindre vektorer
+*                           sorteras av den anropande trden, d kostnaden fr att frdela
+*                           arbetet ver trdarna annars verstiger vinsten. Vid lyckad
+*                           sortering returneras 0, annars returneras felkod 1, varvid vektorn
+*                           lmnas osorterad.
+*
+*                           - self        : Pekare till vektorn som ska sorteras.
+*                           - thread_count: Antalet trdar (0 = antalet processorkrnor).
+**************************************************************************************************/
+int int_vector_sort_parallel(struct int_vector* self,
+                             const size_t thread_count);
+
+/**************************************************************************************************
+* int_vector_lower_bound: Returnerar adressen till det frsta elementet i angiven sorterad vektor
+*                         som r strre n eller lika med angivet vrde. Om inget sdant element
+*                         finns returneras adressen som returneras av int_vector_cend. Adressen
+*                         r enbart avsedd fr lsning, s att ett delat flt aldrig ndras.
+*
+*                         - self : Pekare till den sorterade vektorn.
+*                         - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+const int* int_vector_lower_bound(const struct int_vector* self,
+                                  const int value);
+
+/**************************************************************************************************
+* int_vector_binary_search: Returnerar adressen till ett element lika med angivet vrde i angiven
+*                           sorterad vektor via binrskning. Om inget sdant element finns
+*                           returneras null. Adressen r enbart avsedd fr lsning.
+*
+*                           - self : Pekare till den sorterade vektorn.
+*                           - value: Vrdet som ska skas efter.
+**************************************************************************************************/
+const int* int_vector_binary_search(const struct int_vector* self,
+                                    const int value);
+
+#endif /* INT_VECTOR_SORT_H_ */
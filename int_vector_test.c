@@ -0,0 +1,2335 @@
+/**************************************************************************************************
+* int_vector_test.c: Korrekthetstester fr vektorer av typen int_vector samt tillhrande moduler,
+*                    vilka krs via CTest (ctest --test-dir build). Varje test skriver ut sitt
+*                    namn fljt av ok eller fel, och vid fel avslutas programmet med felkod 1.
+*                    Prestandan mts separat via int_vector_bench.
+*
+*                    Anvndning: int_vector_test [antal]
+*
+*                    - antal: Antalet heltal som skickas mellan trdarna i stresstestet fr
+*                             int_ring (default = INT_VECTOR_TEST_RING_COUNT), exempelvis
+*                             200000000 fr ett lngre stresstest.
+**************************************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+/* Inkluderingsdirektiv: */
+#include <limits.h>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "arena.h"
+#include "crc32c.h"
+#include "huge_allocator.h"
+#include "int_format.h"
+#include "int_ring.h"
+#include "int_vector.h"
+#include "int_vector_compressed.h"
+#include "int_vector_concurrent.h"
+#include "int_vector_parallel.h"
+#include "int_vector_set.h"
+#include "int_vector_simd.h"
+#include "int_vector_sort.h"
+#include "pool.h"
+
+/**************************************************************************************************
+* INT_VECTOR_TEST_RING_COUNT: Default-antal heltal som skickas i stresstestet fr int_ring.
+*
+* INT_VECTOR_TEST_RING_CAPACITY: Ringbuffertens kapacitet, som r liten s att producenten
+*                                och konsumenten ofta vntar p varandra.
+*
+* INT_VECTOR_TEST_RING_BATCH: Antalet heltal per anrop vid verfring i block.
+*
+* INT_VECTOR_TEST_WRITERS: Antalet skrivande trdar i testet av int_vector_concurrent.
+*
+* INT_VECTOR_TEST_LARGE: Stor udda storlek som testas utver mindre storlekar.
+*
+* INT_VECTOR_TEST_FILE: Fil som anvnds vid test av filfunktionerna, vilken tas bort efter
+*                       varje test.
+**************************************************************************************************/
+#define INT_VECTOR_TEST_RING_COUNT 2000000
+#define INT_VECTOR_TEST_RING_CAPACITY 64
+#define INT_VECTOR_TEST_RING_BATCH 37
+#define INT_VECTOR_TEST_WRITERS 4
+#define INT_VECTOR_TEST_LARGE 100003
+#define INT_VECTOR_TEST_FILE "int_vector_test.bin"
+
+/**************************************************************************************************
+* int_vector_test_ring_task: Producentens uppgift i stresstestet fr int_ring.
+**************************************************************************************************/
+struct int_vector_test_ring_task
+{
+   struct int_ring* ring; /* Pekare till ringbufferten. */
+   size_t count;          /* Antalet heltal som ska skickas. */
+   size_t batch;          /* Antalet heltal per anrop (1 = int_ring_push). */
+};
+
+/**************************************************************************************************
+* int_vector_test_writer_task: En skrivande trds uppgift i testet av int_vector_concurrent.
+**************************************************************************************************/
+struct int_vector_test_writer_task
+{
+   struct int_vector_concurrent* vector; /* Pekare till den delade vektorn. */
+   size_t first;                         /* Det frsta heltalet som ska lggas till. */
+   size_t last;                          /* Heltalet direkt efter det sista som ska lggas till. */
+};
+
+/**************************************************************************************************
+* int_vector_test_allocator: Allokator som misslyckas d angivet antal allokeringar har
+*                            genomfrts, vilket anvnds fr att testa felhantering.
+**************************************************************************************************/
+struct int_vector_test_allocator
+{
+   struct allocator allocator; /* Allokatorgrnssnitt med strukten som kontext. */
+   size_t remaining;           /* Antalet allokeringar som terstr innan fel uppstr. */
+};
+
+/**************************************************************************************************
+* int_vector_test_text_case: Testfall fr int_vector_read_text, bestende av en text och de
+*                            heltal som ska lsas in, alternativt den rad dr fel ska uppst.
+**************************************************************************************************/
+struct int_vector_test_text_case
+{
+   const char* text;  /* Texten som ska tolkas. */
+   int values[6];     /* Heltalen som ska lsas in. */
+   size_t count;      /* Antalet heltal som ska lsas in. */
+   size_t error_line; /* Den rad dr fel ska uppst, rknat frn 1 (0 = inget fel). */
+};
+
+/**************************************************************************************************
+* int_vector_test_item: Element som ger ett heapallokerat heltal, vilket anvnds fr att testa
+*                       vektorer med funktioner fr kopiering och destruktion av element.
+**************************************************************************************************/
+struct int_vector_test_item
+{
+   int* value; /* Pekare till det gda heltalet (eller null). */
+};
+
+/**************************************************************************************************
+* int_vector_test_int64_vector, int_vector_test_item_vector: Vektorer av andra datatyper n int,
+*                                                            vilka genereras via mallen i
+*                                                            vector.h fr att testa mallen.
+**************************************************************************************************/
+DECLARE_VECTOR_EX(int_vector_test_int64_vector, int64_t, 2)
+DECLARE_VECTOR(int_vector_test_item_vector, struct int_vector_test_item)
+
+/**************************************************************************************************
+* int_vector_test_copies: Antalet element som har kopierats via int_vector_test_item_copy.
+*
+* int_vector_test_destroys: Antalet element som har frigjorts via int_vector_test_item_destroy.
+**************************************************************************************************/
+static size_t int_vector_test_copies = 0;
+static size_t int_vector_test_destroys = 0;
+
+/* Statiska funktioner: */
+static uint32_t int_vector_test_random(uint32_t* state);
+static void int_vector_test_allocator_init(struct int_vector_test_allocator* self,
+                                           const size_t remaining);
+static void* int_vector_test_allocate(void* context, size_t size);
+static void* int_vector_test_reallocate(void* context, void* block, size_t old_size,
+                                        size_t new_size);
+static void int_vector_test_deallocate(void* context, void* block, size_t size);
+static int int_vector_test_fill(struct int_vector* self,
+                                const size_t size,
+                                const uint32_t range,
+                                uint32_t* state);
+static int int_vector_test_fill_sorted(struct int_vector* self,
+                                       const size_t size,
+                                       const int scale,
+                                       uint32_t* state);
+static int int_vector_test_equal(const struct int_vector* lhs,
+                                 const struct int_vector* rhs);
+static int int_vector_test_report(const char* name,
+                                  const int error);
+static int int_vector_test_check(const struct int_vector* self,
+                                 const int* values,
+                                 const size_t size);
+static int int_vector_test_range(void);
+static int int_vector_test_inline(void);
+static int int_vector_test_compare(const void* lhs,
+                                   const void* rhs);
+static int int_vector_test_sort(void);
+static char* int_vector_test_format_reference(const struct int_vector* self,
+                                              size_t* length);
+static char* int_vector_test_contents(FILE* stream,
+                                      size_t* length);
+static int int_vector_test_format(void);
+static int int_vector_test_read_text(struct int_vector* self,
+                                     const char* text,
+                                     const size_t length,
+                                     size_t* error_line);
+static int int_vector_test_text(void);
+static int int_vector_test_text_blocks(void);
+static int int_vector_test_crc32c(void);
+static int int_vector_test_corrupt(const char* filepath,
+                                   const long offset);
+static int int_vector_test_files(void);
+static int int_vector_test_changes(void);
+static int int_vector_test_compressed(void);
+static int int_vector_test_set_naive(struct int_vector* dest,
+                                     const struct int_vector* lhs,
+                                     const struct int_vector* rhs,
+                                     const int operation);
+static int int_vector_test_set(void);
+static int int_vector_test_index(void);
+static void* int_vector_test_ring_produce(void* arg);
+static int int_vector_test_ring(const size_t count,
+                                const size_t batch);
+static void* int_vector_test_concurrent_write(void* arg);
+static int int_vector_test_concurrent(void);
+static int int_vector_test_concurrent_failure(void);
+static int int_vector_test_parallel(void);
+static int int_vector_test_arena(void);
+static int int_vector_test_pool(void);
+static int int_vector_test_huge(void);
+static int int_vector_test_move(void);
+static int int_vector_test_share(void);
+static void int_vector_test_item_copy(struct int_vector_test_item* dest,
+                                      const struct int_vector_test_item* src,
+                                      const size_t n);
+static void int_vector_test_item_destroy(struct int_vector_test_item* data,
+                                         const size_t n);
+static int int_vector_test_item_check(const struct int_vector_test_item_vector* self,
+                                      const int* values,
+                                      const size_t size);
+#ifdef VECTOR_STATS
+static int int_vector_test_stats(void);
+#endif /* VECTOR_STATS */
+static int int_vector_test_int64(void);
+static int int_vector_test_hooks(void);
+
+/**************************************************************************************************
+* DEFINE_VECTOR, DEFINE_VECTOR_WITH_HOOKS: Genererar funktionerna fr testvektorerna, dr
+*                                          elementen i int_vector_test_item_vector kopieras och
+*                                          frigrs via int_vector_test_item_copy respektive
+*                                          int_vector_test_item_destroy.
+**************************************************************************************************/
+DEFINE_VECTOR(int_vector_test_int64_vector, int64_t)
+DEFINE_VECTOR_WITH_HOOKS(int_vector_test_item_vector, struct int_vector_test_item,
+                         int_vector_test_item_copy, int_vector_test_item_destroy)
+
+/**************************************************************************************************
+* main: Kr samtliga tester och returnerar 0 ifall samtliga lyckades, annars felkod 1.
+*
+*       - argc: Antalet argument.
+*       - argv: Argumenten, dr det frsta valfria argumentet anger antalet heltal i
+*               stresstestet fr int_ring.
+**************************************************************************************************/
+int main(int argc, char** argv)
+{
+   size_t ring_count = INT_VECTOR_TEST_RING_COUNT;
+   int error = 0;
+
+   if (argc > 1)
+   {
+      char* end;
+      const unsigned long long count = strtoull(argv[1], &end, 10);
+
+      if (*end || !count || count > INT_MAX)
+      {
+         fprintf(stderr, "Felaktigt antal: %s\n", argv[1]);
+         return 1;
+      }
+
+      ring_count = (size_t)count;
+   }
+
+   error |= int_vector_test_report("range", int_vector_test_range());
+   error |= int_vector_test_report("inline", int_vector_test_inline());
+   error |= int_vector_test_report("sort", int_vector_test_sort());
+   error |= int_vector_test_report("format", int_vector_test_format());
+   error |= int_vector_test_report("text", int_vector_test_text());
+   error |= int_vector_test_report("text_blocks", int_vector_test_text_blocks());
+   error |= int_vector_test_report("crc32c", int_vector_test_crc32c());
+   error |= int_vector_test_report("files", int_vector_test_files());
+   error |= int_vector_test_report("changes", int_vector_test_changes());
+   error |= int_vector_test_report("compressed", int_vector_test_compressed());
+   error |= int_vector_test_report("set", int_vector_test_set());
+   error |= int_vector_test_report("index", int_vector_test_index());
+   error |= int_vector_test_report("ring", int_vector_test_ring(ring_count, 1));
+   error |= int_vector_test_report("ring_batch",
+                                   int_vector_test_ring(ring_count, INT_VECTOR_TEST_RING_BATCH));
+   error |= int_vector_test_report("concurrent", int_vector_test_concurrent());
+   error |= int_vector_test_report("concurrent_oom", int_vector_test_concurrent_failure());
+   error |= int_vector_test_report("parallel", int_vector_test_parallel());
+   error |= int_vector_test_report("arena", int_vector_test_arena());
+   error |= int_vector_test_report("pool", int_vector_test_pool());
+   error |= int_vector_test_report("huge", int_vector_test_huge());
+   error |= int_vector_test_report("move", int_vector_test_move());
+   error |= int_vector_test_report("share", int_vector_test_share());
+#ifdef VECTOR_STATS
+   error |= int_vector_test_report("stats", int_vector_test_stats());
+#endif /* VECTOR_STATS */
+   error |= int_vector_test_report("int64", int_vector_test_int64());
+   error |= int_vector_test_report("hooks", int_vector_test_hooks());
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_random: Returnerar nsta slumptal frn angivet tillstnd (xorshift32).
+*
+*                         - state: Pekare till slumpgeneratorns tillstnd (skilt frn 0).
+**************************************************************************************************/
+static uint32_t int_vector_test_random(uint32_t* state)
+{
+   *state ^= *state << 13;
+   *state ^= *state >> 17;
+   *state ^= *state << 5;
+   return *state;
+}
+
+/**************************************************************************************************
+* int_vector_test_allocator_init: Initierar angiven allokator, som tillter angivet antal
+*                                 allokeringar och omallokeringar via malloc och realloc.
+*
+*                                 - self     : Pekare till allokatorn som ska initieras.
+*                                 - remaining: Antalet allokeringar som ska lyckas.
+**************************************************************************************************/
+static void int_vector_test_allocator_init(struct int_vector_test_allocator* self,
+                                           const size_t remaining)
+{
+   self->allocator.allocate = int_vector_test_allocate;
+   self->allocator.reallocate = int_vector_test_reallocate;
+   self->allocator.deallocate = int_vector_test_deallocate;
+   self->allocator.context = self;
+   self->remaining = remaining;
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_test_allocate: Allokerar ett minnesblock via malloc, ifall allokeringar terstr.
+**************************************************************************************************/
+static void* int_vector_test_allocate(void* context, size_t size)
+{
+   struct int_vector_test_allocator* self = (struct int_vector_test_allocator*)context;
+   if (!self->remaining) return 0;
+   self->remaining--;
+   return malloc(size);
+}
+
+/**************************************************************************************************
+* int_vector_test_reallocate: Omallokerar ett minnesblock via realloc, ifall allokeringar
+*                             terstr.
+**************************************************************************************************/
+static void* int_vector_test_reallocate(void* context, void* block, size_t old_size,
+                                        size_t new_size)
+{
+   struct int_vector_test_allocator* self = (struct int_vector_test_allocator*)context;
+   (void)old_size;
+   if (!self->remaining) return 0;
+   self->remaining--;
+   return realloc(block, new_size);
+}
+
+/**************************************************************************************************
+* int_vector_test_deallocate: Frigr ett minnesblock via free.
+**************************************************************************************************/
+static void int_vector_test_deallocate(void* context, void* block, size_t size)
+{
+   (void)context;
+   (void)size;
+   free(block);
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_test_fill: Stter angiven vektors storlek och tilldelar elementen slumptal frn 0
+*                       till range - 1, eller ver hela vrdeintervallet fr int om range r 0.
+*                       Vid lyckad tilldelning returneras 0, annars returneras felkod 1.
+*
+*                       - self : Pekare till vektorn som ska tilldelas.
+*                       - size : Vektorns nya storlek.
+*                       - range: Antalet mjliga vrden (0 = samtliga).
+*                       - state: Pekare till slumpgeneratorns tillstnd.
+**************************************************************************************************/
+static int int_vector_test_fill(struct int_vector* self,
+                                const size_t size,
+                                const uint32_t range,
+                                uint32_t* state)
+{
+   if (int_vector_resize(self, size)) return 1;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      const uint32_t value = int_vector_test_random(state);
+      self->data[i] = range ? (int)(value % range) : (int)(int32_t)value;
+   }
+
+   int_vector_mark_dirty(self, 0, size);
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_test_fill_sorted: Stter angiven vektors storlek och tilldelar elementen en strikt
+*                              stigande sekvens, dr avstndet mellan elementen r ett slumptal
+*                              frn 1 till 4 gnger angiven skala. Vid lyckad tilldelning
+*                              returneras 0, annars returneras felkod 1.
+*
+*                              - self : Pekare till vektorn som ska tilldelas.
+*                              - size : Vektorns nya storlek.
+*                              - scale: Skala fr avstndet mellan elementen.
+*                              - state: Pekare till slumpgeneratorns tillstnd.
+**************************************************************************************************/
+static int int_vector_test_fill_sorted(struct int_vector* self,
+                                       const size_t size,
+                                       const int scale,
+                                       uint32_t* state)
+{
+   int value = INT_MIN / 2;
+   if (int_vector_resize(self, size)) return 1;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      value += (int)(int_vector_test_random(state) % 4 + 1) * scale;
+      self->data[i] = value;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_test_equal: Indikerar ifall angivna vektorer har samma storlek och innehll.
+*
+*                        - lhs: Pekare till den frsta vektorn.
+*                        - rhs: Pekare till den andra vektorn.
+**************************************************************************************************/
+static int int_vector_test_equal(const struct int_vector* lhs,
+                                 const struct int_vector* rhs)
+{
+   return lhs->size == rhs->size && !memcmp(lhs->data, rhs->data, sizeof(int) * lhs->size);
+}
+
+/**************************************************************************************************
+* int_vector_test_report: Skriver ut angivet tests namn samt resultat och returnerar felkoden.
+*
+*                         - name : Testets namn.
+*                         - error: Testets felkod (0 = lyckat).
+**************************************************************************************************/
+static int int_vector_test_report(const char* name,
+                                  const int error)
+{
+   printf("%-16s %s\n", name, error ? "fel" : "ok");
+   return error ? 1 : 0;
+}
+
+/**************************************************************************************************
+* int_vector_test_check: Returnerar 1 ifall angiven vektor innehller exakt angivna heltal,
+*                        annars returneras 0.
+*
+*                        - self  : Pekare till vektorn som ska kontrolleras.
+*                        - values: Pekare till de frvntade heltalen.
+*                        - size  : Det frvntade antalet heltal.
+**************************************************************************************************/
+static int int_vector_test_check(const struct int_vector* self,
+                                 const int* values,
+                                 const size_t size)
+{
+   return self->size == size && (!size || !memcmp(self->data, values, sizeof(int) * size));
+}
+
+/**************************************************************************************************
+* int_vector_test_range: Kontrollerar int_vector_append_range, int_vector_insert_range och
+*                        int_vector_erase_range mot ett vanligt flt. Vektorn lggs till sig
+*                        sjlv, bde d fltet mste omallokeras, d vektorn lagras i det
+*                        inbyggda fltet och d vektorn delas med en annan vektor, varefter
+*                        element stts in och tas bort i brjan och slutet. Ogiltiga index ska
+*                        returnera felkod 1 utan att vektorn ndras.
+**************************************************************************************************/
+static int int_vector_test_range(void)
+{
+   struct int_vector vector, shared;
+   int expected[512];
+   const int ends[3] = { INT_MIN, -1, INT_MAX };
+   int error = 0;
+
+   int_vector_init(&vector);
+   int_vector_init(&shared);
+
+   for (int i = 0; i < 5; ++i)
+   {
+      expected[i] = expected[i + 5] = expected[i + 10] = expected[i + 15] = i;
+      if (int_vector_push(&vector, i)) error = 1;
+   }
+
+   if (error || int_vector_append_range(&vector, vector.data, 5) ||
+       vector.data != vector.inline_data || !int_vector_test_check(&vector, expected, 10) ||
+       int_vector_append_range(&vector, vector.data, 10) ||
+       vector.data == vector.inline_data || !int_vector_test_check(&vector, expected, 20))
+   {
+      error = 1;
+   }
+
+   for (int i = 0; i < 100; ++i)
+   {
+      expected[i] = expected[i + 100] = expected[i + 200] = expected[i + 300] = i * 3 - 150;
+   }
+
+   if (int_vector_resize(&vector, 0) || int_vector_append_range(&vector, expected, 100) ||
+       int_vector_shrink_to_fit(&vector) || vector.capacity != 100 ||
+       int_vector_append_range(&vector, vector.data, vector.size) ||
+       !int_vector_test_check(&vector, expected, 200) ||
+       int_vector_share(&shared, &vector) ||
+       int_vector_append_range(&shared, shared.data, shared.size) ||
+       !int_vector_test_check(&shared, expected, 400) ||
+       !int_vector_test_check(&vector, expected, 200))
+   {
+      error = 1;
+   }
+
+   expected[250] = 7;
+   expected[251] = 8;
+
+   if (int_vector_append_range(&vector, vector.data + 100, 50) ||
+       int_vector_append_range(&vector, expected + 250, 2) ||
+       int_vector_append_range(&vector, expected, 0) ||
+       !int_vector_test_check(&vector, expected, 252) ||
+       int_vector_erase_range(&vector, 0, 2) || int_vector_erase_range(&vector, 248, 2) ||
+       int_vector_erase_range(&vector, 248, 0) ||
+       !int_vector_test_check(&vector, expected + 2, 248))
+   {
+      error = 1;
+   }
+
+   memmove(expected + 3, expected + 2, sizeof(int) * 248);
+   memcpy(expected, ends, sizeof(ends));
+   memcpy(expected + 251, ends, sizeof(ends));
+
+   if (int_vector_insert_range(&vector, 0, ends, 3) ||
+       int_vector_insert_range(&vector, vector.size, ends, 3) ||
+       int_vector_insert_range(&vector, 0, ends, 0) ||
+       !int_vector_test_check(&vector, expected, 254) ||
+       !int_vector_insert_range(&vector, vector.size + 1, ends, 1) ||
+       !int_vector_erase_range(&vector, vector.size, 1) ||
+       !int_vector_erase_range(&vector, 250, 5) ||
+       !int_vector_erase_range(&vector, 1, SIZE_MAX) ||
+       !int_vector_test_check(&vector, expected, 254) ||
+       int_vector_erase_range(&vector, 0, vector.size) || vector.size)
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&vector);
+   int_vector_clear(&shared);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_inline: Kontrollerar att en vektor lagrar upp till INT_VECTOR_INLINE_CAPACITY
+*                         element i det inbyggda fltet utan allokering, flyttas till heapen d
+*                         ytterligare element lggs till samt flyttas tillbaka till det inbyggda
+*                         fltet vid krympning via int_vector_shrink_to_fit, med bevarat
+*                         innehll. ven flytt och kloning av vektorer i det inbyggda fltet
+*                         kontrolleras.
+**************************************************************************************************/
+static int int_vector_test_inline(void)
+{
+   struct int_vector_test_allocator allocator;
+   struct int_vector vector, other;
+   int expected[INT_VECTOR_INLINE_CAPACITY + 1];
+   int error = 0;
+
+   int_vector_test_allocator_init(&allocator, 0);
+   int_vector_init_with_allocator(&vector, &allocator.allocator);
+   int_vector_init(&other);
+
+   for (int i = 0; i <= INT_VECTOR_INLINE_CAPACITY; ++i)
+   {
+      expected[i] = INT_MAX - i;
+   }
+
+   if (vector.data != vector.inline_data || vector.capacity != INT_VECTOR_INLINE_CAPACITY ||
+       int_vector_append_range(&vector, expected, INT_VECTOR_INLINE_CAPACITY) ||
+       vector.data != vector.inline_data || !int_vector_push(&vector, 0) ||
+       !int_vector_reserve(&vector, INT_VECTOR_INLINE_CAPACITY + 1) ||
+       !int_vector_test_check(&vector, expected, INT_VECTOR_INLINE_CAPACITY))
+   {
+      error = 1;
+   }
+
+   allocator.remaining = 1;
+
+   if (int_vector_push(&vector, expected[INT_VECTOR_INLINE_CAPACITY]) ||
+       vector.data == vector.inline_data ||
+       !int_vector_test_check(&vector, expected, INT_VECTOR_INLINE_CAPACITY + 1) ||
+       int_vector_resize(&vector, 5) || vector.data == vector.inline_data ||
+       int_vector_shrink_to_fit(&vector) || vector.data != vector.inline_data ||
+       vector.capacity != INT_VECTOR_INLINE_CAPACITY ||
+       !int_vector_test_check(&vector, expected, 5))
+   {
+      error = 1;
+   }
+
+   allocator.remaining = 1;
+
+   if (int_vector_reserve(&vector, 1000) || vector.data == vector.inline_data ||
+       vector.capacity != 1000 || !int_vector_test_check(&vector, expected, 5) ||
+       int_vector_shrink_to_fit(&vector) || vector.data != vector.inline_data ||
+       !int_vector_test_check(&vector, expected, 5))
+   {
+      error = 1;
+   }
+
+   int_vector_move(&other, &vector);
+
+   if (other.data != other.inline_data || !int_vector_test_check(&other, expected, 5) ||
+       vector.data != vector.inline_data || vector.size ||
+       int_vector_clone(&vector, &other) || vector.data != vector.inline_data ||
+       !int_vector_test_check(&vector, expected, 5))
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&vector);
+   int_vector_clear(&other);
+   if (allocator.remaining) error = 1;
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_compare: Jmfrelsefunktion fr qsort och bsearch, som returnerar ett negativt
+*                          tal, 0 eller ett positivt tal beroende p ifall lhs r mindre n,
+*                          lika med eller strre n rhs.
+*
+*                          - lhs: Pekare till det frsta heltalet.
+*                          - rhs: Pekare till det andra heltalet.
+**************************************************************************************************/
+static int int_vector_test_compare(const void* lhs,
+                                   const void* rhs)
+{
+   const int a = *(const int*)lhs;
+   const int b = *(const int*)rhs;
+   return (a > b) - (a < b);
+}
+
+/**************************************************************************************************
+* int_vector_test_sort: Jmfr int_vector_sort och int_vector_sort_parallel med qsort samt
+*                       int_vector_lower_bound och int_vector_binary_search med linjr skning
+*                       och bsearch. Indata bestr av slumptal ver hela vrdeintervallet,
+*                       negativa tal med mnga dubbletter, INT_MIN och INT_MAX samt fallande
+*                       sekvenser, fr storlekar kring grnsen fr insttningssortering (64
+*                       element) och storlekar som sorteras parallellt.
+**************************************************************************************************/
+static int int_vector_test_sort(void)
+{
+   static const size_t sizes[] = { 0, 1, 2, 3, 63, 64, 65, 1000, 300007 };
+   struct int_vector vector, expected, parallel;
+   uint32_t state = 3141592653u;
+   int error = 0;
+
+   int_vector_init(&vector);
+   int_vector_init(&expected);
+   int_vector_init(&parallel);
+
+   for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes) && !error; ++i)
+   {
+      for (int kind = 0; kind < 4 && !error; ++kind)
+      {
+         if (int_vector_test_fill(&vector, sizes[i], kind == 1 ? 100 : 0, &state)) error = 1;
+
+         for (size_t j = 0; j < vector.size; ++j)
+         {
+            if (kind == 1) vector.data[j] -= 50;
+            else if (kind == 2 && j % 3 == 0) vector.data[j] = j % 2 ? INT_MIN : INT_MAX;
+            else if (kind == 3) vector.data[j] = (int)(vector.size - j) - (int)(vector.size / 2);
+         }
+
+         if (int_vector_clone(&expected, &vector) || int_vector_clone(&parallel, &vector))
+         {
+            error = 1;
+         }
+
+         if (expected.size)
+         {
+            qsort(expected.data, expected.size, sizeof(int), int_vector_test_compare);
+         }
+
+         if (int_vector_sort(&vector) || int_vector_sort_parallel(&parallel, 4) ||
+             !int_vector_test_equal(&vector, &expected) ||
+             !int_vector_test_equal(&parallel, &expected))
+         {
+            error = 1;
+         }
+
+         for (size_t query = 0; query < 200 && !error; ++query)
+         {
+            const uint32_t random = int_vector_test_random(&state);
+            int value = vector.size ? vector.data[random % vector.size] : 0;
+            size_t first = 0;
+
+            if (query % 4 == 1 && value < INT_MAX) value++;
+            else if (query % 4 == 2 && value > INT_MIN) value--;
+            else if (query % 4 == 3) value = random % 2 ? INT_MIN : INT_MAX;
+
+            while (first < vector.size && vector.data[first] < value) first++;
+
+            const int* position = int_vector_lower_bound(&vector, value);
+            const int* found = int_vector_binary_search(&vector, value);
+            const int* reference = vector.size ?
+               (const int*)bsearch(&value, vector.data, vector.size, sizeof(int),
+                                   int_vector_test_compare) : 0;
+
+            if (position != vector.data + first || !found != !reference ||
+                (found && *found != value))
+            {
+               error = 1;
+            }
+         }
+      }
+   }
+
+   int_vector_clear(&vector);
+   int_vector_clear(&expected);
+   int_vector_clear(&parallel);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_format_reference: Returnerar en heapallokerad strng innehllande angiven
+*                                   vektors frvntade utskrift, skapad via snprintf med
+*                                   formatet "%d\n" per element mellan tv avgrnsningsrader.
+*                                   Strngen mste frigras via free. Vid misslyckad allokering
+*                                   returneras null.
+*
+*                                   - self  : Pekare till vektorn vars utskrift ska skapas.
+*                                   - length: Pekare till variabel som tilldelas strngens lngd.
+**************************************************************************************************/
+static char* int_vector_test_format_reference(const struct int_vector* self,
+                                              size_t* length)
+{
+   static const char separator[] =
+      "--------------------------------------------------------------------------\n";
+   const size_t capacity = self->size * INT_FORMAT_MAX_LENGTH + 2 * sizeof(separator) + 1;
+   char* s = (char*)malloc(capacity);
+   size_t i = 0;
+
+   if (!s) return 0;
+
+   if (self->size)
+   {
+      i += (size_t)snprintf(s + i, capacity - i, "%s", separator);
+
+      for (size_t j = 0; j < self->size; ++j)
+      {
+         i += (size_t)snprintf(s + i, capacity - i, "%d\n", self->data[j]);
+      }
+
+      i += (size_t)snprintf(s + i, capacity - i, "%s\n", separator);
+   }
+
+   s[i] = '\0';
+   *length = i;
+   return s;
+}
+
+/**************************************************************************************************
+* int_vector_test_contents: Returnerar en heapallokerad kopia av hela innehllet i angiven
+*                           strm, som mste vara ppnad fr lsning. Kopian mste frigras via
+*                           free. Vid misslyckad lsning eller allokering returneras null.
+*
+*                           - stream: Pekare till strmmen som ska lsas.
+*                           - length: Pekare till variabel som tilldelas innehllets lngd.
+**************************************************************************************************/
+static char* int_vector_test_contents(FILE* stream,
+                                      size_t* length)
+{
+   if (fseek(stream, 0, SEEK_END)) return 0;
+   const long size = ftell(stream);
+   if (size < 0 || fseek(stream, 0, SEEK_SET)) return 0;
+   char* s = (char*)malloc((size_t)size + 1);
+   if (!s) return 0;
+
+   if (fread(s, 1, (size_t)size, stream) != (size_t)size)
+   {
+      free(s);
+      return 0;
+   }
+
+   *length = (size_t)size;
+   return s;
+}
+
+/**************************************************************************************************
+* int_vector_test_format: Kontrollerar int_format, int_format_write, int_vector_print och
+*                         int_vector_to_string mot snprintf med formatet "%d\n", inklusive
+*                         avgrnsningsraderna. Indata bestr av INT_MIN, INT_MAX, 0, tal kring
+*                         tiopotenser samt slumptal, med fler element n som ryms i bufferten
+*                         fr utskrift, som ven testas med minsta tilltna storlek.
+**************************************************************************************************/
+static int int_vector_test_format(void)
+{
+   static const size_t sizes[] = { 0, 1, 50, INT_VECTOR_TEST_LARGE };
+   static const size_t buffer_sizes[] = { INT_FORMAT_MAX_LENGTH, 100, INT_FORMAT_BUFFER_SIZE };
+   static char buffer[INT_FORMAT_BUFFER_SIZE];
+   const size_t separator_length = 75;
+   struct int_vector vector;
+   uint32_t state = 1618033988u;
+   int error = 0;
+
+   int_vector_init(&vector);
+
+   for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes) && !error; ++i)
+   {
+      if (int_vector_test_fill(&vector, sizes[i], 0, &state))
+      {
+         error = 1;
+         break;
+      }
+
+      for (size_t j = 0, power = 1; j < vector.size && j < 40; ++j)
+      {
+         if (j == 0) vector.data[j] = INT_MIN;
+         else if (j == 1) vector.data[j] = INT_MAX;
+         else if (j == 2) vector.data[j] = 0;
+         else if (j % 2) vector.data[j] = -(int)power;
+         else vector.data[j] = (int)power - 1;
+         if (j % 2 == 0) power = power == 1000000000 ? 1 : power * 10;
+      }
+
+      size_t expected_length = 0, length = 0;
+      char* expected = int_vector_test_format_reference(&vector, &expected_length);
+      char* s = int_vector_to_string(&vector, &length);
+      FILE* stream = tmpfile();
+
+      if (!expected || !s || !stream || length != expected_length ||
+          memcmp(s, expected, length) || s[length])
+      {
+         error = 1;
+      }
+      else
+      {
+         free(s);
+         int_vector_print(&vector, stream);
+         s = int_vector_test_contents(stream, &length);
+         if (!s || length != expected_length || memcmp(s, expected, length)) error = 1;
+      }
+
+      free(s);
+      if (stream) fclose(stream);
+
+      for (size_t j = 0; j < sizeof(buffer_sizes) / sizeof(*buffer_sizes) && !error; ++j)
+      {
+         const size_t offset = vector.size ? separator_length : 0;
+         const size_t total = vector.size ? expected_length - 2 * separator_length - 1 : 0;
+         stream = tmpfile();
+
+         if (!stream || int_format_write(stream, vector.data, vector.size, buffer,
+                                         buffer_sizes[j]))
+         {
+            error = 1;
+         }
+         else
+         {
+            s = int_vector_test_contents(stream, &length);
+            if (!s || length != total || memcmp(s, expected + offset, length)) error = 1;
+            free(s);
+         }
+
+         if (stream) fclose(stream);
+      }
+
+      for (size_t j = 0; j < vector.size && !error; ++j)
+      {
+         char reference[INT_FORMAT_MAX_LENGTH + 1];
+         char formatted[INT_FORMAT_MAX_LENGTH];
+         const int reference_length = snprintf(reference, sizeof(reference), "%d",
+                                               vector.data[j]);
+         const size_t formatted_length = int_format(formatted, vector.data[j]);
+
+         if (formatted_length != (size_t)reference_length ||
+             memcmp(formatted, reference, formatted_length))
+         {
+            error = 1;
+         }
+      }
+
+      free(expected);
+   }
+
+   int_vector_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_read_text: Skriver angiven text till en temporr fil och lser in heltalen
+*                            drifrn via int_vector_read_text, vars returvrde returneras.
+*
+*                            - self      : Pekare till vektorn som heltalen lggs till i.
+*                            - text      : Pekare till texten som ska tolkas.
+*                            - length    : Textens lngd i byte.
+*                            - error_line: Pekare till variabel som vid fel tilldelas numret p
+*                                          den felaktiga raden.
+**************************************************************************************************/
+static int int_vector_test_read_text(struct int_vector* self,
+                                     const char* text,
+                                     const size_t length,
+                                     size_t* error_line)
+{
+   FILE* istream = tmpfile();
+   *error_line = 0;
+
+   if (!istream) return 1;
+
+   if (fwrite(text, 1, length, istream) != length || fseek(istream, 0, SEEK_SET))
+   {
+      fclose(istream);
+      return 1;
+   }
+
+   const int error = int_vector_read_text(self, istream, error_line);
+   fclose(istream);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_text: Kontrollerar att int_vector_read_text lgger till heltalen i en text
+*                       efter befintliga element, ignorerar avgrnsningsrader, tomma rader och
+*                       CRLF-radslut samt accepterar en sista rad utan radbrytning. Vid felaktiga
+*                       rader och heltal som inte ryms i en int kontrolleras att rtt radnummer
+*                       anges och att vektorn terstlls till sin tidigare storlek. Slutligen
+*                       kontrolleras att int_vector_load_text erstter vektorns innehll och
+*                       lmnar vektorn tom vid fel.
+**************************************************************************************************/
+static int int_vector_test_text(void)
+{
+   static const struct int_vector_test_text_case cases[] =
+   {
+      { "1\n-2\n\n----------\n 3 \n2147483647\n-2147483648",
+        { 1, -2, 3, INT_MAX, INT_MIN }, 5, 0 },
+      { "4\r\n\r\n-5\r\n--\r\n6\r\n", { 4, -5, 6 }, 3, 0 },
+      { "000000000000000000007\n-0\n", { 7, 0 }, 2, 0 },
+      { "", { 0 }, 0, 0 },
+      { "1\n2147483648\n", { 0 }, 0, 2 },
+      { "-2147483649\n", { 0 }, 0, 1 },
+      { "1\n2\n99999999999999999999\n", { 0 }, 0, 3 },
+      { "1\n2\nx\n", { 0 }, 0, 3 },
+      { "1 2\n", { 0 }, 0, 1 },
+      { "1\n3-\n", { 0 }, 0, 2 },
+      { "1\n-\n2\n", { 0 }, 0, 2 },
+      { "1\n--5\n", { 0 }, 0, 2 },
+      { "1\n2\n-", { 0 }, 0, 3 },
+   };
+   struct int_vector vector;
+   int error = 0;
+
+   int_vector_init(&vector);
+
+   for (size_t i = 0; i < sizeof(cases) / sizeof(*cases) && !error; ++i)
+   {
+      const struct int_vector_test_text_case* test = cases + i;
+      size_t error_line = 0;
+
+      if (int_vector_assign_fill(&vector, 2, 42))
+      {
+         error = 1;
+         break;
+      }
+
+      const int result = int_vector_test_read_text(&vector, test->text, strlen(test->text),
+                                                   &error_line);
+
+      if (test->error_line)
+      {
+         if (!result || error_line != test->error_line || vector.size != 2) error = 1;
+      }
+      else if (result || vector.size != test->count + 2 ||
+               (test->count && memcmp(vector.data + 2, test->values, test->count * sizeof(int))))
+      {
+         error = 1;
+      }
+
+      if (vector.data[0] != 42 || vector.data[1] != 42) error = 1;
+   }
+
+   FILE* ostream = fopen(INT_VECTOR_TEST_FILE, "wb");
+
+   if (!ostream || fputs("8\n-9\n", ostream) == EOF || fclose(ostream))
+   {
+      error = 1;
+   }
+   else
+   {
+      size_t error_line = 0;
+
+      if (int_vector_load_text(&vector, INT_VECTOR_TEST_FILE, &error_line) ||
+          vector.size != 2 || vector.data[0] != 8 || vector.data[1] != -9)
+      {
+         error = 1;
+      }
+
+      ostream = fopen(INT_VECTOR_TEST_FILE, "wb");
+
+      if (!ostream || fputs("8\n-9\ny\n", ostream) == EOF || fclose(ostream) ||
+          !int_vector_load_text(&vector, INT_VECTOR_TEST_FILE, &error_line) ||
+          error_line != 3 || vector.size)
+      {
+         error = 1;
+      }
+   }
+
+   remove(INT_VECTOR_TEST_FILE);
+
+   if (!int_vector_load_text(&vector, INT_VECTOR_TEST_FILE, 0) || vector.size) error = 1;
+
+   int_vector_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_text_blocks: Kontrollerar att int_vector_read_text hanterar text som lses i
+*                              flera block. Ett heltal delas ver grnsen mellan de tv frsta
+*                              blocken (64 kB), varefter fler heltal lses n som lggs till i
+*                              vektorn t gngen, s att terstllningen vid ett avslutande fel
+*                              ven omfattar tidigare tillagda omgngar. Radnumret kontrolleras
+*                              efter blockgrnsen.
+**************************************************************************************************/
+static int int_vector_test_text_blocks(void)
+{
+   const size_t padding = 64 * 1024 - 4;
+   const size_t count = 5000;
+   struct int_vector vector;
+   char* text = (char*)malloc(padding + count * 12 + 8);
+   size_t length = padding;
+   size_t error_line = 0;
+   int error = 0;
+
+   int_vector_init(&vector);
+   if (!text) return 1;
+   memset(text, '\n', padding);
+
+   for (size_t i = 0; i < count; ++i)
+   {
+      length += (size_t)sprintf(text + length, "%d\n", (int)i * 7 - 1234567);
+   }
+
+   if (int_vector_test_read_text(&vector, text, length, &error_line) || vector.size != count)
+   {
+      error = 1;
+   }
+
+   for (size_t i = 0; i < vector.size; ++i)
+   {
+      if (vector.data[i] != (int)i * 7 - 1234567) error = 1;
+   }
+
+   memcpy(text + length, "1\n\tx", 5);
+   length += 5;
+
+   if (!int_vector_test_read_text(&vector, text, length, &error_line) ||
+       error_line != padding + count + 2 || vector.size != count)
+   {
+      error = 1;
+   }
+
+   free(text);
+   int_vector_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_crc32c: Kontrollerar crc32c mot standardens kontrollvrde fr "123456789",
+*                         att stegvis berkning ger samma resultat som en hel berkning samt att
+*                         int_vector_checksum med sprning ger samma resultat som utan efter
+*                         slumpmssiga ndringar.
+**************************************************************************************************/
+static int int_vector_test_crc32c(void)
+{
+   static const char check[] = "123456789";
+   struct int_vector vector;
+   uint32_t state = 2463534242u;
+   int error = crc32c(0, check, 9) != 0xE3069283u || crc32c(0, check, 0) != 0;
+
+   for (size_t split = 0; split <= 9; ++split)
+   {
+      if (crc32c(crc32c(0, check, split), check + split, 9 - split) != 0xE3069283u) error = 1;
+   }
+
+   int_vector_init(&vector);
+   if (int_vector_checksum(&vector) != 0) error = 1;
+   if (int_vector_test_fill(&vector, INT_VECTOR_TEST_LARGE, 0, &state) || int_vector_track(&vector))
+   {
+      error = 1;
+   }
+
+   for (size_t round = 0; round < 200 && !error; ++round)
+   {
+      const uint32_t value = int_vector_test_random(&state);
+      const size_t index = vector.size ? value % vector.size : 0;
+
+      switch (value % 5)
+      {
+         case 0: int_vector_push(&vector, (int)value); break;
+         case 1: int_vector_pop(&vector); break;
+         case 2: int_vector_resize(&vector, value % (2 * INT_VECTOR_TEST_LARGE)); break;
+         case 3: int_vector_erase_range(&vector, index, vector.size - index > 5 ? 5 : 0); break;
+         default:
+            if (vector.size)
+            {
+               vector.data[index] ^= (int)value;
+               int_vector_mark_dirty(&vector, index, 1);
+            }
+            break;
+      }
+
+      if (int_vector_checksum(&vector) != vector_checksum(vector.data, sizeof(int) * vector.size))
+      {
+         error = 1;
+      }
+   }
+
+   int_vector_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_corrupt: Inverterar byten p angiven position i angiven fil. Vid lyckad
+*                          ndring returneras 0, annars returneras felkod 1.
+*
+*                          - filepath: Skvgen till filen som ska ndras.
+*                          - offset  : Bytens position i filen.
+**************************************************************************************************/
+static int int_vector_test_corrupt(const char* filepath,
+                                   const long offset)
+{
+   FILE* file = fopen(filepath, "r+b");
+   if (!file) return 1;
+   const int c = fseek(file, offset, SEEK_SET) ? EOF : fgetc(file);
+
+   if (c == EOF || fseek(file, offset, SEEK_SET) || fputc(~c & 0xff, file) == EOF)
+   {
+      fclose(file);
+      return 1;
+   }
+
+   return fclose(file) != 0;
+}
+
+/**************************************************************************************************
+* int_vector_test_files: Kontrollerar att en vektor som sparas via int_vector_save terskapas
+*                        av int_vector_load och int_vector_map, ven d vektorn r tom, och att
+*                        tilldelning via en mappad vektor inte ndrar filen. Drefter kontrolleras
+*                        att filer med felaktig kontrollsumma, felaktigt huvud eller fr f
+*                        element avvisas och att vektorn d lmnas tom.
+**************************************************************************************************/
+static int int_vector_test_files(void)
+{
+   const size_t header_size = 32;
+   struct int_vector source, target;
+   uint32_t state = 2718281828u;
+   int error = 0;
+
+   int_vector_init(&source);
+   int_vector_init(&target);
+
+   if (int_vector_save(&source, INT_VECTOR_TEST_FILE) ||
+       int_vector_assign_fill(&target, 3, 1) || int_vector_load(&target, INT_VECTOR_TEST_FILE) ||
+       target.size || int_vector_assign_fill(&target, 3, 1) ||
+       int_vector_map(&target, INT_VECTOR_TEST_FILE) || target.size)
+   {
+      error = 1;
+   }
+
+   if (int_vector_test_fill(&source, 1000, 0, &state))
+   {
+      error = 1;
+   }
+   else
+   {
+      source.data[0] = INT_MIN;
+      source.data[999] = INT_MAX;
+
+      if (int_vector_save(&source, INT_VECTOR_TEST_FILE) ||
+          int_vector_load(&target, INT_VECTOR_TEST_FILE) ||
+          !int_vector_test_equal(&target, &source) ||
+          int_vector_map(&target, INT_VECTOR_TEST_FILE) ||
+          !int_vector_test_equal(&target, &source))
+      {
+         error = 1;
+      }
+
+      int* data = int_vector_begin(&target);
+
+      if (!data)
+      {
+         error = 1;
+      }
+      else
+      {
+         data[0] = 0;
+         data[500] = 0;
+
+         if (int_vector_push(&target, 5) || target.size != 1001 || target.data[0] ||
+             target.data[500] || target.data[1000] != 5 ||
+             int_vector_load(&target, INT_VECTOR_TEST_FILE) ||
+             !int_vector_test_equal(&target, &source))
+         {
+            error = 1;
+         }
+      }
+
+      if (int_vector_test_corrupt(INT_VECTOR_TEST_FILE, (long)header_size + 2000) ||
+          !int_vector_load(&target, INT_VECTOR_TEST_FILE) || target.size ||
+          int_vector_test_corrupt(INT_VECTOR_TEST_FILE, (long)header_size + 2000) ||
+          int_vector_test_corrupt(INT_VECTOR_TEST_FILE, 0) ||
+          int_vector_assign_fill(&target, 3, 1) ||
+          !int_vector_load(&target, INT_VECTOR_TEST_FILE) || target.size ||
+          int_vector_assign_fill(&target, 3, 1) ||
+          !int_vector_map(&target, INT_VECTOR_TEST_FILE) || target.size ||
+          int_vector_test_corrupt(INT_VECTOR_TEST_FILE, 0) ||
+          truncate(INT_VECTOR_TEST_FILE, (off_t)(header_size + 999 * sizeof(int))) ||
+          int_vector_assign_fill(&target, 3, 1) ||
+          !int_vector_load(&target, INT_VECTOR_TEST_FILE) || target.size ||
+          int_vector_assign_fill(&target, 3, 1) ||
+          !int_vector_map(&target, INT_VECTOR_TEST_FILE) || target.size)
+      {
+         error = 1;
+      }
+   }
+
+   remove(INT_VECTOR_TEST_FILE);
+
+   if (!int_vector_load(&target, INT_VECTOR_TEST_FILE) ||
+       !int_vector_map(&target, INT_VECTOR_TEST_FILE))
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&source);
+   int_vector_clear(&target);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_changes: Kontrollerar att en kopia som uppdateras via int_vector_save_changes
+*                          och int_vector_apply_changes efter slumpmssiga ndringar blir lik
+*                          originalet, att intervallet frn int_vector_dirty_range fljer
+*                          ndringarna samt att en skadad fil upptcks via kontrollsumman.
+**************************************************************************************************/
+static int int_vector_test_changes(void)
+{
+   struct int_vector source, replica;
+   uint32_t state = 88675123u;
+   size_t first, last;
+   int error = 0;
+
+   int_vector_init(&source);
+   int_vector_init(&replica);
+   if (int_vector_track(&source) || int_vector_track(&replica)) error = 1;
+
+   for (int i = 0; i < 5000; ++i)
+   {
+      int_vector_push(&source, i);
+   }
+
+   if (!int_vector_dirty_range(&source, &first, &last) || first != 0 || last != 5000 ||
+       int_vector_save_changes(&source, INT_VECTOR_TEST_FILE) ||
+       int_vector_apply_changes(&replica, INT_VECTOR_TEST_FILE))
+   {
+      error = 1;
+   }
+
+   int_vector_mark_clean(&source);
+   int_vector_pop(&source);
+   if (!int_vector_dirty_range(&source, &first, &last) || first != 4999 || last != 4999) error = 1;
+   source.data[3000] = -1;
+   int_vector_mark_dirty(&source, 3000, 1);
+   if (!int_vector_dirty_range(&source, &first, &last) || first != 3000 || last != 4999) error = 1;
+
+   for (size_t round = 0; round < 100 && !error; ++round)
+   {
+      const uint32_t value = int_vector_test_random(&state);
+      const size_t index = source.size ? value % source.size : 0;
+      const int range[3] = { (int)value, 1, 2 };
+
+      switch (value % 4)
+      {
+         case 0: int_vector_push(&source, (int)value); break;
+         case 1: int_vector_resize(&source, value % 20000); break;
+         case 2: int_vector_insert_range(&source, index, range, 3); break;
+         default:
+            if (source.size)
+            {
+               source.data[index] = (int)value;
+               int_vector_mark_dirty(&source, index, 1);
+            }
+            break;
+      }
+
+      if (int_vector_save_changes(&source, INT_VECTOR_TEST_FILE) ||
+          int_vector_apply_changes(&replica, INT_VECTOR_TEST_FILE) ||
+          !int_vector_test_equal(&source, &replica))
+      {
+         error = 1;
+      }
+
+      int_vector_mark_clean(&source);
+   }
+
+   if (!error && source.size)
+   {
+      source.data[0] = ~source.data[0];
+      int_vector_mark_dirty(&source, 0, 1);
+      int_vector_save_changes(&source, INT_VECTOR_TEST_FILE);
+      FILE* file = fopen(INT_VECTOR_TEST_FILE, "r+b");
+
+      if (!file || fseek(file, -1, SEEK_END) || fputc(0x5a, file) == EOF || fclose(file))
+      {
+         error = 1;
+      }
+      else if (!int_vector_apply_changes(&replica, INT_VECTOR_TEST_FILE))
+      {
+         error = 1;
+      }
+   }
+
+   remove(INT_VECTOR_TEST_FILE);
+   int_vector_clear(&source);
+   int_vector_clear(&replica);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_compressed: Kontrollerar att komprimering fljd av uppackning terskapar
+*                             lngsamt varierande, aritmetiska, konstanta och slumpmssiga
+*                             sekvenser av samtliga storlekar upp till tre block samt en stor
+*                             storlek, via int_vector_compressed_decode, decode_block och at.
+**************************************************************************************************/
+static int int_vector_test_compressed(void)
+{
+   struct int_vector_compressed compressed;
+   struct int_vector original, decoded;
+   int block[INT_VECTOR_COMPRESSED_BLOCK_SIZE];
+   uint32_t state = 123456789u;
+   int error = 0;
+
+   int_vector_compressed_init(&compressed);
+   int_vector_init(&original);
+   int_vector_init(&decoded);
+
+   for (size_t size = 0; size <= 3 * INT_VECTOR_COMPRESSED_BLOCK_SIZE + 1 && !error; ++size)
+   {
+      for (int kind = 0; kind < 4 && !error; ++kind)
+      {
+         const size_t length = size == 3 * INT_VECTOR_COMPRESSED_BLOCK_SIZE + 1 ?
+                               INT_VECTOR_TEST_LARGE : size;
+         unsigned int value = int_vector_test_random(&state);
+         if (int_vector_resize(&original, length)) error = 1;
+
+         for (size_t i = 0; i < original.size; ++i)
+         {
+            switch (kind)
+            {
+               case 0: value += int_vector_test_random(&state) % 7 - 3; break;
+               case 1: value += 2; break;
+               case 2: break;
+               default: value = int_vector_test_random(&state); break;
+            }
+
+            original.data[i] = (int)value;
+         }
+
+         if (int_vector_compressed_encode_vector(&compressed, &original) ||
+             int_vector_compressed_decode(&compressed, &decoded) ||
+             !int_vector_test_equal(&original, &decoded))
+         {
+            error = 1;
+         }
+
+         for (size_t i = 0; i < compressed.block_count && !error; ++i)
+         {
+            const size_t first = i * INT_VECTOR_COMPRESSED_BLOCK_SIZE;
+            const size_t count = int_vector_compressed_decode_block(&compressed, i, block);
+            if (!count || memcmp(block, original.data + first, sizeof(int) * count)) error = 1;
+         }
+
+         if (length)
+         {
+            int element;
+            const size_t index = int_vector_test_random(&state) % length;
+            if (int_vector_compressed_at(&compressed, index, &element) ||
+                element != original.data[index])
+            {
+               error = 1;
+            }
+         }
+      }
+   }
+
+   int_vector_compressed_clear(&compressed);
+   int_vector_clear(&original);
+   int_vector_clear(&decoded);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_set_naive: Berknar union (0), snitt (1) eller differens (2) av tv sorterade
+*                            vektorer via en enkel sammanslagning, som facit. Vid lyckad
+*                            berkning returneras 0, annars returneras felkod 1.
+*
+*                            - dest     : Pekare till vektorn som ska tilldelas resultatet.
+*                            - lhs      : Pekare till den frsta sorterade vektorn.
+*                            - rhs      : Pekare till den andra sorterade vektorn.
+*                            - operation: Mngdoperationen (0 = union, 1 = snitt, 2 = differens).
+**************************************************************************************************/
+static int int_vector_test_set_naive(struct int_vector* dest,
+                                     const struct int_vector* lhs,
+                                     const struct int_vector* rhs,
+                                     const int operation)
+{
+   size_t i = 0, j = 0;
+   int error = int_vector_resize(dest, 0);
+
+   while (!error && (i < lhs->size || j < rhs->size))
+   {
+      if (j == rhs->size || (i < lhs->size && lhs->data[i] < rhs->data[j]))
+      {
+         if (operation != 1) error = int_vector_push(dest, lhs->data[i]);
+         i++;
+      }
+      else if (i == lhs->size || rhs->data[j] < lhs->data[i])
+      {
+         if (operation == 0) error = int_vector_push(dest, rhs->data[j]);
+         j++;
+      }
+      else
+      {
+         if (operation != 2) error = int_vector_push(dest, lhs->data[i]);
+         i++;
+         j++;
+      }
+   }
+
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_set: Jmfr int_vector_set_union, int_vector_set_intersection och
+*                      int_vector_set_difference med en enkel sammanslagning fr sekvenser av
+*                      olika storlek och storleksfrhllande, s att ven galoppering prvas,
+*                      samt d destinationen r samma vektor som en av kllorna. Drutver
+*                      jmfrs int_vector_set_unique med en enkel borttagning av dubbletter.
+**************************************************************************************************/
+static int int_vector_test_set(void)
+{
+   static const size_t sizes[] = { 0, 1, 2, 7, 64, 1000, 40000 };
+   static const int scales[] = { 1, 3, 64 };
+   int (*const operations[])(struct int_vector*, const struct int_vector*,
+                             const struct int_vector*) =
+      { int_vector_set_union, int_vector_set_intersection, int_vector_set_difference };
+   struct int_vector lhs, rhs, result, expected, copy;
+   uint32_t state = 521288629u;
+   int error = 0;
+
+   int_vector_init(&lhs);
+   int_vector_init(&rhs);
+   int_vector_init(&result);
+   int_vector_init(&expected);
+   int_vector_init(&copy);
+
+   for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes) && !error; ++i)
+   {
+      for (size_t j = 0; j < sizeof(sizes) / sizeof(*sizes) && !error; ++j)
+      {
+         const int scale = scales[(i + j) % (sizeof(scales) / sizeof(*scales))];
+
+         if (int_vector_test_fill_sorted(&lhs, sizes[i], 1, &state) ||
+             int_vector_test_fill_sorted(&rhs, sizes[j], scale, &state))
+         {
+            error = 1;
+         }
+
+         for (int operation = 0; operation < 3 && !error; ++operation)
+         {
+            if (int_vector_test_set_naive(&expected, &lhs, &rhs, operation) ||
+                operations[operation](&result, &lhs, &rhs) ||
+                !int_vector_test_equal(&result, &expected) ||
+                int_vector_clone(&copy, &lhs) ||
+                operations[operation](&copy, &copy, &rhs) ||
+                !int_vector_test_equal(&copy, &expected))
+            {
+               error = 1;
+            }
+         }
+      }
+   }
+
+   for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes) && !error; ++i)
+   {
+      if (int_vector_test_fill(&lhs, sizes[i], 50, &state) || int_vector_sort(&lhs) ||
+          int_vector_resize(&expected, 0))
+      {
+         error = 1;
+      }
+
+      for (size_t k = 0; k < lhs.size && !error; ++k)
+      {
+         if (!k || lhs.data[k] != lhs.data[k - 1]) error = int_vector_push(&expected, lhs.data[k]);
+      }
+
+      if (int_vector_set_unique(&lhs) || !int_vector_test_equal(&lhs, &expected)) error = 1;
+   }
+
+   int_vector_clear(&lhs);
+   int_vector_clear(&rhs);
+   int_vector_clear(&result);
+   int_vector_clear(&expected);
+   int_vector_clear(&copy);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_index: Jmfr int_vector_index_contains samt int_vector_index_of med linjr
+*                        skning fr en osorterad vektor med dubbletter, dr index till det
+*                        frsta lika elementet ska returneras, samt fr vrden som saknas.
+**************************************************************************************************/
+static int int_vector_test_index(void)
+{
+   struct int_vector_index index;
+   struct int_vector vector;
+   uint32_t state = 362436069u;
+   int error = 0;
+
+   int_vector_index_init(&index);
+   int_vector_init(&vector);
+
+   for (size_t size = 0; size <= 2000 && !error; size = size * 3 + 1)
+   {
+      if (int_vector_test_fill(&vector, size, (uint32_t)size + 1, &state) ||
+          int_vector_index_build(&index, &vector))
+      {
+         error = 1;
+      }
+
+      for (int value = -2; value <= (int)size + 2 && !error; ++value)
+      {
+         size_t expected = 0, position = 0;
+         while (expected < vector.size && vector.data[expected] != value) expected++;
+         const int found = expected < vector.size;
+
+         if (int_vector_index_contains(&index, value) != found ||
+             int_vector_index_of(&index, value, &position) != !found ||
+             (found && position != expected))
+         {
+            error = 1;
+         }
+      }
+   }
+
+   int_vector_index_clear(&index);
+   int_vector_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_ring_produce: Producentens trd, som skickar heltalen 0, 1, 2... via
+*                               ringbufferten, ett i taget eller i block.
+*
+*                               - arg: Pekare till producentens uppgift.
+**************************************************************************************************/
+static void* int_vector_test_ring_produce(void* arg)
+{
+   const struct int_vector_test_ring_task* task = (const struct int_vector_test_ring_task*)arg;
+   int batch[INT_VECTOR_TEST_RING_BATCH];
+   size_t sent = 0;
+
+   while (sent < task->count)
+   {
+      const size_t remaining = task->count - sent;
+      const size_t n = remaining < task->batch ? remaining : task->batch;
+
+      for (size_t i = 0; i < n; ++i)
+      {
+         batch[i] = (int)(sent + i);
+      }
+
+      for (size_t pushed = 0; pushed < n;)
+      {
+         const size_t count = task->batch == 1 ? !int_ring_push(task->ring, batch[0])
+                                               : int_ring_push_range(task->ring, batch + pushed,
+                                                                     n - pushed);
+         if (!count) sched_yield();
+         pushed += count;
+      }
+
+      sent += n;
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_test_ring: Stresstest fr int_ring, dr en producenttrd skickar angivet antal
+*                       heltal via en liten ringbuffert och konsumenten kontrollerar att
+*                       samtliga tas emot exakt en gng i rtt ordning.
+*
+*                       - count: Antalet heltal som ska skickas.
+*                       - batch: Antalet heltal per anrop (1 = int_ring_push och int_ring_pop).
+**************************************************************************************************/
+static int int_vector_test_ring(const size_t count,
+                                const size_t batch)
+{
+   struct int_ring ring;
+   struct int_vector_test_ring_task task;
+   pthread_t producer;
+   int buffer[INT_VECTOR_TEST_RING_BATCH];
+   size_t received = 0;
+   int error = 0;
+
+   if (int_ring_init(&ring, INT_VECTOR_TEST_RING_CAPACITY)) return 1;
+   task.ring = &ring;
+   task.count = count;
+   task.batch = batch;
+
+   if (pthread_create(&producer, 0, int_vector_test_ring_produce, &task))
+   {
+      int_ring_clear(&ring);
+      return 1;
+   }
+
+   while (received < count)
+   {
+      const size_t n = batch == 1 ? !int_ring_pop(&ring, buffer)
+                                  : int_ring_pop_range(&ring, buffer, batch);
+      if (!n) sched_yield();
+
+      for (size_t i = 0; i < n; ++i)
+      {
+         if (buffer[i] != (int)(received + i)) error = 1;
+      }
+
+      received += n;
+   }
+
+   pthread_join(producer, 0);
+   int_ring_clear(&ring);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_concurrent_write: Skrivande trd, som lgger till heltalen first, first + 1...
+*                                   last - 1 i den delade vektorn.
+*
+*                                   - arg: Pekare till trdens uppgift.
+**************************************************************************************************/
+static void* int_vector_test_concurrent_write(void* arg)
+{
+   const struct int_vector_test_writer_task* task =
+      (const struct int_vector_test_writer_task*)arg;
+
+   for (size_t i = task->first; i < task->last; ++i)
+   {
+      int_vector_concurrent_push(task->vector, (int)i);
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* int_vector_test_concurrent: Lter INT_VECTOR_TEST_WRITERS trdar lgga till heltal samtidigt
+*                             i en int_vector_concurrent och kontrollerar att den utplattade
+*                             vektorn innehller varje heltal exakt en gng.
+**************************************************************************************************/
+static int int_vector_test_concurrent(void)
+{
+   struct int_vector_concurrent vector;
+   struct int_vector_test_writer_task tasks[INT_VECTOR_TEST_WRITERS];
+   pthread_t threads[INT_VECTOR_TEST_WRITERS];
+   struct int_vector flat;
+   const size_t count = 1000003;
+   size_t started = 0;
+   int error = 0;
+
+   int_vector_concurrent_init(&vector);
+   int_vector_init(&flat);
+
+   for (size_t i = 0; i < INT_VECTOR_TEST_WRITERS; ++i)
+   {
+      tasks[i].vector = &vector;
+      tasks[i].first = count * i / INT_VECTOR_TEST_WRITERS;
+      tasks[i].last = count * (i + 1) / INT_VECTOR_TEST_WRITERS;
+      if (pthread_create(&threads[i], 0, int_vector_test_concurrent_write, &tasks[i])) break;
+      started++;
+   }
+
+   for (size_t i = 0; i < started; ++i)
+   {
+      pthread_join(threads[i], 0);
+   }
+
+   if (started < INT_VECTOR_TEST_WRITERS || int_vector_concurrent_flatten(&vector, &flat) ||
+       flat.size != count || int_vector_sort(&flat))
+   {
+      error = 1;
+   }
+
+   for (size_t i = 0; i < flat.size && !error; ++i)
+   {
+      if (flat.data[i] != (int)i) error = 1;
+   }
+
+   int_vector_clear(&flat);
+   int_vector_concurrent_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_concurrent_failure: Kontrollerar att en misslyckad allokering av ett segment i
+*                                     int_vector_concurrent_push_range inte lmnar reserverade
+*                                     platser oskrivna, s att element som lggs till eftert
+*                                     fortfarande publiceras.
+**************************************************************************************************/
+static int int_vector_test_concurrent_failure(void)
+{
+   struct int_vector_test_allocator allocator;
+   struct int_vector_concurrent vector;
+   struct int_vector flat;
+   int values[INT_VECTOR_CONCURRENT_FIRST_SIZE + 10];
+   const size_t count = sizeof(values) / sizeof(*values);
+   int error = 0;
+
+   for (size_t i = 0; i < count; ++i)
+   {
+      values[i] = (int)i;
+   }
+
+   int_vector_test_allocator_init(&allocator, 1);
+   int_vector_concurrent_init_with_allocator(&vector, &allocator.allocator);
+   int_vector_init(&flat);
+
+   if (int_vector_concurrent_push_range(&vector, values, INT_VECTOR_CONCURRENT_FIRST_SIZE - 5) ||
+       !int_vector_concurrent_push_range(&vector, values + INT_VECTOR_CONCURRENT_FIRST_SIZE - 5,
+                                         10) ||
+       int_vector_concurrent_size(&vector) != INT_VECTOR_CONCURRENT_FIRST_SIZE - 5)
+   {
+      error = 1;
+   }
+
+   allocator.remaining = 1;
+
+   if (int_vector_concurrent_push_range(&vector, values + INT_VECTOR_CONCURRENT_FIRST_SIZE - 5,
+                                        15) ||
+       int_vector_concurrent_size(&vector) != count ||
+       int_vector_concurrent_flatten(&vector, &flat) || flat.size != count ||
+       memcmp(flat.data, values, sizeof(values)))
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&flat);
+   int_vector_concurrent_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_parallel: Jmfr int_vector_parallel_sum samt int_vector_parallel_assign_step
+*                           med motsvarande funktioner som krs av den anropande trden, samt
+*                           kontrollerar att en tilldelning som minskar storleken till 0
+*                           registreras av sprningen av ndringar.
+**************************************************************************************************/
+static int int_vector_test_parallel(void)
+{
+   static const size_t sizes[] = { 0, 1, 17, 4096, 1000003 };
+   struct int_vector vector, expected;
+   uint32_t state = 88675123u;
+   size_t first, last;
+   int error = 0;
+
+   int_vector_init(&vector);
+   int_vector_init(&expected);
+   if (int_vector_track(&vector)) error = 1;
+
+   for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes) && !error; ++i)
+   {
+      if (int_vector_test_fill(&vector, sizes[i], 0, &state) ||
+          int_vector_parallel_sum(&vector) != int_vector_sum(&vector) ||
+          int_vector_assign_step(&expected, sizes[i], (int)sizes[i], -1) ||
+          int_vector_parallel_assign_step(&vector, sizes[i], (int)sizes[i], -1) ||
+          !int_vector_test_equal(&vector, &expected) ||
+          int_vector_checksum(&vector) != vector_checksum(vector.data, sizeof(int) * vector.size))
+      {
+         error = 1;
+      }
+   }
+
+   int_vector_mark_clean(&vector);
+   if (int_vector_parallel_assign_step(&vector, 0, 0, 1) || vector.size ||
+       !int_vector_dirty_range(&vector, &first, &last))
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&vector);
+   int_vector_clear(&expected);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_arena: Kontrollerar tv vektorer som vxer omvxlande i samma arena, s att
+*                        flten bde utkas p plats och kopieras, ver flera av arenans
+*                        minnesblock, fljt av krympning och tmning. Efter arena_reset ska
+*                        samma minne delas ut igen utan att nya minnesblock allokeras.
+**************************************************************************************************/
+static int int_vector_test_arena(void)
+{
+   struct arena arena;
+   struct int_vector lhs, rhs;
+   int* first = 0;
+   size_t chunk_count = 0;
+   int error = 0;
+
+   arena_init(&arena, 4096);
+
+   for (int round = 0; round < 2 && !error; ++round)
+   {
+      int_vector_init_with_allocator(&lhs, &arena.allocator);
+      int_vector_init_with_allocator(&rhs, &arena.allocator);
+
+      for (int i = 0; i < 5000 && !error; ++i)
+      {
+         if (int_vector_push(&lhs, i) || (i % 3 == 0 && int_vector_push(&rhs, -i))) error = 1;
+         if (i == 12 && !round) first = lhs.data;
+         if (i == 12 && round && lhs.data != first) error = 1;
+      }
+
+      if (error || int_vector_resize(&lhs, 100) || int_vector_shrink_to_fit(&lhs) ||
+          lhs.capacity != 100 || rhs.size != 1667)
+      {
+         error = 1;
+      }
+
+      for (size_t i = 0; i < lhs.size && !error; ++i)
+      {
+         if (lhs.data[i] != (int)i) error = 1;
+      }
+
+      for (size_t i = 0; i < rhs.size && !error; ++i)
+      {
+         if (rhs.data[i] != -(int)i * 3) error = 1;
+      }
+
+      int_vector_clear(&lhs);
+      if (rhs.size != 1667 || rhs.data[1666] != -4998) error = 1;
+      int_vector_clear(&rhs);
+
+      size_t count = 0;
+      for (const struct arena_chunk* i = arena.first; i; i = i->next) count++;
+      if (round && count != chunk_count) error = 1;
+      chunk_count = count;
+      arena_reset(&arena);
+   }
+
+   if (chunk_count < 2) error = 1;
+   arena_clear(&arena);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_pool: Kontrollerar att ett block som frigrs av en vektor i en pool
+*                       teranvnds av nsta vektor i samma storleksklass, att samtidigt
+*                       anvnda block inte verlappar samt att vektorer kan vxa frn
+*                       storleksklasserna till block som allokeras direkt via malloc och
+*                       krympa tillbaka med bevarat innehll. Lckor och felaktig anvndning
+*                       av direktallokerade block upptcks via ASan.
+**************************************************************************************************/
+static int int_vector_test_pool(void)
+{
+   struct pool pool;
+   struct int_vector lhs, rhs, large;
+   int error = 0;
+
+   pool_init(&pool);
+   int_vector_init_with_allocator(&lhs, &pool.allocator);
+   int_vector_init_with_allocator(&rhs, &pool.allocator);
+   int_vector_init_with_allocator(&large, &pool.allocator);
+
+   if (int_vector_reserve(&lhs, 100))
+   {
+      error = 1;
+   }
+   else
+   {
+      int* block = lhs.data;
+      int_vector_clear(&lhs);
+
+      if (int_vector_reserve(&lhs, 110) || lhs.data != block ||
+          int_vector_reserve(&rhs, 110) || rhs.data == block ||
+          int_vector_assign_fill(&lhs, 110, 1) || int_vector_assign_fill(&rhs, 110, 2))
+      {
+         error = 1;
+      }
+
+      for (size_t i = 0; i < 110 && !error; ++i)
+      {
+         if (lhs.data[i] != 1 || rhs.data[i] != 2) error = 1;
+      }
+   }
+
+   for (int i = 0; i < 10000 && !error; ++i)
+   {
+      if (int_vector_push(&large, i * 7)) error = 1;
+   }
+
+   if (error || int_vector_resize(&large, 50) || int_vector_shrink_to_fit(&large) ||
+       large.capacity != 50 || large.data == large.inline_data)
+   {
+      error = 1;
+   }
+
+   for (size_t i = 0; i < large.size && !error; ++i)
+   {
+      if (large.data[i] != (int)i * 7) error = 1;
+   }
+
+   int_vector_clear(&lhs);
+   int_vector_clear(&rhs);
+   int_vector_clear(&large);
+   pool_clear(&pool);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_huge: Kontrollerar att en vektor vars flt allokeras via huge_allocator r
+*                       justerad till HUGE_ALLOCATOR_ALIGNMENT byte, eller till
+*                       HUGE_ALLOCATOR_HUGE_PAGE_SIZE byte d fltet r mappat, och behller sitt
+*                       innehll d den vxer frbi trskelvrdet fr minnesmappning.
+**************************************************************************************************/
+static int int_vector_test_huge(void)
+{
+   struct huge_allocator huge;
+   struct int_vector vector;
+   const size_t count = 3 * HUGE_ALLOCATOR_DEFAULT_THRESHOLD / sizeof(int);
+   int error = 0;
+
+   huge_allocator_init(&huge, 0);
+   int_vector_init_with_allocator(&vector, &huge.allocator);
+
+   for (size_t i = 0; i < count && !error; ++i)
+   {
+      if (int_vector_push(&vector, (int)i)) error = 1;
+
+      if (vector.data != vector.inline_data &&
+          (uintptr_t)vector.data % (huge_allocator_mapped(&huge, sizeof(int) * vector.capacity) ?
+                                    HUGE_ALLOCATOR_HUGE_PAGE_SIZE : HUGE_ALLOCATOR_ALIGNMENT))
+      {
+         error = 1;
+      }
+   }
+
+   for (size_t i = 0; i < vector.size && !error; ++i)
+   {
+      if (vector.data[i] != (int)i) error = 1;
+   }
+
+   int_vector_clear(&vector);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_move: Flyttar ett heapallokerat flt till en vektor allokerad via en arena samt
+*                       ett flt allokerat via arenan till en heapallokerad vektor via
+*                       int_vector_move. Vektorerna frigrs sedan via int_vector_delete, vilket
+*                       ska frigra varje block via den allokator det allokerades med (kontrolleras
+*                       vid kompilering med -fsanitize=address).
+**************************************************************************************************/
+static int int_vector_test_move(void)
+{
+   struct arena arena;
+   struct int_vector source;
+   struct int_vector* vectors[2];
+   uint32_t state = 7u;
+   int error = 0;
+
+   arena_init(&arena, 0);
+   vectors[0] = int_vector_new_with_allocator(0, &arena.allocator);
+   vectors[1] = int_vector_new(0);
+
+   for (size_t i = 0; i < 2; ++i)
+   {
+      int_vector_init_with_allocator(&source, i ? &arena.allocator : 0);
+
+      if (!vectors[i] || int_vector_test_fill(&source, 1000, 0, &state))
+      {
+         error = 1;
+      }
+      else
+      {
+         const int last = source.data[source.size - 1];
+         int_vector_move(vectors[i], &source);
+
+         if (vectors[i]->size != 1000 || vectors[i]->data[999] != last || source.size ||
+             int_vector_push(vectors[i], last) || vectors[i]->data[999] != last)
+         {
+            error = 1;
+         }
+      }
+
+      int_vector_clear(&source);
+      if (vectors[i]) int_vector_delete(&vectors[i]);
+   }
+
+   arena_clear(&arena);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_share: Kontrollerar att en vektor som delas via int_vector_share kopieras vid
+*                        frsta ndringen, utan att originalet pverkas, samt att en kopia via
+*                        int_vector_clone r oberoende av originalet. Drutver kontrolleras att
+*                        int_vector_cbegin returnerar det delade fltet, medan skrivning via
+*                        int_vector_begin kopierar det och markerar elementen som ndrade.
+**************************************************************************************************/
+static int int_vector_test_share(void)
+{
+   struct int_vector source, shared, clone;
+   uint32_t state = 42u;
+   size_t first, last;
+   int error = 0;
+
+   int_vector_init(&source);
+   int_vector_init(&shared);
+   int_vector_init(&clone);
+
+   if (int_vector_test_fill(&source, 1000, 0, &state) || int_vector_share(&shared, &source) ||
+       int_vector_clone(&clone, &source) || shared.data != source.data || !shared.shared ||
+       clone.data == source.data || !int_vector_test_equal(&clone, &source))
+   {
+      error = 1;
+   }
+
+   if (!error)
+   {
+      const int first = source.data[0];
+      if (int_vector_erase_range(&shared, 0, 1) || shared.data == source.data ||
+          source.data[0] != first || shared.size != 999 || source.size != 1000 ||
+          memcmp(shared.data, source.data + 1, sizeof(int) * shared.size))
+      {
+         error = 1;
+      }
+   }
+
+   if (!error)
+   {
+      if (int_vector_share(&shared, &source) || int_vector_track(&shared) ||
+          int_vector_cbegin(&shared) != source.data)
+      {
+         error = 1;
+      }
+
+      int_vector_mark_clean(&shared);
+
+      for (int* i = int_vector_begin(&shared); i && i < int_vector_end(&shared); ++i)
+      {
+         *i = ~*i;
+      }
+
+      if (shared.data == source.data || shared.size != source.size ||
+          !int_vector_dirty_range(&shared, &first, &last) || first != 0 || last != source.size)
+      {
+         error = 1;
+      }
+
+      for (size_t i = 0; i < shared.size && !error; ++i)
+      {
+         if (shared.data[i] != ~source.data[i] || clone.data[i] != source.data[i]) error = 1;
+      }
+   }
+
+   int_vector_clear(&source);
+   int_vector_clear(&shared);
+   int_vector_clear(&clone);
+   return error;
+}
+
+
+/**************************************************************************************************
+* int_vector_test_item_copy: Kopierar angivet antal element till oinitierat minne, dr varje
+*                            kopia tilldelas ett eget heapallokerat heltal, och rknar kopiorna.
+*
+*                            - dest: Pekare till destinationen.
+*                            - src : Pekare till elementen som ska kopieras.
+*                            - n   : Antalet element som ska kopieras.
+**************************************************************************************************/
+static void int_vector_test_item_copy(struct int_vector_test_item* dest,
+                                      const struct int_vector_test_item* src,
+                                      const size_t n)
+{
+   for (size_t i = 0; i < n; ++i)
+   {
+      dest[i].value = 0;
+
+      if (src[i].value)
+      {
+         dest[i].value = (int*)malloc(sizeof(int));
+         if (dest[i].value) *dest[i].value = *src[i].value;
+      }
+   }
+
+   int_vector_test_copies += n;
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_test_item_destroy: Frigr de heltal som gs av angivet antal element och rknar de
+*                               frigjorda elementen.
+*
+*                               - data: Pekare till elementen som ska frigras.
+*                               - n   : Antalet element som ska frigras.
+**************************************************************************************************/
+static void int_vector_test_item_destroy(struct int_vector_test_item* data,
+                                         const size_t n)
+{
+   for (size_t i = 0; i < n; ++i)
+   {
+      free(data[i].value);
+   }
+
+   int_vector_test_destroys += n;
+   return;
+}
+
+/**************************************************************************************************
+* int_vector_test_item_check: Returnerar 1 ifall angiven vektor innehller angivna heltal, dr
+*                             0 motsvarar ett element utan heltal, annars returneras 0.
+*
+*                             - self  : Pekare till vektorn som ska kontrolleras.
+*                             - values: Pekare till de frvntade heltalen.
+*                             - size  : Det frvntade antalet element.
+**************************************************************************************************/
+static int int_vector_test_item_check(const struct int_vector_test_item_vector* self,
+                                      const int* values,
+                                      const size_t size)
+{
+   if (self->size != size) return 0;
+
+   for (size_t i = 0; i < size; ++i)
+   {
+      const int* value = self->data[i].value;
+      if (value ? *value != values[i] : values[i] != 0) return 0;
+   }
+
+   return 1;
+}
+
+#ifdef VECTOR_STATS
+/**************************************************************************************************
+* int_vector_test_stats: Kontrollerar allokeringsstatistiken, bde fr vektorn och globalt, efter
+*                        100 tillgg till en tom vektor. Det inbyggda fltet rymmer 12 element
+*                        och kapaciteten frdubblas drefter, vilket ger en allokering av 24
+*                        element fljt av omallokeringar till 48, 96 och 192 element. Drefter
+*                        krymps fltet till 100 element och frigrs. Slutligen kontrolleras en
+*                        misslyckad allokering samt allokering av vektorstrukten via new.
+**************************************************************************************************/
+static int int_vector_test_stats(void)
+{
+   struct int_vector_test_allocator allocator;
+   struct int_vector vector;
+   struct vector_stats stats;
+   int error = 0;
+
+   vector_stats_reset(0);
+   int_vector_init(&vector);
+
+   for (int i = 0; i < 100 && !error; ++i)
+   {
+      if (int_vector_push(&vector, i)) error = 1;
+   }
+
+   stats = vector.stats;
+
+   if (error || stats.allocations != 1 || stats.reallocations != 3 || stats.deallocations ||
+       stats.moves > 3 || stats.bytes_copied < 12 * sizeof(int) ||
+       stats.live_bytes != 192 * sizeof(int) || stats.peak_bytes != 192 * sizeof(int) ||
+       stats.peak_capacity != 192 || stats.failed_allocations ||
+       int_vector_shrink_to_fit(&vector) || vector.stats.reallocations != 4 ||
+       vector.stats.live_bytes != 100 * sizeof(int) ||
+       vector.stats.peak_bytes != 192 * sizeof(int))
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&vector);
+
+   if (vector.stats.deallocations != 1 || vector.stats.live_bytes ||
+       vector_stats_global.allocations != 1 || vector_stats_global.reallocations != 4 ||
+       vector_stats_global.deallocations != 1 || vector_stats_global.live_bytes ||
+       vector_stats_global.moves != vector.stats.moves ||
+       vector_stats_global.bytes_copied != vector.stats.bytes_copied)
+   {
+      error = 1;
+   }
+
+   int_vector_test_allocator_init(&allocator, 0);
+   int_vector_init_with_allocator(&vector, &allocator.allocator);
+
+   for (int i = 0; i < 13; ++i)
+   {
+      int_vector_push(&vector, i);
+   }
+
+   if (vector.size != 12 || vector.stats.allocations || vector.stats.failed_allocations != 1 ||
+       vector_stats_global.failed_allocations != 1)
+   {
+      error = 1;
+   }
+
+   int_vector_clear(&vector);
+   struct int_vector* created = int_vector_new(0);
+
+   if (!created || vector_stats_global.allocations != 2)
+   {
+      error = 1;
+   }
+
+   int_vector_delete(&created);
+   if (vector_stats_global.deallocations != 2 || vector_stats_global.live_bytes) error = 1;
+   return error;
+}
+#endif /* VECTOR_STATS */
+
+/**************************************************************************************************
+* int_vector_test_int64: Kontrollerar en vektor av 64-bitars heltal, genererad via mallen i
+*                        vector.h med tv element i det inbyggda fltet, mot ett vanligt flt
+*                        vid tillgg, insttning och borttagning i brjan, mitten och slutet,
+*                        kloning, delning fljd av skrivning samt krympning till det inbyggda
+*                        fltet.
+**************************************************************************************************/
+static int int_vector_test_int64(void)
+{
+   const size_t count = 1000;
+   struct int_vector_test_int64_vector vector, clone, shared;
+   int64_t* expected = (int64_t*)malloc(sizeof(int64_t) * (count + 4));
+   const int64_t ends[2] = { INT64_MIN, INT64_MAX };
+   int error = 0;
+
+   int_vector_test_int64_vector_init(&vector);
+   int_vector_test_int64_vector_init(&clone);
+   int_vector_test_int64_vector_init(&shared);
+   if (!expected) return 1;
+
+   for (size_t i = 0; i < count && !error; ++i)
+   {
+      expected[i] = (int64_t)i * 5000000011 - 2500000000000;
+      if (int_vector_test_int64_vector_push(&vector, expected[i])) error = 1;
+   }
+
+   memmove(expected + 2, expected, sizeof(int64_t) * count);
+   memcpy(expected, ends, sizeof(ends));
+   memcpy(expected + count + 2, ends, sizeof(ends));
+   memmove(expected + 500, expected + 503, sizeof(int64_t) * (count + 1 - 500));
+
+   if (error || int_vector_test_int64_vector_insert_range(&vector, 0, ends, 2) ||
+       int_vector_test_int64_vector_append_range(&vector, ends, 2) ||
+       int_vector_test_int64_vector_erase_range(&vector, 500, 3) ||
+       int_vector_test_int64_vector_clone(&clone, &vector) ||
+       int_vector_test_int64_vector_share(&shared, &vector) || vector.size != count + 1 ||
+       memcmp(vector.data, expected, sizeof(int64_t) * vector.size) ||
+       memcmp(clone.data, expected, sizeof(int64_t) * clone.size) || clone.size != vector.size)
+   {
+      error = 1;
+   }
+
+   int64_t* data = int_vector_test_int64_vector_begin(&shared);
+
+   if (!data || data == vector.data)
+   {
+      error = 1;
+   }
+   else
+   {
+      data[0] = 0;
+
+      if (vector.data[0] != INT64_MIN || shared.data[0] || shared.size != vector.size ||
+          memcmp(shared.data + 1, expected + 1, sizeof(int64_t) * (shared.size - 1)))
+      {
+         error = 1;
+      }
+   }
+
+   if (int_vector_test_int64_vector_resize(&vector, 2) ||
+       int_vector_test_int64_vector_shrink_to_fit(&vector) ||
+       vector.data != vector.inline_data || vector.data[0] != INT64_MIN ||
+       vector.data[1] != INT64_MAX)
+   {
+      error = 1;
+   }
+
+   free(expected);
+   int_vector_test_int64_vector_clear(&vector);
+   int_vector_test_int64_vector_clear(&clone);
+   int_vector_test_int64_vector_clear(&shared);
+   return error;
+}
+
+/**************************************************************************************************
+* int_vector_test_hooks: Kontrollerar att en vektor genererad via DEFINE_VECTOR_WITH_HOOKS anropar
+*                        funktionerna fr kopiering och destruktion fr exakt de element som
+*                        kopieras in i respektive tas bort ur vektorn, men inte d elementen
+*                        flyttas vid omallokering, samt att vektorns innehll bevaras. Efter
+*                        testet ska varje kopia ha frigjorts, vilket ven kontrolleras via ASan.
+**************************************************************************************************/
+static int int_vector_test_hooks(void)
+{
+   static const int pushed[] = { 1, 2, 3, 4, 5, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+   static const int resized[] = { 100, 101, 1, 2, 3, 4, 5, 9, 10, 11 };
+   struct int_vector_test_item_vector vector, clone, shared;
+   int values[20];
+   struct int_vector_test_item items[20];
+   int error = 0;
+
+   int_vector_test_copies = 0;
+   int_vector_test_destroys = 0;
+   int_vector_test_item_vector_init(&vector);
+   int_vector_test_item_vector_init(&clone);
+   int_vector_test_item_vector_init(&shared);
+
+   for (size_t i = 0; i < 20; ++i)
+   {
+      values[i] = (int)i + 1;
+      items[i].value = values + i;
+      if (int_vector_test_item_vector_push(&vector, items[i])) error = 1;
+   }
+
+   if (error || int_vector_test_copies != 20 || int_vector_test_destroys != 0 ||
+       int_vector_test_item_vector_erase_range(&vector, 5, 3) || int_vector_test_destroys != 3 ||
+       int_vector_test_item_vector_clone(&clone, &vector) || int_vector_test_copies != 37 ||
+       !int_vector_test_item_check(&vector, pushed, 17) ||
+       !int_vector_test_item_check(&clone, pushed, 17))
+   {
+      error = 1;
+   }
+
+   if (int_vector_test_item_vector_share(&shared, &vector) || int_vector_test_copies != 37)
+   {
+      error = 1;
+   }
+
+   struct int_vector_test_item* data = int_vector_test_item_vector_begin(&shared);
+
+   if (!data || int_vector_test_copies != 54 || !data[0].value)
+   {
+      error = 1;
+   }
+   else
+   {
+      *data[0].value = 0;
+      if (!int_vector_test_item_check(&vector, pushed, 17)) error = 1;
+   }
+
+   int_vector_test_item_vector_clear(&shared);
+   values[0] = 100;
+   values[1] = 101;
+
+   if (int_vector_test_destroys != 20 || int_vector_test_item_vector_pop(&vector) ||
+       int_vector_test_destroys != 21 ||
+       int_vector_test_item_vector_insert_range(&vector, 0, items, 2) ||
+       int_vector_test_copies != 56 || int_vector_test_item_vector_resize(&vector, 30) ||
+       int_vector_test_copies != 56 || vector.data[29].value ||
+       int_vector_test_item_vector_resize(&vector, 10) || int_vector_test_destroys != 41 ||
+       !int_vector_test_item_check(&vector, resized, 10))
+   {
+      error = 1;
+   }
+
+   int_vector_test_item_vector_clear(&vector);
+   int_vector_test_item_vector_clear(&clone);
+   if (int_vector_test_copies != 56 || int_vector_test_destroys != 68) error = 1;
+   return error;
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+/**************************************************************************************************
+* pool.c: Innehller definitioner av associerade funktioner fr strukten pool, som anvnds fr
+*         snabb allokering och teranvndning av minnesblock i ett antal storleksklasser.
+**************************************************************************************************/
+#include "pool.h"
+
+/**************************************************************************************************
+* POOL_SLAB_HEADER_SIZE: Storleken p huvudet i brjan av varje slab, avrundad s att utdelade
+*                        block hamnar p en adress justerad efter den minsta blockstorleken.
+*
+* POOL_MAX_BLOCK_SIZE: Storleken i byte p minnesblocken i den strsta storleksklassen.
+**************************************************************************************************/
+#define POOL_SLAB_HEADER_SIZE POOL_MIN_BLOCK_SIZE
+#define POOL_MAX_BLOCK_SIZE ((size_t)POOL_MIN_BLOCK_SIZE << (POOL_CLASS_COUNT - 1))
+
+/* Statiska funktioner: */
+static void* pool_allocate(void* context, size_t size);
+static void* pool_reallocate(void* context, void* block, size_t old_size, size_t new_size);
+static void pool_deallocate(void* context, void* block, size_t size);
+static size_t pool_class_index(const size_t size);
+static int pool_refill(struct pool* self, const size_t class_index);
+
+/**************************************************************************************************
+* pool_init: Initierar ny tom pool. Inget minne allokeras frrn det frsta blocket begrs.
+*
+*            - self: Pekare till poolen som ska initieras.
+**************************************************************************************************/
+void pool_init(struct pool* self)
+{
+   self->allocator.allocate = pool_allocate;
+   self->allocator.reallocate = pool_reallocate;
+   self->allocator.deallocate = pool_deallocate;
+   self->allocator.context = self;
+
+   for (size_t i = 0; i < POOL_CLASS_COUNT; ++i)
+   {
+      self->free_lists[i] = 0;
+   }
+
+   self->slabs = 0;
+   return;
+}
+
+/**************************************************************************************************
+* pool_clear: Frigr samtliga slabs som har allokerats av poolen, vilket medfr att samtliga
+*             block i storleksklasserna frigrs p en gng. Block som r strre n den strsta
+*             storleksklassen mste frigras separat innan detta anrop.
+*
+*             - self: Pekare till poolen som ska tmmas.
+**************************************************************************************************/
+void pool_clear(struct pool* self)
+{
+   struct pool_slab* i = self->slabs;
+
+   while (i)
+   {
+      struct pool_slab* next = i->next;
+      free(i);
+      i = next;
+   }
+
+   for (size_t j = 0; j < POOL_CLASS_COUNT; ++j)
+   {
+      self->free_lists[j] = 0;
+   }
+
+   self->slabs = 0;
+   return;
+}
+
+/**************************************************************************************************
+* pool_allocate: Hmtar ett ledigt block frn frilistan fr den minsta storleksklass som rymmer
+*                angivet antal byte. Ifall frilistan r tom fylls den p frn en ny slab.
+*                Strre block allokeras direkt via malloc.
+*
+*                - context: Pekare till poolen.
+*                - size   : Det begrda minnesblockets storlek i byte.
+**************************************************************************************************/
+static void* pool_allocate(void* context, size_t size)
+{
+   struct pool* self = (struct pool*)context;
+   if (size > POOL_MAX_BLOCK_SIZE) return malloc(size);
+
+   const size_t class_index = pool_class_index(size);
+   if (!self->free_lists[class_index] && pool_refill(self, class_index)) return 0;
+
+   struct pool_block* block = self->free_lists[class_index];
+   self->free_lists[class_index] = block->next;
+   return block;
+}
+
+/**************************************************************************************************
+* pool_reallocate: Omallokerar ett minnesblock. Ifall den nya storleken ryms i samma
+*                  storleksklass returneras samma block, annars hmtas ett nytt block och
+*                  innehllet kopieras dit.
+*
+*                  - context : Pekare till poolen.
+*                  - block   : Pekare till minnesblocket som ska omallokeras.
+*                  - old_size: Minnesblockets nuvarande storlek i byte.
+*                  - new_size: Minnesblockets nya storlek i byte.
+**************************************************************************************************/
+static void* pool_reallocate(void* context, void* block, size_t old_size, size_t new_size)
+{
+   if (old_size > POOL_MAX_BLOCK_SIZE && new_size > POOL_MAX_BLOCK_SIZE)
+   {
+      return realloc(block, new_size);
+   }
+
+   if (old_size <= POOL_MAX_BLOCK_SIZE && new_size <= POOL_MAX_BLOCK_SIZE &&
+       pool_class_index(old_size) == pool_class_index(new_size))
+   {
+      return block;
+   }
+
+   void* copy = pool_allocate(context, new_size);
+   if (!copy) return 0;
+   memcpy(copy, block, old_size < new_size ? old_size : new_size);
+   pool_deallocate(context, block, old_size);
+   return copy;
+}
+
+/**************************************************************************************************
+* pool_deallocate: Lgger tillbaka ett minnesblock i frilistan fr dess storleksklass.
+*                  Strre block frigrs direkt via free.
+*
+*                  - context: Pekare till poolen.
+*                  - block  : Pekare till minnesblocket som ska frigras.
+*                  - size   : Minnesblockets storlek i byte.
+**************************************************************************************************/
+static void pool_deallocate(void* context, void* block, size_t size)
+{
+   struct pool* self = (struct pool*)context;
+
+   if (size > POOL_MAX_BLOCK_SIZE)
+   {
+      free(block);
+   }
+   else
+   {
+      const size_t class_index = pool_class_index(size);
+      struct pool_block* free_block = (struct pool_block*)block;
+      free_block->next = self->free_lists[class_index];
+      self->free_lists[class_index] = free_block;
+   }
+
+   return;
+}
+
+/**************************************************************************************************
+* pool_class_index: Returnerar index till den minsta storleksklass som rymmer angivet antal byte.
+*
+*                   - size: Det begrda antalet byte (hgst POOL_MAX_BLOCK_SIZE).
+**************************************************************************************************/
+static size_t pool_class_index(const size_t size)
+{
+   size_t class_index = 0;
+
+   while (((size_t)POOL_MIN_BLOCK_SIZE << class_index) < size)
+   {
+      class_index++;
+   }
+
+   return class_index;
+}
+
+/**************************************************************************************************
+* pool_refill: Allokerar en ny slab och delar upp den i block fr angiven storleksklass, vilka
+*              lggs till i klassens frilista. Vid lyckad allokering returneras 0, annars
+*              returneras felkod 1.
+*
+*              - self       : Pekare till poolen.
+*              - class_index: Index till storleksklassen som ska fyllas p.
+**************************************************************************************************/
+static int pool_refill(struct pool* self, const size_t class_index)
+{
+   const size_t block_size = (size_t)POOL_MIN_BLOCK_SIZE << class_index;
+   const size_t block_count = (POOL_SLAB_SIZE - POOL_SLAB_HEADER_SIZE) / block_size;
+   struct pool_slab* slab = (struct pool_slab*)malloc(POOL_SLAB_SIZE);
+   if (!slab) return 1;
+
+   slab->next = self->slabs;
+   self->slabs = slab;
+
+   unsigned char* data = (unsigned char*)slab + POOL_SLAB_HEADER_SIZE;
+
+   for (size_t i = block_count; i > 0; --i)
+   {
+      struct pool_block* block = (struct pool_block*)(data + (i - 1) * block_size);
+      block->next = self->free_lists[class_index];
+      self->free_lists[class_index] = block;
+   }
+
+   return 0;
+}
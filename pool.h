@@ -0,0 +1,75 @@
+/**************************************************************************************************
+* pool.h: Implementering av en pool, dvs. en allokator med separata frilistor fr ett antal
+*         storleksklasser (16, 32, 64... byte). Frigjorda minnesblock lggs tillbaka i frilistan
+*         fr sin storleksklass och teranvnds direkt vid nsta allokering av samma storlek,
+*         utan anrop av malloc eller free. Nya block hmtas frn stora minnesblock (slabs), som
+*         frigrs p en gng via funktionen pool_clear. Minnesblock som r strre n den strsta
+*         storleksklassen allokeras i stllet direkt via malloc, realloc och free.
+*
+*         Poolen r inte trdsker, anvnd drfr en pool per trd.
+**************************************************************************************************/
+#ifndef POOL_H_
+#define POOL_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <string.h>
+#include "allocator.h"
+
+/**************************************************************************************************
+* POOL_MIN_BLOCK_SIZE: Storleken i byte p minnesblocken i den minsta storleksklassen.
+*
+* POOL_CLASS_COUNT: Antalet storleksklasser, dr varje klass rymmer dubbelt s stora block
+*                   som fregende (16, 32, 64... 16 384 byte).
+*
+* POOL_SLAB_SIZE: Storleken i byte p de stora minnesblock som nya block hmtas frn.
+**************************************************************************************************/
+#define POOL_MIN_BLOCK_SIZE 16
+#define POOL_CLASS_COUNT 11
+#define POOL_SLAB_SIZE (64 * 1024)
+
+/**************************************************************************************************
+* pool_block: Ledigt minnesblock i en frilista. Pekaren till nsta lediga block lagras i sjlva
+*             blocket, vilket medfr att frilistan inte krver ngot extra minne.
+**************************************************************************************************/
+struct pool_block
+{
+   struct pool_block* next; /* Pekare till nsta lediga block i frilistan. */
+};
+
+/**************************************************************************************************
+* pool_slab: Stort minnesblock som har delats upp i mindre block fr en viss storleksklass.
+**************************************************************************************************/
+struct pool_slab
+{
+   struct pool_slab* next; /* Pekare till nsta slab i poolen. */
+};
+
+/**************************************************************************************************
+* pool: Allokator med frilistor per storleksklass. Medlemmen allocator kan passeras till
+*       exempelvis en vektor, varvid vektorns minne allokeras frn poolen.
+**************************************************************************************************/
+struct pool
+{
+   struct allocator allocator;                       /* Allokatorgrnssnitt med poolen som kontext. */
+   struct pool_block* free_lists[POOL_CLASS_COUNT];  /* Frilistor fr respektive storleksklass. */
+   struct pool_slab* slabs;                          /* Pekare till poolens frsta slab. */
+};
+
+/**************************************************************************************************
+* pool_init: Initierar ny tom pool. Inget minne allokeras frrn det frsta blocket begrs.
+*
+*            - self: Pekare till poolen som ska initieras.
+**************************************************************************************************/
+void pool_init(struct pool* self);
+
+/**************************************************************************************************
+* pool_clear: Frigr samtliga slabs som har allokerats av poolen, vilket medfr att samtliga
+*             block i storleksklasserna frigrs p en gng. Block som r strre n den strsta
+*             storleksklassen mste frigras separat innan detta anrop.
+*
+*             - self: Pekare till poolen som ska tmmas.
+**************************************************************************************************/
+void pool_clear(struct pool* self);
+
+#endif /* POOL_H_ */
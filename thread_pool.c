@@ -0,0 +1,373 @@
+/**************************************************************************************************
+* thread_pool.c: Innehller definitioner av associerade funktioner fr strukten thread_pool, som
+*                anvnds fr att kra uppgifter parallellt via teranvnda arbetstrdar.
+**************************************************************************************************/
+#include "thread_pool.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/* Statiska funktioner: */
+static size_t thread_pool_processors(void);
+static int thread_pool_pop(struct thread_pool_queue* self, size_t* task);
+static int thread_pool_steal(struct thread_pool* self, const size_t thief);
+static void thread_pool_work(struct thread_pool* self, const size_t index);
+#ifndef _WIN32
+static void* thread_pool_worker(void* arg);
+static void thread_pool_default_init(void);
+#endif
+
+/**************************************************************************************************
+* thread_pool_worker_arg: Argument till en arbetstrd, dvs. poolen samt trdens index.
+**************************************************************************************************/
+struct thread_pool_worker_arg
+{
+   struct thread_pool* pool; /* Pekare till trdpoolen. */
+   size_t index;             /* Trdens index i poolen. */
+};
+
+#ifndef _WIN32
+/* Den globala trdpoolen, se thread_pool_default. */
+static struct thread_pool thread_pool_global;
+static int thread_pool_global_failed;
+static pthread_once_t thread_pool_global_once = PTHREAD_ONCE_INIT;
+#endif
+
+/**************************************************************************************************
+* thread_pool_init: Initierar ny trdpool med angivet antal trdar, inklusive den anropande
+*                   trden, s att thread_count - 1 arbetstrdar startas. Ifall en arbetstrd
+*                   inte kan startas anvnds frre trdar. Vid lyckad initiering returneras 0,
+*                   annars returneras felkod 1.
+*
+*                   - self        : Pekare till trdpoolen som ska initieras.
+*                   - thread_count: Antalet trdar (0 = antalet processorkrnor).
+**************************************************************************************************/
+int thread_pool_init(struct thread_pool* self,
+                     const size_t thread_count)
+{
+   size_t count = thread_count ? thread_count : thread_pool_processors();
+   if (count > THREAD_POOL_MAX_THREADS) count = THREAD_POOL_MAX_THREADS;
+
+   self->thread_count = 1;
+   self->generation = 0;
+   self->active = 0;
+   self->stopping = 0;
+   self->function = 0;
+   self->context = 0;
+
+   for (size_t i = 0; i < THREAD_POOL_MAX_THREADS; ++i)
+   {
+      atomic_init(&self->queues[i].range, 0);
+   }
+
+#ifdef _WIN32
+   (void)count;
+   return 0;
+#else
+   if (pthread_mutex_init(&self->mutex, 0)) return 1;
+
+   if (pthread_mutex_init(&self->submit, 0))
+   {
+      pthread_mutex_destroy(&self->mutex);
+      return 1;
+   }
+
+   if (pthread_cond_init(&self->started, 0))
+   {
+      pthread_mutex_destroy(&self->submit);
+      pthread_mutex_destroy(&self->mutex);
+      return 1;
+   }
+
+   if (pthread_cond_init(&self->finished, 0))
+   {
+      pthread_cond_destroy(&self->started);
+      pthread_mutex_destroy(&self->submit);
+      pthread_mutex_destroy(&self->mutex);
+      return 1;
+   }
+
+   for (size_t i = 1; i < count; ++i)
+   {
+      struct thread_pool_worker_arg* arg =
+         (struct thread_pool_worker_arg*)malloc(sizeof(struct thread_pool_worker_arg));
+      if (!arg) break;
+      arg->pool = self;
+      arg->index = i;
+
+      if (pthread_create(&self->threads[i], 0, thread_pool_worker, arg))
+      {
+         free(arg);
+         break;
+      }
+
+      self->thread_count++;
+   }
+
+   return 0;
+#endif
+}
+
+/**************************************************************************************************
+* thread_pool_clear: Avslutar samtliga arbetstrdar i angiven trdpool. Fr enbart anropas d
+*                    inget jobb krs.
+*
+*                    - self: Pekare till trdpoolen som ska tmmas.
+**************************************************************************************************/
+void thread_pool_clear(struct thread_pool* self)
+{
+#ifndef _WIN32
+   pthread_mutex_lock(&self->mutex);
+   self->stopping = 1;
+   pthread_cond_broadcast(&self->started);
+   pthread_mutex_unlock(&self->mutex);
+
+   for (size_t i = 1; i < self->thread_count; ++i)
+   {
+      pthread_join(self->threads[i], 0);
+   }
+
+   pthread_cond_destroy(&self->finished);
+   pthread_cond_destroy(&self->started);
+   pthread_mutex_destroy(&self->submit);
+   pthread_mutex_destroy(&self->mutex);
+#endif
+   self->thread_count = 1;
+   return;
+}
+
+/**************************************************************************************************
+* thread_pool_default: Returnerar en pekare till en global trdpool med en trd per
+*                      processorkrna, som skapas vid frsta anropet och lever tills programmet
+*                      avslutas. Ifall poolen inte kan skapas returneras null.
+**************************************************************************************************/
+struct thread_pool* thread_pool_default(void)
+{
+#ifdef _WIN32
+   static struct thread_pool pool;
+   if (!pool.thread_count) thread_pool_init(&pool, 1);
+   return &pool;
+#else
+   pthread_once(&thread_pool_global_once, thread_pool_default_init);
+   return thread_pool_global_failed ? 0 : &thread_pool_global;
+#endif
+}
+
+/**************************************************************************************************
+* thread_pool_size: Returnerar antalet trdar i angiven trdpool, inklusive den anropande.
+*
+*                   - self: Pekare till trdpoolen.
+**************************************************************************************************/
+size_t thread_pool_size(const struct thread_pool* self)
+{
+   return self->thread_count;
+}
+
+/**************************************************************************************************
+* thread_pool_run: Kr angiven funktion en gng fr varje uppgift 0, 1... task_count - 1 via
+*                  angiven trdpool och tervnder nr samtliga uppgifter r slutfrda. Ordningen
+*                  mellan uppgifterna r ospecificerad. Vid lyckad krning returneras 0, annars
+*                  returneras felkod 1 ifall antalet uppgifter verstiger THREAD_POOL_MAX_TASKS.
+*
+*                  - self      : Pekare till trdpoolen.
+*                  - task_count: Antalet uppgifter.
+*                  - function  : Funktionen som ska kras fr varje uppgift.
+*                  - context   : Kontext som passeras till funktionen.
+**************************************************************************************************/
+int thread_pool_run(struct thread_pool* self,
+                    const size_t task_count,
+                    void (*function)(void* context, size_t task),
+                    void* context)
+{
+   if (task_count > THREAD_POOL_MAX_TASKS) return 1;
+
+   if (task_count <= 1 || self->thread_count <= 1)
+   {
+      for (size_t i = 0; i < task_count; ++i)
+      {
+         function(context, i);
+      }
+
+      return 0;
+   }
+
+#ifndef _WIN32
+   pthread_mutex_lock(&self->submit);
+   const size_t thread_count = self->thread_count;
+
+   for (size_t i = 0; i < thread_count; ++i)
+   {
+      const uint64_t first = (uint64_t)(task_count * i / thread_count);
+      const uint64_t last = (uint64_t)(task_count * (i + 1) / thread_count);
+      atomic_store_explicit(&self->queues[i].range, first << 32 | last, memory_order_relaxed);
+   }
+
+   pthread_mutex_lock(&self->mutex);
+   self->function = function;
+   self->context = context;
+   self->active = thread_count - 1;
+   self->generation++;
+   pthread_cond_broadcast(&self->started);
+   pthread_mutex_unlock(&self->mutex);
+
+   thread_pool_work(self, 0);
+
+   pthread_mutex_lock(&self->mutex);
+
+   while (self->active)
+   {
+      pthread_cond_wait(&self->finished, &self->mutex);
+   }
+
+   pthread_mutex_unlock(&self->mutex);
+   pthread_mutex_unlock(&self->submit);
+#endif
+   return 0;
+}
+
+/**************************************************************************************************
+* thread_pool_processors: Returnerar antalet tillgngliga processorkrnor, dock minst 1.
+**************************************************************************************************/
+static size_t thread_pool_processors(void)
+{
+#ifdef _WIN32
+   return 1;
+#else
+   const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+   return processors > 0 ? (size_t)processors : 1;
+#endif
+}
+
+/**************************************************************************************************
+* thread_pool_pop: Tar nsta uppgift framifrn i angivet intervall. Ifall intervallet r tomt
+*                  returneras 0, annars returneras 1 och uppgiften tilldelas angiven variabel.
+*
+*                  - self: Pekare till intervallet.
+*                  - task: Pekare till variabeln som ska tilldelas uppgiften.
+**************************************************************************************************/
+static int thread_pool_pop(struct thread_pool_queue* self, size_t* task)
+{
+   uint64_t range = atomic_load_explicit(&self->range, memory_order_relaxed);
+
+   for (;;)
+   {
+      const uint64_t first = range >> 32;
+      const uint64_t last = range & UINT32_MAX;
+      if (first >= last) return 0;
+
+      if (atomic_compare_exchange_weak_explicit(&self->range, &range, (first + 1) << 32 | last,
+                                                memory_order_relaxed, memory_order_relaxed))
+      {
+         *task = (size_t)first;
+         return 1;
+      }
+   }
+}
+
+/**************************************************************************************************
+* thread_pool_steal: Stjl den bakre halvan av det frsta icke-tomma intervallet hos vriga
+*                    trdar och gr den till angiven trds intervall. Ifall samtliga intervall
+*                    r tomma returneras 0, annars returneras 1. Trdens eget intervall r tomt
+*                    och ndras inte av andra trdar, varfr det kan skrivas direkt.
+*
+*                    - self : Pekare till trdpoolen.
+*                    - thief: Index till trden som stjl.
+**************************************************************************************************/
+static int thread_pool_steal(struct thread_pool* self, const size_t thief)
+{
+   for (size_t i = 1; i < self->thread_count; ++i)
+   {
+      struct thread_pool_queue* victim = &self->queues[(thief + i) % self->thread_count];
+      uint64_t range = atomic_load_explicit(&victim->range, memory_order_relaxed);
+
+      for (;;)
+      {
+         const uint64_t first = range >> 32;
+         const uint64_t last = range & UINT32_MAX;
+         if (first >= last) break;
+         const uint64_t middle = first + (last - first) / 2;
+
+         if (atomic_compare_exchange_weak_explicit(&victim->range, &range, first << 32 | middle,
+                                                   memory_order_relaxed, memory_order_relaxed))
+         {
+            atomic_store_explicit(&self->queues[thief].range, middle << 32 | last,
+                                  memory_order_relaxed);
+            return 1;
+         }
+      }
+   }
+
+   return 0;
+}
+
+/**************************************************************************************************
+* thread_pool_work: Kr uppgifter frn angiven trds intervall, och drefter stulna uppgifter,
+*                   tills samtliga intervall r tomma.
+*
+*                   - self : Pekare till trdpoolen.
+*                   - index: Trdens index i poolen.
+**************************************************************************************************/
+static void thread_pool_work(struct thread_pool* self, const size_t index)
+{
+   size_t task;
+
+   do
+   {
+      while (thread_pool_pop(&self->queues[index], &task))
+      {
+         self->function(self->context, task);
+      }
+   } while (thread_pool_steal(self, index));
+
+   return;
+}
+
+#ifndef _WIN32
+
+/**************************************************************************************************
+* thread_pool_worker: Arbetstrdens huvudloop, som vntar p nsta jobb, deltar i arbetet och
+*                     meddelar den anropande trden nr den r klar, tills poolen tms.
+*
+*                     - arg: Pekare till trdens argument (struct thread_pool_worker_arg).
+**************************************************************************************************/
+static void* thread_pool_worker(void* arg)
+{
+   struct thread_pool* self = ((struct thread_pool_worker_arg*)arg)->pool;
+   const size_t index = ((struct thread_pool_worker_arg*)arg)->index;
+   size_t generation = 0;
+   free(arg);
+
+   pthread_mutex_lock(&self->mutex);
+
+   for (;;)
+   {
+      while (!self->stopping && self->generation == generation)
+      {
+         pthread_cond_wait(&self->started, &self->mutex);
+      }
+
+      if (self->stopping) break;
+      generation = self->generation;
+      pthread_mutex_unlock(&self->mutex);
+
+      thread_pool_work(self, index);
+
+      pthread_mutex_lock(&self->mutex);
+      if (!--self->active) pthread_cond_signal(&self->finished);
+   }
+
+   pthread_mutex_unlock(&self->mutex);
+   return 0;
+}
+
+/**************************************************************************************************
+* thread_pool_default_init: Initierar den globala trdpoolen, se thread_pool_default.
+**************************************************************************************************/
+static void thread_pool_default_init(void)
+{
+   thread_pool_global_failed = thread_pool_init(&thread_pool_global, 0);
+   return;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,127 @@
+/**************************************************************************************************
+* thread_pool.h: Implementering av en trdpool med ett fast antal arbetstrdar, som skapas en gng
+*                och teranvnds fr varje jobb. Ett jobb bestr av ett antal uppgifter (index
+*                0, 1, 2...), vilka frdelas jmnt ver trdarna i sammanhngande intervall. En
+*                trd som har slutfrt sitt intervall stjl halva det terstende intervallet frn
+*                en annan trd (work stealing), s att ojmnt frdelat arbete nd balanseras.
+*                Den anropande trden deltar i arbetet, och funktionen thread_pool_run tervnder
+*                frst nr samtliga uppgifter r slutfrda.
+*
+*                Varje intervall lagras som ett 64-bitarsord (frsta och sista uppgiften) p en
+*                egen cache-rad och uppdateras via atomra compare-and-swap, vilket gr att
+*                trdarna varken behver ls eller delar cache-rader under arbetet.
+*
+*                Endast ett jobb i taget krs per pool. Anrop frn flera trdar samtidigt kas,
+*                men en uppgift fr inte sjlv starta ett nytt jobb i samma pool. P system som
+*                saknar pthreads krs samtliga uppgifter av den anropande trden.
+**************************************************************************************************/
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+/**************************************************************************************************
+* THREAD_POOL_CACHE_LINE_SIZE: Storleken p en cache-rad i byte, som anvnds fr att separera
+*                              trdarnas intervall.
+*
+* THREAD_POOL_MAX_THREADS: Maximalt antal trdar per pool, inklusive den anropande trden.
+*
+* THREAD_POOL_MAX_TASKS: Maximalt antal uppgifter per jobb, eftersom intervallets grnser lagras
+*                        med 32 bitar vardera.
+**************************************************************************************************/
+#define THREAD_POOL_CACHE_LINE_SIZE 64
+#define THREAD_POOL_MAX_THREADS 64
+#define THREAD_POOL_MAX_TASKS UINT32_MAX
+
+/**************************************************************************************************
+* thread_pool_queue: Intervall med uppgifter som gs av en trd. De vre 32 bitarna anger nsta
+*                    uppgift och de nedre 32 bitarna anger uppgiften direkt efter den sista.
+*                    garen tar uppgifter framifrn, medan andra trdar stjl bakifrn.
+**************************************************************************************************/
+struct thread_pool_queue
+{
+   _Alignas(THREAD_POOL_CACHE_LINE_SIZE) _Atomic uint64_t range; /* Trdens intervall. */
+};
+
+/**************************************************************************************************
+* thread_pool: Trdpool med arbetstrdar som vntar p nsta jobb via en villkorsvariabel.
+*              Medlemmen generation rknas upp fr varje nytt jobb, s att trdarna vet att de
+*              ska brja arbeta, och medlemmen active rknar trdarna som nnu inte r klara.
+**************************************************************************************************/
+struct thread_pool
+{
+#ifndef _WIN32
+   pthread_t threads[THREAD_POOL_MAX_THREADS]; /* Arbetstrdarna (index 0 anvnds inte). */
+   pthread_mutex_t mutex;                      /* Skyddar jobbets parametrar samt rknarna. */
+   pthread_cond_t started;                     /* Signaleras nr ett nytt jobb startas. */
+   pthread_cond_t finished;                    /* Signaleras nr den sista trden r klar. */
+   pthread_mutex_t submit;                     /* Skerstller att ett jobb i taget krs. */
+#endif
+   size_t thread_count;                        /* Antalet trdar inklusive den anropande. */
+   size_t generation;                          /* Det aktuella jobbets nummer. */
+   size_t active;                              /* Antalet arbetstrdar som nnu arbetar. */
+   int stopping;                               /* Indikerar ifall trdarna ska avslutas. */
+   void (*function)(void* context, size_t task); /* Funktionen som krs fr varje uppgift. */
+   void* context;                              /* Kontext som passeras till funktionen. */
+   struct thread_pool_queue queues[THREAD_POOL_MAX_THREADS]; /* Intervall per trd. */
+};
+
+/**************************************************************************************************
+* thread_pool_init: Initierar ny trdpool med angivet antal trdar, inklusive den anropande
+*                   trden, s att thread_count - 1 arbetstrdar startas. Ifall en arbetstrd
+*                   inte kan startas anvnds frre trdar. Vid lyckad initiering returneras 0,
+*                   annars returneras felkod 1.
+*
+*                   - self        : Pekare till trdpoolen som ska initieras.
+*                   - thread_count: Antalet trdar (0 = antalet processorkrnor).
+**************************************************************************************************/
+int thread_pool_init(struct thread_pool* self,
+                     const size_t thread_count);
+
+/**************************************************************************************************
+* thread_pool_clear: Avslutar samtliga arbetstrdar i angiven trdpool. Fr enbart anropas d
+*                    inget jobb krs.
+*
+*                    - self: Pekare till trdpoolen som ska tmmas.
+**************************************************************************************************/
+void thread_pool_clear(struct thread_pool* self);
+
+/**************************************************************************************************
+* thread_pool_default: Returnerar en pekare till en global trdpool med en trd per
+*                      processorkrna, som skapas vid frsta anropet och lever tills programmet
+*                      avslutas. Ifall poolen inte kan skapas returneras null.
+**************************************************************************************************/
+struct thread_pool* thread_pool_default(void);
+
+/**************************************************************************************************
+* thread_pool_size: Returnerar antalet trdar i angiven trdpool, inklusive den anropande.
+*
+*                   - self: Pekare till trdpoolen.
+**************************************************************************************************/
+size_t thread_pool_size(const struct thread_pool* self);
+
+/**************************************************************************************************
+* thread_pool_run: Kr angiven funktion en gng fr varje uppgift 0, 1... task_count - 1 via
+*                  angiven trdpool och tervnder nr samtliga uppgifter r slutfrda. Ordningen
+*                  mellan uppgifterna r ospecificerad. Vid lyckad krning returneras 0, annars
+*                  returneras felkod 1 ifall antalet uppgifter verstiger THREAD_POOL_MAX_TASKS.
+*
+*                  - self      : Pekare till trdpoolen.
+*                  - task_count: Antalet uppgifter.
+*                  - function  : Funktionen som ska kras fr varje uppgift.
+*                  - context   : Kontext som passeras till funktionen.
+**************************************************************************************************/
+int thread_pool_run(struct thread_pool* self,
+                    const size_t task_count,
+                    void (*function)(void* context, size_t task),
+                    void* context);
+
+#endif /* THREAD_POOL_H_ */
@@ -0,0 +1,536 @@
+/**************************************************************************************************
+* vector.c: Innehller definitioner av hjlpfunktioner som anvnds av samtliga vektorer som
+*           genereras via mallen i "vector.h".
+**************************************************************************************************/
+#include "vector.h"
+#include "crc32c.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+/* Statiska funktioner: */
+static uint32_t vector_checksum_combine(uint32_t crc,
+                                        const uint32_t* checksums,
+                                        const size_t count);
+
+/**************************************************************************************************
+* vector_unmap: Avmappar ett flt som har mappats frn en fil, se int_vector_map. Fltets
+*               adress och storlek anges exklusive filhuvudet om VECTOR_MAP_OFFSET byte.
+*
+*               - data: Pekare till fltets frsta element.
+*               - size: Fltets storlek i byte.
+**************************************************************************************************/
+void vector_unmap(void* data,
+                  const size_t size)
+{
+#ifdef _WIN32
+   (void)data;
+   (void)size;
+#else
+   munmap((unsigned char*)data - VECTOR_MAP_OFFSET, VECTOR_MAP_OFFSET + size);
+#endif
+   return;
+}
+
+/**************************************************************************************************
+* vector_share_new: Returnerar en pekare till en ny delningsstrukt fr angivet flt med en
+*                   referens. Strukten allokeras via angiven allokator. Vid misslyckad
+*                   allokering returneras null.
+*
+*                   - data     : Pekare till fltet som ska delas.
+*                   - bytes    : Fltets storlek i byte.
+*                   - allocator: Allokatorn som fltet har allokerats via (null = malloc).
+*                   - mapped   : Indikerar ifall fltet utgrs av en minnesmappad fil.
+**************************************************************************************************/
+struct vector_share* vector_share_new(void* data,
+                                      const size_t bytes,
+                                      const struct allocator* allocator,
+                                      const int mapped)
+{
+   struct vector_share* self =
+      (struct vector_share*)allocator_allocate(allocator, sizeof(struct vector_share));
+   if (!self) return 0;
+   atomic_init(&self->references, 1);
+   self->data = data;
+   self->bytes = bytes;
+   self->allocator = allocator;
+   self->mapped = mapped;
+   return self;
+}
+
+/**************************************************************************************************
+* vector_share_acquire: Lgger till en referens till angiven delningsstrukt.
+*
+*                       - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+void vector_share_acquire(struct vector_share* self)
+{
+   atomic_fetch_add_explicit(&self->references, 1, memory_order_relaxed);
+   return;
+}
+
+/**************************************************************************************************
+* vector_share_release: Slpper en referens till angiven delningsstrukt. Ifall det var den
+*                       sista referensen returneras 1, varvid anroparen ansvarar fr att frigra
+*                       elementen samt anropa vector_share_delete, annars returneras 0.
+*
+*                       - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+int vector_share_release(struct vector_share* self)
+{
+   return atomic_fetch_sub_explicit(&self->references, 1, memory_order_acq_rel) == 1;
+}
+
+/**************************************************************************************************
+* vector_share_unique: Indikerar ifall angiven delningsstrukt enbart har en referens, dvs. ifall
+*                      den anropande vektorn r ensam om fltet.
+*
+*                      - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+int vector_share_unique(const struct vector_share* self)
+{
+   return atomic_load_explicit(&self->references, memory_order_acquire) == 1;
+}
+
+/**************************************************************************************************
+* vector_share_delete: Frigr angiven delningsstrukt samt fltet den ger.
+*
+*                      - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+void vector_share_delete(struct vector_share* self)
+{
+   if (self->mapped)
+   {
+      vector_unmap(self->data, self->bytes);
+   }
+   else
+   {
+      allocator_deallocate(self->allocator, self->data, self->bytes);
+   }
+
+   vector_share_detach(self);
+   return;
+}
+
+/**************************************************************************************************
+* vector_share_detach: Frigr angiven delningsstrukt utan att frigra fltet, vars garskap
+*                      drmed vergr till den sista vektorn som refererar till det.
+*
+*                      - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+void vector_share_detach(struct vector_share* self)
+{
+   allocator_deallocate(self->allocator, self, sizeof(struct vector_share));
+   return;
+}
+
+/**************************************************************************************************
+* vector_track_new: Returnerar en pekare till en ny sprningsstrukt, dr angivet antal byte
+*                   anses vara ndrade och samtliga kontrollsummor saknas. Strukten allokeras
+*                   via angiven allokator. Vid misslyckad allokering returneras null.
+*
+*                   - allocator: Allokatorn som strukten ska allokeras via (null = malloc).
+*                   - bytes    : Fltets nuvarande storlek i byte.
+**************************************************************************************************/
+struct vector_track* vector_track_new(const struct allocator* allocator,
+                                      const size_t bytes)
+{
+   struct vector_track* self =
+      (struct vector_track*)allocator_allocate(allocator, sizeof(struct vector_track));
+   if (!self) return 0;
+   self->dirty_first = 0;
+   self->dirty_last = bytes;
+   self->stale_first = 0;
+   self->stale_last = SIZE_MAX;
+   self->checksums = 0;
+   self->block_count = 0;
+   self->block_capacity = 0;
+   self->allocator = allocator;
+   return self;
+}
+
+/**************************************************************************************************
+* vector_track_delete: Frigr angiven sprningsstrukt.
+*
+*                      - self: Pekare till sprningsstrukten.
+**************************************************************************************************/
+void vector_track_delete(struct vector_track* self)
+{
+   allocator_deallocate(self->allocator, self->checksums, sizeof(uint32_t) * self->block_capacity);
+   allocator_deallocate(self->allocator, self, sizeof(struct vector_track));
+   return;
+}
+
+/**************************************************************************************************
+* vector_track_mark: Markerar angivet intervall av byte som ndrat.
+*
+*                    - self : Pekare till sprningsstrukten.
+*                    - first: Den frsta ndrade byten.
+*                    - last : Byten direkt efter den sista ndrade.
+**************************************************************************************************/
+void vector_track_mark(struct vector_track* self,
+                       const size_t first,
+                       const size_t last)
+{
+   if (first >= last) return;
+
+   if (self->dirty_first >= self->dirty_last)
+   {
+      self->dirty_first = first;
+      self->dirty_last = last;
+   }
+   else
+   {
+      if (first < self->dirty_first) self->dirty_first = first;
+      if (last > self->dirty_last) self->dirty_last = last;
+   }
+
+   if (self->stale_first >= self->stale_last)
+   {
+      self->stale_first = first;
+      self->stale_last = last;
+   }
+   else
+   {
+      if (first < self->stale_first) self->stale_first = first;
+      if (last > self->stale_last) self->stale_last = last;
+   }
+   return;
+}
+
+/**************************************************************************************************
+* vector_track_clean: Markerar samtliga byte som ofrndrade, se name_mark_clean.
+*
+*                     - self: Pekare till sprningsstrukten.
+**************************************************************************************************/
+void vector_track_clean(struct vector_track* self)
+{
+   self->dirty_first = 0;
+   self->dirty_last = 0;
+   return;
+}
+
+/**************************************************************************************************
+* vector_track_dirty: Tilldelar angivna variabler intervallet av element som har ndrats sedan
+*                     name_mark_clean, begrnsat till angiven storlek, se name_dirty_range.
+*                     Ifall ngot har ndrats returneras 1, annars returneras 0.
+*
+*                     - self        : Pekare till sprningsstrukten.
+*                     - element_size: Storleken p varje element i byte.
+*                     - size        : Vektorns storlek.
+*                     - first       : Pekare till variabeln som ska tilldelas det frsta elementet.
+*                     - last        : Pekare till variabeln som ska tilldelas elementet direkt
+*                                     efter det sista.
+**************************************************************************************************/
+int vector_track_dirty(const struct vector_track* self,
+                       const size_t element_size,
+                       const size_t size,
+                       size_t* first,
+                       size_t* last)
+{
+   if (self->dirty_first >= self->dirty_last)
+   {
+      *first = size;
+      *last = size;
+      return 0;
+   }
+
+   *first = self->dirty_first / element_size;
+   *last = self->dirty_last / element_size + (self->dirty_last % element_size != 0);
+   if (*last > size) *last = size;
+   if (*first > *last) *first = *last;
+   return 1;
+}
+
+/**************************************************************************************************
+* vector_track_checksum: Returnerar kontrollsumman fr angivet flt, dr enbart block som har
+*                        ndrats sedan fregende anrop berknas om, se name_checksum. Ifall
+*                        kontrollsummorna inte fr plats och minne inte kan allokeras berknas
+*                        samtliga block utan att de sparas.
+*
+*                        - self : Pekare till sprningsstrukten.
+*                        - data : Pekare till fltet.
+*                        - bytes: Fltets storlek i byte.
+**************************************************************************************************/
+uint32_t vector_track_checksum(struct vector_track* self,
+                               const void* data,
+                               const size_t bytes)
+{
+   const size_t count = bytes / VECTOR_TRACK_BLOCK_SIZE + (bytes % VECTOR_TRACK_BLOCK_SIZE != 0);
+   size_t first = count;
+   size_t last = 0;
+
+   if (count > self->block_capacity)
+   {
+      size_t new_capacity = self->block_capacity * 2;
+      if (new_capacity < count) new_capacity = count;
+      if (new_capacity > SIZE_MAX / sizeof(uint32_t)) return vector_checksum(data, bytes);
+      uint32_t* checksums =
+         (uint32_t*)allocator_reallocate(self->allocator, self->checksums,
+                                         sizeof(uint32_t) * self->block_capacity,
+                                         sizeof(uint32_t) * new_capacity);
+      if (!checksums) return vector_checksum(data, bytes);
+      self->checksums = checksums;
+      self->block_capacity = new_capacity;
+   }
+
+   if (self->stale_first < self->stale_last)
+   {
+      first = self->stale_first / VECTOR_TRACK_BLOCK_SIZE;
+      last = self->stale_last / VECTOR_TRACK_BLOCK_SIZE +
+             (self->stale_last % VECTOR_TRACK_BLOCK_SIZE != 0);
+   }
+
+   if (count > self->block_count)
+   {
+      if (first > self->block_count) first = self->block_count;
+      last = count;
+   }
+
+   if (last > count) last = count;
+
+   for (size_t i = first; i < last; ++i)
+   {
+      const size_t offset = i * VECTOR_TRACK_BLOCK_SIZE;
+      const size_t size =
+         bytes - offset < VECTOR_TRACK_BLOCK_SIZE ? bytes - offset : VECTOR_TRACK_BLOCK_SIZE;
+      self->checksums[i] = crc32c(0, (const unsigned char*)data + offset, size);
+   }
+
+   self->block_count = count;
+   self->stale_first = 0;
+   self->stale_last = 0;
+   return vector_checksum_combine(0, self->checksums, count);
+}
+
+/**************************************************************************************************
+* vector_checksum: Returnerar kontrollsumman fr angivet flt genom att samtliga block berknas,
+*                  se name_checksum.
+*
+*                  - data : Pekare till fltet.
+*                  - bytes: Fltets storlek i byte.
+**************************************************************************************************/
+uint32_t vector_checksum(const void* data,
+                         const size_t bytes)
+{
+   uint32_t checksums[64];
+   uint32_t crc = 0;
+   size_t count = 0;
+
+   for (size_t offset = 0; offset < bytes; offset += VECTOR_TRACK_BLOCK_SIZE)
+   {
+      const size_t size =
+         bytes - offset < VECTOR_TRACK_BLOCK_SIZE ? bytes - offset : VECTOR_TRACK_BLOCK_SIZE;
+      checksums[count++] = crc32c(0, (const unsigned char*)data + offset, size);
+
+      if (count == sizeof(checksums) / sizeof(*checksums))
+      {
+         crc = vector_checksum_combine(crc, checksums, count);
+         count = 0;
+      }
+   }
+
+   return vector_checksum_combine(crc, checksums, count);
+}
+
+/**************************************************************************************************
+* vector_checksum_combine: Returnerar kontrollsumman CRC-32C fr angivna kontrollsummor, dr
+*                          varje kontrollsumma behandlas som fyra byte i little endian, s att
+*                          resultatet blir detsamma oavsett processorns byteordning.
+*
+*                          - crc      : Kontrollsumman fr fregende kontrollsummor (0 vid start).
+*                          - checksums: Pekare till kontrollsummorna.
+*                          - count    : Antalet kontrollsummor.
+**************************************************************************************************/
+static uint32_t vector_checksum_combine(uint32_t crc,
+                                        const uint32_t* checksums,
+                                        const size_t count)
+{
+   unsigned char buffer[256];
+   size_t size = 0;
+
+   for (size_t i = 0; i < count; ++i)
+   {
+      buffer[size++] = (unsigned char)checksums[i];
+      buffer[size++] = (unsigned char)(checksums[i] >> 8);
+      buffer[size++] = (unsigned char)(checksums[i] >> 16);
+      buffer[size++] = (unsigned char)(checksums[i] >> 24);
+
+      if (size == sizeof(buffer))
+      {
+         crc = crc32c(crc, buffer, size);
+         size = 0;
+      }
+   }
+
+   return crc32c(crc, buffer, size);
+}
+
+#ifdef VECTOR_STATS
+
+/* Global statistik fr samtliga vektorer. */
+struct vector_stats vector_stats_global;
+
+/* Statiska funktioner: */
+static void vector_stats_update_bytes(struct vector_stats* self,
+                                      const size_t old_bytes,
+                                      const size_t new_bytes);
+
+/**************************************************************************************************
+* vector_stats_reset: Nollstller angiven statistik.
+*
+*                     - self: Pekare till statistiken som ska nollstllas (null = global).
+**************************************************************************************************/
+void vector_stats_reset(struct vector_stats* self)
+{
+   if (!self) self = &vector_stats_global;
+   memset(self, 0, sizeof(*self));
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_dump: Skriver ut angiven statistik via angiven utstrm, en rknare per rad.
+*
+*                    - self   : Pekare till statistiken som ska skrivas ut (null = global).
+*                    - ostream: Pekare till angiven utstrm (default = stdout).
+**************************************************************************************************/
+void vector_stats_dump(const struct vector_stats* self,
+                       FILE* ostream)
+{
+   if (!self) self = &vector_stats_global;
+   if (!ostream) ostream = stdout;
+   fprintf(ostream, "allocations:        %zu\n", self->allocations);
+   fprintf(ostream, "reallocations:      %zu\n", self->reallocations);
+   fprintf(ostream, "deallocations:      %zu\n", self->deallocations);
+   fprintf(ostream, "moves:              %zu\n", self->moves);
+   fprintf(ostream, "bytes_copied:       %zu\n", self->bytes_copied);
+   fprintf(ostream, "live_bytes:         %zu\n", self->live_bytes);
+   fprintf(ostream, "peak_bytes:         %zu\n", self->peak_bytes);
+   fprintf(ostream, "peak_capacity:      %zu\n", self->peak_capacity);
+   fprintf(ostream, "failed_allocations: %zu\n", self->failed_allocations);
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_allocate: Registrerar ett nytt minnesblock om angivet antal byte.
+*
+*                        - self : Pekare till vektorns statistik.
+*                        - bytes: Minnesblockets storlek i byte.
+**************************************************************************************************/
+void vector_stats_allocate(struct vector_stats* self,
+                           const size_t bytes)
+{
+   self->allocations++;
+   vector_stats_global.allocations++;
+   vector_stats_update_bytes(self, 0, bytes);
+   vector_stats_update_bytes(&vector_stats_global, 0, bytes);
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_reallocate: Registrerar en omallokering av fltet.
+*
+*                          - self      : Pekare till vektorns statistik.
+*                          - moved     : Indikerar ifall fltet flyttades till en ny adress.
+*                          - old_bytes : Fltets tidigare storlek i byte.
+*                          - new_bytes : Fltets nya storlek i byte.
+*                          - used_bytes: Antalet byte som anvndes av elementen, vilka kopierades
+*                                        om fltet flyttades.
+**************************************************************************************************/
+void vector_stats_reallocate(struct vector_stats* self,
+                             const int moved,
+                             const size_t old_bytes,
+                             const size_t new_bytes,
+                             const size_t used_bytes)
+{
+   self->reallocations++;
+   vector_stats_global.reallocations++;
+
+   if (moved)
+   {
+      self->moves++;
+      vector_stats_global.moves++;
+      vector_stats_copy(self, used_bytes);
+   }
+
+   vector_stats_update_bytes(self, old_bytes, new_bytes);
+   vector_stats_update_bytes(&vector_stats_global, old_bytes, new_bytes);
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_deallocate: Registrerar att ett minnesblock om angivet antal byte har frigjorts.
+*
+*                          - self : Pekare till vektorns statistik.
+*                          - bytes: Minnesblockets storlek i byte.
+**************************************************************************************************/
+void vector_stats_deallocate(struct vector_stats* self,
+                             const size_t bytes)
+{
+   self->deallocations++;
+   vector_stats_global.deallocations++;
+   vector_stats_update_bytes(self, bytes, 0);
+   vector_stats_update_bytes(&vector_stats_global, bytes, 0);
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_copy: Registrerar att angivet antal byte har kopierats vid flytt av fltet.
+*
+*                    - self : Pekare till vektorns statistik.
+*                    - bytes: Antalet kopierade byte.
+**************************************************************************************************/
+void vector_stats_copy(struct vector_stats* self,
+                       const size_t bytes)
+{
+   self->bytes_copied += bytes;
+   vector_stats_global.bytes_copied += bytes;
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_capacity: Registrerar fltets nya kapacitet.
+*
+*                        - self    : Pekare till vektorns statistik.
+*                        - capacity: Fltets nya kapacitet i antal element.
+**************************************************************************************************/
+void vector_stats_capacity(struct vector_stats* self,
+                           const size_t capacity)
+{
+   if (capacity > self->peak_capacity) self->peak_capacity = capacity;
+   if (capacity > vector_stats_global.peak_capacity) vector_stats_global.peak_capacity = capacity;
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_fail: Registrerar en misslyckad allokering eller omallokering.
+*
+*                    - self: Pekare till vektorns statistik.
+**************************************************************************************************/
+void vector_stats_fail(struct vector_stats* self)
+{
+   self->failed_allocations++;
+   vector_stats_global.failed_allocations++;
+   return;
+}
+
+/**************************************************************************************************
+* vector_stats_update_bytes: Uppdaterar antalet allokerade byte d ett minnesblock ndrar storlek
+*                            frn old_bytes till new_bytes, dr 0 innebr att blocket allokeras
+*                            respektive frigrs, samt det hgsta antalet allokerade byte.
+*
+*                            - self     : Pekare till statistiken som ska uppdateras.
+*                            - old_bytes: Minnesblockets tidigare storlek i byte.
+*                            - new_bytes: Minnesblockets nya storlek i byte.
+**************************************************************************************************/
+static void vector_stats_update_bytes(struct vector_stats* self,
+                                      const size_t old_bytes,
+                                      const size_t new_bytes)
+{
+   self->live_bytes = self->live_bytes - old_bytes + new_bytes;
+   if (self->live_bytes > self->peak_bytes) self->peak_bytes = self->live_bytes;
+   return;
+}
+
+#endif /* VECTOR_STATS */
@@ -0,0 +1,1038 @@
+/**************************************************************************************************
+* vector.h: Mall fr dynamiska vektorer av godtycklig datatyp, implementerad via makron. Makrot
+*           DECLARE_VECTOR deklarerar vektorstrukten samt dess associerade funktioner och
+*           placeras i en headerfil, medan makrot DEFINE_VECTOR genererar funktionernas
+*           definitioner och placeras i en kllkodsfil. Exempelvis genererar
+*
+*           DECLARE_VECTOR(float_vector, float)
+*           DEFINE_VECTOR(float_vector, float)
+*
+*           strukten float_vector samt funktionerna float_vector_init, float_vector_push osv.
+*           Vektorn int_vector i "int_vector.h" r genererad p samma stt, kompletterad med
+*           funktioner som enbart r meningsfulla fr heltal.
+*
+*           Element kopieras som standard via memcpy och memmove, vilket fungerar fr samtliga
+*           datatyper som kan kopieras byte fr byte (heltal, flyttal, pekare samt strukter
+*           innehllande sdana). Fr strukter som ger resurser, exempelvis en pekare till
+*           heapallokerat minne, kan egna funktioner fr kopiering och destruktion av element
+*           anges via makrot DEFINE_VECTOR_WITH_HOOKS.
+**************************************************************************************************/
+#ifndef VECTOR_H_
+#define VECTOR_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "allocator.h"
+
+/**************************************************************************************************
+* VECTOR_INLINE_BYTES: Antalet byte som lagras direkt i vektorstrukten innan ett flt allokeras
+*                      p heapen, vid anvndning av makrot DECLARE_VECTOR.
+*
+* VECTOR_MAP_OFFSET: Antalet byte mellan brjan p en minnesmappad fil och vektorns frsta
+*                    element, dvs. storleken p filhuvudet, se int_vector_map.
+**************************************************************************************************/
+#ifndef VECTOR_INLINE_BYTES
+#define VECTOR_INLINE_BYTES 48
+#endif
+
+#define VECTOR_MAP_OFFSET 32
+
+/**************************************************************************************************
+* VECTOR_INLINE_CAPACITY: Returnerar antalet element av angiven datatyp som ryms i
+*                         VECTOR_INLINE_BYTES byte, dock minst ett element.
+*
+* VECTOR_INLINE_COUNT: Returnerar antalet element som ryms i angiven vektors inbyggda flt.
+**************************************************************************************************/
+#define VECTOR_INLINE_CAPACITY(type) \
+   (sizeof(type) < VECTOR_INLINE_BYTES ? VECTOR_INLINE_BYTES / sizeof(type) : 1)
+#define VECTOR_INLINE_COUNT(self) (sizeof((self)->inline_data) / sizeof((self)->inline_data[0]))
+
+/**************************************************************************************************
+* VECTOR_COPY_TRIVIAL: Standardfunktion fr kopiering av element, som kopierar n element frn
+*                      src till dest byte fr byte.
+*
+* VECTOR_DESTROY_TRIVIAL: Standardfunktion fr destruktion av element, som inte gr ngonting.
+**************************************************************************************************/
+#define VECTOR_COPY_TRIVIAL(dest, src, n) memcpy((dest), (src), sizeof(*(dest)) * (n))
+#define VECTOR_DESTROY_TRIVIAL(data, n) ((void)(data), (void)(n))
+
+/**************************************************************************************************
+* vector_stats: Allokeringsstatistik, som frs per vektor samt globalt fr samtliga vektorer om
+*               VECTOR_STATS r definierat vid kompilering. Annars finns varken strukten eller
+*               medlemmen stats i vektorerna och inga rknare uppdateras, s att statistiken inte
+*               medfr ngon kostnad. VECTOR_STATS mste vara definierat p samma stt fr
+*               samtliga kllkodsfiler, eftersom vektorstruktens storlek pverkas. De globala
+*               rknarna uppdateras utan synkronisering och r drmed enbart tillfrlitliga d
+*               vektorerna anvnds frn en trd i taget.
+**************************************************************************************************/
+#ifdef VECTOR_STATS
+struct vector_stats
+{
+   size_t allocations;        /* Antalet nya minnesblock (inklusive vektorstrukter via new). */
+   size_t reallocations;      /* Antalet omallokeringar av fltet. */
+   size_t deallocations;      /* Antalet frigjorda minnesblock. */
+   size_t moves;              /* Antalet gnger fltet har flyttats till en ny adress. */
+   size_t bytes_copied;       /* Antalet byte som har kopierats vid flytt av fltet. */
+   size_t live_bytes;         /* Antalet allokerade byte som inte har frigjorts. */
+   size_t peak_bytes;         /* Det hgsta antalet allokerade byte samtidigt. */
+   size_t peak_capacity;      /* Den hgsta kapaciteten i antal element. */
+   size_t failed_allocations; /* Antalet misslyckade allokeringar och omallokeringar. */
+};
+
+/* Global statistik fr samtliga vektorer. */
+extern struct vector_stats vector_stats_global;
+
+/**************************************************************************************************
+* vector_stats_reset: Nollstller angiven statistik.
+*
+*                     - self: Pekare till statistiken som ska nollstllas (null = global).
+**************************************************************************************************/
+void vector_stats_reset(struct vector_stats* self);
+
+/**************************************************************************************************
+* vector_stats_dump: Skriver ut angiven statistik via angiven utstrm, en rknare per rad.
+*
+*                    - self   : Pekare till statistiken som ska skrivas ut (null = global).
+*                    - ostream: Pekare till angiven utstrm (default = stdout).
+**************************************************************************************************/
+void vector_stats_dump(const struct vector_stats* self,
+                       FILE* ostream);
+
+/**************************************************************************************************
+* vector_stats_allocate, vector_stats_reallocate, vector_stats_deallocate, vector_stats_copy,
+* vector_stats_capacity, vector_stats_fail: Uppdaterar angiven statistik samt den globala
+*                                           statistiken vid allokering, omallokering, frigrande,
+*                                           kopiering, ny kapacitet respektive misslyckad
+*                                           allokering. Anropas av vektorernas funktioner via
+*                                           makrona nedan.
+**************************************************************************************************/
+void vector_stats_allocate(struct vector_stats* self,
+                           const size_t bytes);
+void vector_stats_reallocate(struct vector_stats* self,
+                             const int moved,
+                             const size_t old_bytes,
+                             const size_t new_bytes,
+                             const size_t used_bytes);
+void vector_stats_deallocate(struct vector_stats* self,
+                             const size_t bytes);
+void vector_stats_copy(struct vector_stats* self,
+                       const size_t bytes);
+void vector_stats_capacity(struct vector_stats* self,
+                           const size_t capacity);
+void vector_stats_fail(struct vector_stats* self);
+
+/**************************************************************************************************
+* VECTOR_STATS_FIELD: Medlemmen stats i vektorstrukten.
+*
+* VECTOR_STATS_SAVE_ADDRESS: Sparar fltets adress fre en omallokering, s att
+*                            VECTOR_STATS_REALLOCATE kan avgra ifall fltet har flyttats.
+*
+* VECTOR_STATS_INIT, VECTOR_STATS_ALLOCATE osv.: Uppdaterar angiven vektors statistik, se
+*                                               funktionerna ovan.
+**************************************************************************************************/
+#define VECTOR_STATS_FIELD struct vector_stats stats;
+#define VECTOR_STATS_SAVE_ADDRESS(self) \
+   const uintptr_t vector_stats_address = (uintptr_t)(self)->data
+#define VECTOR_STATS_INIT(self) memset(&(self)->stats, 0, sizeof((self)->stats))
+#define VECTOR_STATS_ALLOCATE(self, bytes) vector_stats_allocate(&(self)->stats, (bytes))
+#define VECTOR_STATS_REALLOCATE(self, new_data, old_bytes, new_bytes, used_bytes) \
+   vector_stats_reallocate(&(self)->stats, (uintptr_t)(new_data) != vector_stats_address, \
+                           (old_bytes), (new_bytes), (used_bytes))
+#define VECTOR_STATS_DEALLOCATE(self, bytes) vector_stats_deallocate(&(self)->stats, (bytes))
+#define VECTOR_STATS_COPY(self, bytes) vector_stats_copy(&(self)->stats, (bytes))
+#define VECTOR_STATS_CAPACITY(self, capacity) vector_stats_capacity(&(self)->stats, (capacity))
+#define VECTOR_STATS_FAIL(self) vector_stats_fail(&(self)->stats)
+#else
+#define VECTOR_STATS_FIELD
+#define VECTOR_STATS_SAVE_ADDRESS(self) ((void)0)
+#define VECTOR_STATS_INIT(self) ((void)0)
+#define VECTOR_STATS_ALLOCATE(self, bytes) ((void)0)
+#define VECTOR_STATS_REALLOCATE(self, new_data, old_bytes, new_bytes, used_bytes) ((void)0)
+#define VECTOR_STATS_DEALLOCATE(self, bytes) ((void)0)
+#define VECTOR_STATS_COPY(self, bytes) ((void)0)
+#define VECTOR_STATS_CAPACITY(self, capacity) ((void)0)
+#define VECTOR_STATS_FAIL(self) ((void)0)
+#endif /* VECTOR_STATS */
+
+/**************************************************************************************************
+* vector_unmap: Avmappar ett flt som har mappats frn en fil, se int_vector_map. Fltets
+*               adress och storlek anges exklusive filhuvudet om VECTOR_MAP_OFFSET byte.
+*
+*               - data: Pekare till fltets frsta element.
+*               - size: Fltets storlek i byte.
+**************************************************************************************************/
+void vector_unmap(void* data,
+                  const size_t size);
+
+/**************************************************************************************************
+* vector_share: Referensrknat flt som delas av flera vektorer, se name_share. Strukten ger
+*               fltet och frigr det via angiven allokator, eller avmappar det, nr den sista
+*               vektorn slpper sin referens. Referensrknaren r atomr, s att vektorer som
+*               delar flt kan anvndas frn olika trdar.
+**************************************************************************************************/
+struct vector_share
+{
+   atomic_size_t references;          /* Antalet vektorer som delar fltet. */
+   void* data;                        /* Pekare till fltet. */
+   size_t bytes;                      /* Fltets storlek i byte. */
+   const struct allocator* allocator; /* Allokatorn som fltet och strukten allokerades via. */
+   int mapped;                        /* Indikerar ifall fltet utgrs av en minnesmappad fil. */
+};
+
+/**************************************************************************************************
+* vector_share_new: Returnerar en pekare till en ny delningsstrukt fr angivet flt med en
+*                   referens. Strukten allokeras via angiven allokator. Vid misslyckad
+*                   allokering returneras null.
+*
+*                   - data     : Pekare till fltet som ska delas.
+*                   - bytes    : Fltets storlek i byte.
+*                   - allocator: Allokatorn som fltet har allokerats via (null = malloc).
+*                   - mapped   : Indikerar ifall fltet utgrs av en minnesmappad fil.
+**************************************************************************************************/
+struct vector_share* vector_share_new(void* data,
+                                      const size_t bytes,
+                                      const struct allocator* allocator,
+                                      const int mapped);
+
+/**************************************************************************************************
+* vector_share_acquire: Lgger till en referens till angiven delningsstrukt.
+*
+*                       - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+void vector_share_acquire(struct vector_share* self);
+
+/**************************************************************************************************
+* vector_share_release: Slpper en referens till angiven delningsstrukt. Ifall det var den
+*                       sista referensen returneras 1, varvid anroparen ansvarar fr att frigra
+*                       elementen samt anropa vector_share_delete, annars returneras 0.
+*
+*                       - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+int vector_share_release(struct vector_share* self);
+
+/**************************************************************************************************
+* vector_share_unique: Indikerar ifall angiven delningsstrukt enbart har en referens, dvs. ifall
+*                      den anropande vektorn r ensam om fltet.
+*
+*                      - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+int vector_share_unique(const struct vector_share* self);
+
+/**************************************************************************************************
+* vector_share_delete: Frigr angiven delningsstrukt samt fltet den ger.
+*
+*                      - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+void vector_share_delete(struct vector_share* self);
+
+/**************************************************************************************************
+* vector_share_detach: Frigr angiven delningsstrukt utan att frigra fltet, vars garskap
+*                      drmed vergr till den sista vektorn som refererar till det.
+*
+*                      - self: Pekare till delningsstrukten.
+**************************************************************************************************/
+void vector_share_detach(struct vector_share* self);
+
+/**************************************************************************************************
+* VECTOR_TRACK_BLOCK_SIZE: Antalet byte per block vid berkning av kontrollsummor, se
+*                          name_checksum.
+**************************************************************************************************/
+#define VECTOR_TRACK_BLOCK_SIZE 4096
+
+/**************************************************************************************************
+* vector_track: Sprning av ndringar i en vektor, se name_track. Intervallen anges i byte,
+*               dr ett tomt intervall har first >= last. Intervallet dirty avser ndringar sedan
+*               name_mark_clean, medan intervallet stale avser ndringar sedan kontrollsumman
+*               senast berknades. Kontrollsummorna ndras ven via konstanta vektorer, varfr
+*               name_checksum inte fr anropas frn flera trdar samtidigt.
+**************************************************************************************************/
+struct vector_track
+{
+   size_t dirty_first;                /* Den frsta ndrade byten sedan name_mark_clean. */
+   size_t dirty_last;                 /* Byten direkt efter den sista ndrade. */
+   size_t stale_first;                /* Den frsta byten vars block saknar kontrollsumma. */
+   size_t stale_last;                 /* Byten direkt efter den sista sdana byten. */
+   uint32_t* checksums;               /* Kontrollsumma per block. */
+   size_t block_count;                /* Antalet block vid senaste berkningen. */
+   size_t block_capacity;             /* Antalet kontrollsummor som ryms i checksums. */
+   const struct allocator* allocator; /* Allokatorn som strukten allokerades via. */
+};
+
+/**************************************************************************************************
+* vector_track_new: Returnerar en pekare till en ny sprningsstrukt, dr angivet antal byte
+*                   anses vara ndrade och samtliga kontrollsummor saknas. Strukten allokeras
+*                   via angiven allokator. Vid misslyckad allokering returneras null.
+*
+*                   - allocator: Allokatorn som strukten ska allokeras via (null = malloc).
+*                   - bytes    : Fltets nuvarande storlek i byte.
+**************************************************************************************************/
+struct vector_track* vector_track_new(const struct allocator* allocator,
+                                      const size_t bytes);
+
+/**************************************************************************************************
+* vector_track_delete: Frigr angiven sprningsstrukt.
+*
+*                      - self: Pekare till sprningsstrukten.
+**************************************************************************************************/
+void vector_track_delete(struct vector_track* self);
+
+/**************************************************************************************************
+* vector_track_mark: Markerar angivet intervall av byte som ndrat.
+*
+*                    - self : Pekare till sprningsstrukten.
+*                    - first: Den frsta ndrade byten.
+*                    - last : Byten direkt efter den sista ndrade.
+**************************************************************************************************/
+void vector_track_mark(struct vector_track* self,
+                       const size_t first,
+                       const size_t last);
+
+/**************************************************************************************************
+* vector_track_clean: Markerar samtliga byte som ofrndrade, se name_mark_clean.
+*
+*                     - self: Pekare till sprningsstrukten.
+**************************************************************************************************/
+void vector_track_clean(struct vector_track* self);
+
+/**************************************************************************************************
+* vector_track_dirty: Tilldelar angivna variabler intervallet av element som har ndrats sedan
+*                     name_mark_clean, begrnsat till angiven storlek, se name_dirty_range.
+*                     Ifall ngot har ndrats returneras 1, annars returneras 0.
+*
+*                     - self        : Pekare till sprningsstrukten.
+*                     - element_size: Storleken p varje element i byte.
+*                     - size        : Vektorns storlek.
+*                     - first       : Pekare till variabeln som ska tilldelas det frsta elementet.
+*                     - last        : Pekare till variabeln som ska tilldelas elementet direkt
+*                                     efter det sista.
+**************************************************************************************************/
+int vector_track_dirty(const struct vector_track* self,
+                       const size_t element_size,
+                       const size_t size,
+                       size_t* first,
+                       size_t* last);
+
+/**************************************************************************************************
+* vector_track_checksum: Returnerar kontrollsumman fr angivet flt, dr enbart block som har
+*                        ndrats sedan fregende anrop berknas om, se name_checksum.
+*
+*                        - self : Pekare till sprningsstrukten.
+*                        - data : Pekare till fltet.
+*                        - bytes: Fltets storlek i byte.
+**************************************************************************************************/
+uint32_t vector_track_checksum(struct vector_track* self,
+                               const void* data,
+                               const size_t bytes);
+
+/**************************************************************************************************
+* vector_checksum: Returnerar kontrollsumman fr angivet flt genom att samtliga block berknas,
+*                  se name_checksum.
+*
+*                  - data : Pekare till fltet.
+*                  - bytes: Fltets storlek i byte.
+**************************************************************************************************/
+uint32_t vector_checksum(const void* data,
+                         const size_t bytes);
+
+/**************************************************************************************************
+* VECTOR_STRUCT: Genererar en vektorstrukt med angivet namn, som innehller ett dynamiskt flt
+*                fr lagring av element av angiven datatyp. Antalet element som lagras i fltet
+*                rknas upp och uttrycks i form av vektorns storlek. Fltet kan vara strre n
+*                vad som anvnds fr tillfllet, vilket uttrycks i form av vektorns kapacitet.
+*                Drmed behver inte omallokering ske vid varje nytt element. Fltet allokeras
+*                via vektorns allokator, dr null innebr malloc, realloc och free.
+*
+*                Strukten innehller fljande medlemmar:
+*
+*                - data       : Pekare till det dynamiska fltet.
+*                - size       : Vektorns storlek, dvs. antalet element den rymmer.
+*                - capacity   : Vektorns kapacitet, dvs. antalet element som fr plats i fltet.
+*                - allocator  : Pekare till vektorns allokator (null = standardallokatorn).
+*                - owner      : Pekare till allokatorn som strukten sjlv allokerades via av
+*                               name_new_with_allocator, vilken frigr strukten i name_delete.
+*                               Efter name_move kan den skilja sig frn allocator.
+*                - mapped     : Indikerar ifall fltet utgrs av en minnesmappad fil.
+*                - shared     : Pekare till fltets delningsstrukt om fltet delas med andra
+*                               vektorer, annars null, se name_share.
+*                - track      : Pekare till vektorns sprning av ndringar om sdan r
+*                               aktiverad, annars null, se name_track.
+*                - stats      : Vektorns allokeringsstatistik (enbart om VECTOR_STATS r
+*                               definierat, se vector_stats).
+*                - inline_data: Inbyggt flt fr sm vektorer.
+*
+*                Sm vektorer lagrar sina element i det inbyggda fltet inline_data, s att
+*                ingen allokering sker frrn antalet element verstiger dess kapacitet. Pekaren
+*                data pekar d p strukten sjlv, vilket medfr att en vektor inte fr kopieras
+*                eller flyttas via tilldelning av hela strukten.
+*
+*                En vektor kan ven peka direkt p innehllet i en minnesmappad fil, se
+*                int_vector_map. Fltet kopieras d till heapen frst nr kapaciteten ndras.
+*
+*                Flera vektorer kan dela samma flt via name_share (copy-on-write). Fltet gs d
+*                av en referensrknad delningsstrukt och kopieras frst nr en av vektorerna
+*                ndras, varefter vektorn har ett eget flt.
+*
+*                ndringar kan spras via name_track, s att enbart ndrade element behver
+*                skickas vidare och kontrollsumman kan uppdateras utan att hela fltet lses.
+*
+*                - name           : Vektorstruktens namn.
+*                - type           : Elementens datatyp.
+*                - inline_capacity: Antalet element i det inbyggda fltet (minst 1).
+**************************************************************************************************/
+#define VECTOR_STRUCT(name, type, inline_capacity)                                                 \
+struct name                                                                                        \
+{                                                                                                  \
+   type* data;                                                                                     \
+   size_t size;                                                                                    \
+   size_t capacity;                                                                                \
+   const struct allocator* allocator;                                                              \
+   const struct allocator* owner;                                                                  \
+   int mapped;                                                                                     \
+   struct vector_share* shared;                                                                    \
+   struct vector_track* track;                                                                     \
+   VECTOR_STATS_FIELD                                                                              \
+   type inline_data[inline_capacity];                                                              \
+};
+
+/**************************************************************************************************
+* DECLARE_VECTOR_EX: Deklarerar en vektorstrukt med angivet namn, elementtyp och kapacitet fr
+*                    det inbyggda fltet, samt nedanstende associerade funktioner, dr name
+*                    erstts med vektorstruktens namn och type med elementens datatyp.
+*
+*                    - name           : Vektorstruktens namn.
+*                    - type           : Elementens datatyp.
+*                    - inline_capacity: Antalet element i det inbyggda fltet (minst 1).
+*
+* name_init: Initierar ny tom vektor.
+*
+* name_init_with_allocator: Initierar ny tom vektor, vars flt allokeras via angiven allokator,
+*                           exempelvis en arena eller en pool. Allokatorn mste vara giltig s
+*                           lnge vektorn anvnds.
+*
+* name_clear: Tmmer innehllet i angiven vektor genom att frigra allokerat minne. Vektorn
+*             tergr drefter till att anvnda sitt inbyggda flt. Eventuell sprning av
+*             ndringar avslutas, se name_track.
+*
+* name_reset: Tmmer innehllet i angiven vektor likt name_clear, men behller eventuell
+*             sprning av ndringar, s att tmningen registreras som en ndring.
+*
+* name_new: Returnerar en pekare till en ny heapallokerad vektor av angiven storlek.
+*
+* name_new_with_allocator: Returnerar en pekare till en ny vektor av angiven storlek, dr bde
+*                          vektorn och dess flt allokeras via angiven allokator. Vid misslyckad
+*                          allokering returneras null.
+*
+* name_delete: Frigr minne fr en heapallokerad vektor. Vektorpekarens adress passeras fr att
+*              bde frigra minnet fr det dynamiska flt denna peka p, minnet fr sjlva
+*              vektorn samt att vektorpekaren stts till null.
+*
+* name_resize: ndrar storleken p en vektor. Omallokering sker enbart ifall den nya storleken
+*              verstiger vektorns kapacitet, varvid kapaciteten vxer geometriskt likt
+*              name_push, s att upprepade kningar med ett element ger amorterat konstant tid.
+*              Anvnd name_reserve fr en exakt kapacitet. Nya element initieras inte, frutom
+*              fr vektorer definierade via DEFINE_VECTOR_WITH_HOOKS, dr de nollstlls. Vid
+*              lyckad storleksndring returneras 0, annars returneras felkod 1.
+*
+* name_reserve: Skerstller att vektorns kapacitet rymmer minst angivet antal element.
+*               Vektorns storlek och innehll pverkas inte. Vid lyckad reservation returneras
+*               0, annars returneras felkod 1.
+*
+* name_shrink_to_fit: Minskar vektorns kapacitet till dess storlek via omallokering, s att inget
+*                     oanvnt minne ligger kvar. Ifall elementen ryms i det inbyggda fltet
+*                     flyttas de dit, varvid allt allokerat minne frigrs. Vid lyckad
+*                     omallokering returneras 0, annars returneras felkod 1.
+*
+* name_push: Lgger till ett nytt element lngst bak i en vektor. Ifall kapaciteten inte rcker
+*            till frdubblas den, vilket medfr att omallokering sker sllan. Ifall det nya
+*            elementet lyckas lggas till returneras 0, annars returneras felkod 1.
+*
+* name_pop: Tar bort ett element lngst bak i angiven vektor, om ett sdant finns. Kapaciteten
+*           bibehlls, s att minnet kan teranvndas av nsta tillgg. Ifall elementet lyckas
+*           tas bort returneras 0, annars returneras felkod 1.
+*
+* name_append_range: Lgger till angivet antal element frn ett flt lngst bak i en vektor.
+*                    Hgst en omallokering genomfrs oavsett antalet element. Fltet fr ligga
+*                    i vektorn sjlv. Ifall elementen lyckas lggas till returneras 0, annars
+*                    returneras felkod 1.
+*
+* name_insert_range: Infogar angivet antal element frn ett flt p angivet index i en vektor.
+*                    Befintliga element frn och med detta index flyttas bakt. Hgst en
+*                    omallokering genomfrs. Fltet fr inte ligga i vektorn sjlv. Ifall
+*                    elementen lyckas infogas returneras 0, annars returneras felkod 1
+*                    (exempelvis vid ett index som verstiger vektorns storlek).
+*
+* name_erase_range: Tar bort angivet antal element med start p angivet index i en vektor.
+*                   Efterfljande element flyttas framt och kapaciteten bibehlls. Ifall
+*                   elementen lyckas tas bort returneras 0, annars returneras felkod 1 (ifall
+*                   intervallet strcker sig utanfr vektorn).
+*
+* name_assign_fill: Stter vektorns storlek till angivet antal element och tilldelar samtliga
+*                   element angivet vrde. Hgst en omallokering genomfrs. Vid lyckad
+*                   tilldelning returneras 0, annars returneras felkod 1.
+*
+* name_move: Flyttar innehllet i vektorn src till angiven vektor, vars tidigare innehll
+*            frigrs. Fltet tas ver utan allokering eller kopiering av element, tillsammans
+*            med dess allokator, varefter src r tom. Element i src:s inbyggda flt kopieras
+*            till den angivna vektorns inbyggda flt. Strukten frigrs ven efter flytten via
+*            den allokator den allokerades med, se medlemmen owner.
+*
+* name_share: Lter angiven vektor dela flt med vektorn src (copy-on-write), varvid angiven
+*             vektors tidigare innehll frigrs. Fltet referensrknas och kopieras inte frrn
+*             ngon av vektorerna ndras, via name_begin eller en funktion som ndrar vektorn
+*             (name_push, name_resize osv.). Den vektor som ndras kopierar d fltet exakt en
+*             gng, eller tar ver det utan kopiering om vriga vektorer redan har slppt det.
+*             Lsning via name_cbegin samt funktioner som tar en konstant vektor kopierar aldrig
+*             fltet. Sm vektorer i det inbyggda fltet kopieras direkt. Vid lyckad delning
+*             returneras 0, annars returneras felkod 1.
+*
+* name_clone: Kopierar samtliga element i vektorn src till angiven vektor, vars tidigare
+*             innehll frigrs, s att vektorerna direkt har var sitt flt. Vid lyckad kopiering
+*             returneras 0, annars returneras felkod 1, varvid angiven vektor lmnas tom.
+*
+* name_unshare: Skerstller att angiven vektor har ett eget flt, som kan skrivas direkt via
+*               medlemmen data, genom att kopiera ett delat flt. Vid lyckad kopiering, eller om
+*               fltet inte delas, returneras 0, annars returneras felkod 1.
+*
+* name_begin: Returnerar adressen till det frsta elementet i angiven vektor. Om vektorn r tom
+*             r adressen lika med den som returneras av name_end. Ett delat flt kopieras
+*             frst via name_unshare, eftersom elementen kan ndras via adressen. Om kopieringen
+*             misslyckas returneras null. Av samma anledning markeras samtliga element som
+*             ndrade ifall vektorns ndringar spras, se name_track. Vid enbart lsning
+*             anvnds i stllet name_cbegin.
+*
+* name_end: Returnerar adressen direkt efter det sista elementet i angiven vektor. Om vektorn r
+*           tom r adressen lika med den som returneras av name_begin. Ett delat flt kopieras
+*           frst och elementen markeras som ndrade, se name_begin. Vid enbart lsning anvnds
+*           i stllet name_cend.
+*
+* name_last: Returnerar adressen till det sista elementet i angiven vektor. Om vektorn r tom
+*            returneras null. Ett delat flt kopieras frst och elementen markeras som
+*            ndrade, se name_begin.
+*
+* name_cbegin: Returnerar adressen till det frsta elementet i angiven vektor fr lsning,
+*              utan att ett delat flt kopieras.
+*
+* name_cend: Returnerar adressen direkt efter det sista elementet i angiven vektor fr lsning,
+*            utan att ett delat flt kopieras.
+*
+* name_track: Aktiverar sprning av ndringar i angiven vektor. Vektorn hller drefter reda p
+*             det intervall av element som har ndrats sedan name_mark_clean (watermark) samt
+*             en kontrollsumma (CRC-32C) per block om VECTOR_TRACK_BLOCK_SIZE byte. Intervallet
+*             uppdateras av samtliga funktioner som ndrar vektorn, och kontrollsumman berknas
+*             om enbart fr ndrade block, se name_checksum. Frn brjan anses samtliga element
+*             vara ndrade. Vid lyckad aktivering, eller om sprning redan r aktiverad,
+*             returneras 0, annars returneras felkod 1.
+*
+* name_untrack: Avslutar sprning av ndringar i angiven vektor och frigr tillhrande minne.
+*
+* name_mark_dirty: Markerar angivet antal element med start p angivet index som ndrade,
+*                  vilket krvs efter skrivning via medlemmen data. Element utanfr vektorn
+*                  ignoreras.
+*
+* name_mark_clean: Markerar samtliga element i angiven vektor som ofrndrade, exempelvis efter
+*                  att ndringarna har skickats till en kopia av vektorn. Blockens
+*                  kontrollsummor pverkas inte.
+*
+* name_dirty_range: Tilldelar angivna variabler intervallet [first, last) av element som har
+*                   ndrats sedan name_mark_clean. Intervallet begrnsas till vektorns storlek,
+*                   s att ett tomt intervall i slutet av vektorn innebr att enbart storleken
+*                   har minskat. Ifall vektorn har ndrats returneras 1, annars returneras 0.
+*                   Utan sprning anses samtliga element vara ndrade.
+*
+* name_checksum: Returnerar vektorns kontrollsumma, dvs. CRC-32C berknad ver blockens
+*                kontrollsummor i little endian, dr varje block utgrs av
+*                VECTOR_TRACK_BLOCK_SIZE byte av fltet. Med sprning aktiverad berknas
+*                enbart ndrade block om, annars berknas samtliga block. Kontrollsumman r
+*                densamma i bda fallen, vilket gr att en kopia kan verifieras mot originalet.
+**************************************************************************************************/
+#define DECLARE_VECTOR_EX(name, type, inline_capacity)                                             \
+VECTOR_STRUCT(name, type, inline_capacity)                                                         \
+void name##_init(struct name* self);                                                               \
+void name##_init_with_allocator(struct name* self, const struct allocator* allocator);             \
+void name##_clear(struct name* self);                                                              \
+void name##_reset(struct name* self);                                                              \
+struct name* name##_new(const size_t size);                                                        \
+struct name* name##_new_with_allocator(const size_t size, const struct allocator* allocator);      \
+void name##_delete(struct name** self);                                                            \
+int name##_resize(struct name* self, const size_t new_size);                                       \
+int name##_reserve(struct name* self, const size_t new_capacity);                                  \
+int name##_shrink_to_fit(struct name* self);                                                       \
+int name##_push(struct name* self, const type new_element);                                        \
+int name##_pop(struct name* self);                                                                 \
+int name##_append_range(struct name* self, const type* src, const size_t n);                       \
+int name##_insert_range(struct name* self, const size_t index, const type* src, const size_t n);   \
+int name##_erase_range(struct name* self, const size_t index, const size_t n);                     \
+int name##_assign_fill(struct name* self, const size_t size, const type value);                    \
+void name##_move(struct name* self, struct name* src);                                             \
+int name##_share(struct name* self, struct name* src);                                             \
+int name##_clone(struct name* self, const struct name* src);                                       \
+int name##_unshare(struct name* self);                                                             \
+type* name##_begin(struct name* self);                                                             \
+type* name##_end(struct name* self);                                                               \
+type* name##_last(struct name* self);                                                              \
+const type* name##_cbegin(const struct name* self);                                                \
+const type* name##_cend(const struct name* self);                                                  \
+int name##_track(struct name* self);                                                               \
+void name##_untrack(struct name* self);                                                            \
+void name##_mark_dirty(struct name* self, const size_t index, const size_t n);                     \
+void name##_mark_clean(struct name* self);                                                         \
+int name##_dirty_range(const struct name* self, size_t* first, size_t* last);                      \
+uint32_t name##_checksum(const struct name* self);
+
+/**************************************************************************************************
+* DEFINE_VECTOR_IMPL: Genererar definitioner av samtliga funktioner som deklareras av makrot
+*                     DECLARE_VECTOR_EX. Anvnds via makrona DEFINE_VECTOR samt
+*                     DEFINE_VECTOR_WITH_HOOKS nedan.
+*
+*                     Element flyttas alltid byte fr byte via memcpy, memmove och omallokering,
+*                     vilket fungerar fr samtliga datatyper i C. Funktionen copy anropas nr
+*                     element kopieras in i vektorn och funktionen destroy nr element tas bort.
+*
+*                     - name    : Vektorstruktens namn.
+*                     - type    : Elementens datatyp.
+*                     - copy    : Funktion copy(type* dest, const type* src, size_t n), som
+*                                 kopierar n element frn src till oinitierat minne p dest.
+*                     - destroy : Funktion destroy(type* data, size_t n), som frigr resurser
+*                                 som gs av n element med start p data.
+*                     - zero_new: Indikerar ifall nya element vid storleksndring ska nollstllas,
+*                                 s att destroy alltid anropas fr initierade element.
+**************************************************************************************************/
+#define DEFINE_VECTOR_IMPL(name, type, copy, destroy, zero_new)                                    \
+static void name##_changed(struct name* self, const size_t first, const size_t last)               \
+{                                                                                                  \
+   if (self->track) vector_track_mark(self->track, sizeof(type) * first, sizeof(type) * last);     \
+   return;                                                                                         \
+}                                                                                                  \
+static void name##_release(struct name* self)                                                      \
+{                                                                                                  \
+   if (self->data == self->inline_data) return;                                                    \
+   if (self->shared)                                                                               \
+   {                                                                                               \
+      if (vector_share_release(self->shared))                                                      \
+      {                                                                                            \
+         destroy(self->data, self->size);                                                          \
+         if (!self->shared->mapped) VECTOR_STATS_DEALLOCATE(self, self->shared->bytes);            \
+         vector_share_delete(self->shared);                                                        \
+      }                                                                                            \
+      self->shared = 0;                                                                            \
+   }                                                                                               \
+   else if (self->mapped)                                                                          \
+   {                                                                                               \
+      vector_unmap(self->data, sizeof(type) * self->capacity);                                     \
+      self->mapped = 0;                                                                            \
+   }                                                                                               \
+   else                                                                                            \
+   {                                                                                               \
+      VECTOR_STATS_DEALLOCATE(self, sizeof(type) * self->capacity);                                \
+      allocator_deallocate(self->allocator, self->data, sizeof(type) * self->capacity);            \
+   }                                                                                               \
+   return;                                                                                         \
+}                                                                                                  \
+static int name##_detach(struct name* self, size_t new_capacity);                                  \
+static int name##_reallocate(struct name* self, const size_t new_capacity)                         \
+{                                                                                                  \
+   if (self->shared) return name##_detach(self, new_capacity);                                     \
+   if (new_capacity <= VECTOR_INLINE_COUNT(self))                                                  \
+   {                                                                                               \
+      if (self->data != self->inline_data)                                                         \
+      {                                                                                            \
+         memcpy(self->inline_data, self->data, sizeof(type) * self->size);                         \
+         VECTOR_STATS_COPY(self, sizeof(type) * self->size);                                       \
+         name##_release(self);                                                                     \
+         self->data = self->inline_data;                                                           \
+         self->capacity = VECTOR_INLINE_COUNT(self);                                               \
+      }                                                                                            \
+      return 0;                                                                                    \
+   }                                                                                               \
+   if (new_capacity > SIZE_MAX / sizeof(type)) return 1;                                           \
+   if (self->data == self->inline_data || self->mapped)                                            \
+   {                                                                                               \
+      type* new_data = (type*)allocator_allocate(self->allocator, sizeof(type) * new_capacity);    \
+      if (!new_data)                                                                               \
+      {                                                                                            \
+         VECTOR_STATS_FAIL(self);                                                                  \
+         return 1;                                                                                 \
+      }                                                                                            \
+      VECTOR_STATS_ALLOCATE(self, sizeof(type) * new_capacity);                                    \
+      memcpy(new_data, self->data, sizeof(type) * self->size);                                     \
+      VECTOR_STATS_COPY(self, sizeof(type) * self->size);                                          \
+      name##_release(self);                                                                        \
+      self->data = new_data;                                                                       \
+   }                                                                                               \
+   else                                                                                            \
+   {                                                                                               \
+      VECTOR_STATS_SAVE_ADDRESS(self);                                                             \
+      type* new_data = (type*)allocator_reallocate(self->allocator, self->data,                    \
+                                                   sizeof(type) * self->capacity,                  \
+                                                   sizeof(type) * new_capacity);                   \
+      if (!new_data)                                                                               \
+      {                                                                                            \
+         VECTOR_STATS_FAIL(self);                                                                  \
+         return 1;                                                                                 \
+      }                                                                                            \
+      VECTOR_STATS_REALLOCATE(self, new_data, sizeof(type) * self->capacity,                       \
+                              sizeof(type) * new_capacity, sizeof(type) * self->size);             \
+      self->data = new_data;                                                                       \
+   }                                                                                               \
+   self->capacity = new_capacity;                                                                  \
+   VECTOR_STATS_CAPACITY(self, new_capacity);                                                      \
+   return 0;                                                                                       \
+}                                                                                                  \
+static int name##_detach(struct name* self, size_t new_capacity)                                   \
+{                                                                                                  \
+   struct vector_share* shared = self->shared;                                                     \
+   type* new_data = self->inline_data;                                                             \
+   if (new_capacity < self->size) new_capacity = self->size;                                       \
+   if (vector_share_unique(shared) && (shared->mapped || shared->allocator == self->allocator))    \
+   {                                                                                               \
+      self->mapped = shared->mapped;                                                               \
+      vector_share_detach(shared);                                                                 \
+      self->shared = 0;                                                                            \
+      return new_capacity == self->capacity ? 0 : name##_reallocate(self, new_capacity);           \
+   }                                                                                               \
+   if (new_capacity > VECTOR_INLINE_COUNT(self))                                                   \
+   {                                                                                               \
+      if (new_capacity > SIZE_MAX / sizeof(type)) return 1;                                        \
+      new_data = (type*)allocator_allocate(self->allocator, sizeof(type) * new_capacity);          \
+      if (!new_data)                                                                               \
+      {                                                                                            \
+         VECTOR_STATS_FAIL(self);                                                                  \
+         return 1;                                                                                 \
+      }                                                                                            \
+      VECTOR_STATS_ALLOCATE(self, sizeof(type) * new_capacity);                                    \
+   }                                                                                               \
+   else                                                                                            \
+   {                                                                                               \
+      new_capacity = VECTOR_INLINE_COUNT(self);                                                    \
+   }                                                                                               \
+   copy(new_data, self->data, self->size);                                                         \
+   VECTOR_STATS_COPY(self, sizeof(type) * self->size);                                             \
+   name##_release(self);                                                                           \
+   self->data = new_data;                                                                          \
+   self->capacity = new_capacity;                                                                  \
+   VECTOR_STATS_CAPACITY(self, new_capacity);                                                      \
+   return 0;                                                                                       \
+}                                                                                                  \
+static int name##_grow(struct name* self, const size_t min_capacity)                               \
+{                                                                                                  \
+   size_t new_capacity = self->capacity * 2;                                                       \
+   if (new_capacity < self->capacity || new_capacity < min_capacity) new_capacity = min_capacity;  \
+   return name##_reallocate(self, new_capacity);                                                   \
+}                                                                                                  \
+static int name##_prepare(struct name* self, const size_t min_capacity)                            \
+{                                                                                                  \
+   if (min_capacity > self->capacity) return name##_grow(self, min_capacity);                      \
+   return self->shared ? name##_detach(self, self->capacity) : 0;                                  \
+}                                                                                                  \
+void name##_init(struct name* self)                                                                \
+{                                                                                                  \
+   name##_init_with_allocator(self, 0);                                                            \
+   return;                                                                                         \
+}                                                                                                  \
+void name##_init_with_allocator(struct name* self, const struct allocator* allocator)              \
+{                                                                                                  \
+   self->data = self->inline_data;                                                                 \
+   self->size = 0;                                                                                 \
+   self->capacity = VECTOR_INLINE_COUNT(self);                                                     \
+   self->allocator = allocator;                                                                    \
+   self->owner = 0;                                                                                \
+   self->mapped = 0;                                                                               \
+   self->shared = 0;                                                                               \
+   self->track = 0;                                                                                \
+   VECTOR_STATS_INIT(self);                                                                        \
+   return;                                                                                         \
+}                                                                                                  \
+void name##_clear(struct name* self)                                                               \
+{                                                                                                  \
+   name##_reset(self);                                                                             \
+   name##_untrack(self);                                                                           \
+   return;                                                                                         \
+}                                                                                                  \
+void name##_reset(struct name* self)                                                               \
+{                                                                                                  \
+   if (!self->shared) destroy(self->data, self->size);                                             \
+   name##_changed(self, 0, self->size);                                                            \
+   name##_release(self);                                                                           \
+   self->data = self->inline_data;                                                                 \
+   self->size = 0;                                                                                 \
+   self->capacity = VECTOR_INLINE_COUNT(self);                                                     \
+   return;                                                                                         \
+}                                                                                                  \
+struct name* name##_new(const size_t size)                                                         \
+{                                                                                                  \
+   return name##_new_with_allocator(size, 0);                                                      \
+}                                                                                                  \
+struct name* name##_new_with_allocator(const size_t size, const struct allocator* allocator)       \
+{                                                                                                  \
+   struct name* self = (struct name*)allocator_allocate(allocator, sizeof(struct name));           \
+   if (!self) return 0;                                                                            \
+   name##_init_with_allocator(self, allocator);                                                    \
+   self->owner = allocator;                                                                        \
+   VECTOR_STATS_ALLOCATE(self, sizeof(struct name));                                               \
+   name##_resize(self, size);                                                                      \
+   return self;                                                                                    \
+}                                                                                                  \
+void name##_delete(struct name** self)                                                             \
+{                                                                                                  \
+   const struct allocator* owner = (*self)->owner;                                                 \
+   name##_clear(*self);                                                                            \
+   VECTOR_STATS_DEALLOCATE(*self, sizeof(struct name));                                            \
+   allocator_deallocate(owner, *self, sizeof(struct name));                                        \
+   *self = 0;                                                                                      \
+   return;                                                                                         \
+}                                                                                                  \
+int name##_resize(struct name* self, const size_t new_size)                                        \
+{                                                                                                  \
+   if (name##_prepare(self, new_size)) return 1;                                                   \
+   if (new_size < self->size) destroy(self->data + new_size, self->size - new_size);               \
+   else if (zero_new) memset(self->data + self->size, 0, sizeof(type) * (new_size - self->size));  \
+   if (new_size < self->size) name##_changed(self, new_size, self->size);                          \
+   else name##_changed(self, self->size, new_size);                                                \
+   self->size = new_size;                                                                          \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_reserve(struct name* self, const size_t new_capacity)                                   \
+{                                                                                                  \
+   if (new_capacity <= self->capacity) return name##_prepare(self, self->size);                    \
+   return name##_reallocate(self, new_capacity);                                                   \
+}                                                                                                  \
+int name##_shrink_to_fit(struct name* self)                                                        \
+{                                                                                                  \
+   if (self->size == self->capacity || self->data == self->inline_data) return 0;                  \
+   return name##_reallocate(self, self->size);                                                     \
+}                                                                                                  \
+int name##_push(struct name* self, const type new_element)                                         \
+{                                                                                                  \
+   if (name##_prepare(self, self->size + 1)) return 1;                                             \
+   copy(self->data + self->size, &new_element, 1);                                                 \
+   name##_changed(self, self->size, self->size + 1);                                               \
+   self->size++;                                                                                   \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_pop(struct name* self)                                                                  \
+{                                                                                                  \
+   if (self->size > 0)                                                                             \
+   {                                                                                               \
+      if (name##_prepare(self, self->size)) return 1;                                              \
+      self->size--;                                                                                \
+      destroy(self->data + self->size, 1);                                                         \
+      name##_changed(self, self->size, self->size + 1);                                            \
+   }                                                                                               \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_append_range(struct name* self, const type* src, const size_t n)                        \
+{                                                                                                  \
+   if (!n) return 0;                                                                               \
+   if (n > SIZE_MAX - self->size) return 1;                                                        \
+   if (self->size + n > self->capacity || self->shared)                                            \
+   {                                                                                               \
+      const int aliased = src >= self->data && src < self->data + self->size;                      \
+      const size_t offset = aliased ? (size_t)(src - self->data) : 0;                              \
+      if (name##_prepare(self, self->size + n)) return 1;                                          \
+      if (aliased) src = self->data + offset;                                                      \
+   }                                                                                               \
+   copy(self->data + self->size, src, n);                                                          \
+   name##_changed(self, self->size, self->size + n);                                               \
+   self->size += n;                                                                                \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_insert_range(struct name* self, const size_t index, const type* src, const size_t n)    \
+{                                                                                                  \
+   if (index > self->size) return 1;                                                               \
+   if (!n) return 0;                                                                               \
+   if (n > SIZE_MAX - self->size) return 1;                                                        \
+   if (name##_prepare(self, self->size + n)) return 1;                                             \
+   memmove(self->data + index + n, self->data + index, sizeof(type) * (self->size - index));       \
+   copy(self->data + index, src, n);                                                               \
+   self->size += n;                                                                                \
+   name##_changed(self, index, self->size);                                                        \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_erase_range(struct name* self, const size_t index, const size_t n)                      \
+{                                                                                                  \
+   if (index > self->size || n > self->size - index) return 1;                                     \
+   if (!n) return 0;                                                                               \
+   if (name##_prepare(self, self->size)) return 1;                                                 \
+   destroy(self->data + index, n);                                                                 \
+   memmove(self->data + index, self->data + index + n, sizeof(type) * (self->size - index - n));   \
+   name##_changed(self, index, self->size);                                                        \
+   self->size -= n;                                                                                \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_assign_fill(struct name* self, const size_t size, const type value)                     \
+{                                                                                                  \
+   if (self->shared) name##_reset(self);                                                           \
+   destroy(self->data, self->size);                                                                \
+   name##_changed(self, 0, self->size);                                                            \
+   self->size = 0;                                                                                 \
+   if (name##_reserve(self, size)) return 1;                                                       \
+   for (size_t i = 0; i < size; ++i)                                                               \
+   {                                                                                               \
+      copy(self->data + i, &value, 1);                                                             \
+   }                                                                                               \
+   self->size = size;                                                                              \
+   name##_changed(self, 0, size);                                                                  \
+   return 0;                                                                                       \
+}                                                                                                  \
+void name##_move(struct name* self, struct name* src)                                              \
+{                                                                                                  \
+   if (self == src) return;                                                                        \
+   name##_reset(self);                                                                             \
+   if (src->data == src->inline_data)                                                              \
+   {                                                                                               \
+      memcpy(self->inline_data, src->inline_data, sizeof(type) * src->size);                       \
+   }                                                                                               \
+   else                                                                                            \
+   {                                                                                               \
+      self->data = src->data;                                                                      \
+      self->capacity = src->capacity;                                                              \
+      self->allocator = src->allocator;                                                            \
+      self->mapped = src->mapped;                                                                  \
+      self->shared = src->shared;                                                                  \
+   }                                                                                               \
+   self->size = src->size;                                                                         \
+   name##_changed(self, 0, self->size);                                                            \
+   name##_changed(src, 0, src->size);                                                              \
+   src->data = src->inline_data;                                                                   \
+   src->size = 0;                                                                                  \
+   src->capacity = VECTOR_INLINE_COUNT(src);                                                       \
+   src->mapped = 0;                                                                                \
+   src->shared = 0;                                                                                \
+   return;                                                                                         \
+}                                                                                                  \
+int name##_share(struct name* self, struct name* src)                                              \
+{                                                                                                  \
+   if (self == src) return 0;                                                                      \
+   if (src->data == src->inline_data || !src->size) return name##_clone(self, src);                \
+   if (!src->shared)                                                                               \
+   {                                                                                               \
+      src->shared = vector_share_new(src->data, sizeof(type) * src->capacity,                      \
+                                     src->allocator, src->mapped);                                 \
+      if (!src->shared) return 1;                                                                  \
+      src->mapped = 0;                                                                             \
+   }                                                                                               \
+   if (self->shared == src->shared) return 0;                                                      \
+   name##_reset(self);                                                                             \
+   vector_share_acquire(src->shared);                                                              \
+   self->data = src->data;                                                                         \
+   self->size = src->size;                                                                         \
+   self->capacity = src->capacity;                                                                 \
+   self->shared = src->shared;                                                                     \
+   name##_changed(self, 0, self->size);                                                            \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_clone(struct name* self, const struct name* src)                                        \
+{                                                                                                  \
+   if (self == src) return 0;                                                                      \
+   name##_reset(self);                                                                             \
+   if (name##_reserve(self, src->size)) return 1;                                                  \
+   copy(self->data, src->data, src->size);                                                         \
+   self->size = src->size;                                                                         \
+   name##_changed(self, 0, self->size);                                                            \
+   return 0;                                                                                       \
+}                                                                                                  \
+int name##_unshare(struct name* self)                                                              \
+{                                                                                                  \
+   return self->shared ? name##_detach(self, self->capacity) : 0;                                  \
+}                                                                                                  \
+type* name##_begin(struct name* self)                                                              \
+{                                                                                                  \
+   if (name##_unshare(self)) return 0;                                                             \
+   name##_changed(self, 0, self->size);                                                            \
+   return self->data;                                                                              \
+}                                                                                                  \
+type* name##_end(struct name* self)                                                                \
+{                                                                                                  \
+   if (name##_unshare(self)) return 0;                                                             \
+   name##_changed(self, 0, self->size);                                                            \
+   return self->data + self->size;                                                                 \
+}                                                                                                  \
+type* name##_last(struct name* self)                                                               \
+{                                                                                                  \
+   if (name##_unshare(self)) return 0;                                                             \
+   name##_changed(self, 0, self->size);                                                            \
+   return self->size > 0 ? self->data + self->size - 1 : 0;                                        \
+}                                                                                                  \
+const type* name##_cbegin(const struct name* self)                                                 \
+{                                                                                                  \
+   return self->data;                                                                              \
+}                                                                                                  \
+const type* name##_cend(const struct name* self)                                                   \
+{                                                                                                  \
+   return self->data + self->size;                                                                 \
+}                                                                                                  \
+int name##_track(struct name* self)                                                                \
+{                                                                                                  \
+   if (self->track) return 0;                                                                      \
+   self->track = vector_track_new(self->allocator, sizeof(type) * self->size);                     \
+   return self->track ? 0 : 1;                                                                     \
+}                                                                                                  \
+void name##_untrack(struct name* self)                                                             \
+{                                                                                                  \
+   if (self->track) vector_track_delete(self->track);                                              \
+   self->track = 0;                                                                                \
+   return;                                                                                         \
+}                                                                                                  \
+void name##_mark_dirty(struct name* self, const size_t index, const size_t n)                      \
+{                                                                                                  \
+   if (index >= self->size) return;                                                                \
+   name##_changed(self, index, n < self->size - index ? index + n : self->size);                   \
+   return;                                                                                         \
+}                                                                                                  \
+void name##_mark_clean(struct name* self)                                                          \
+{                                                                                                  \
+   if (self->track) vector_track_clean(self->track);                                               \
+   return;                                                                                         \
+}                                                                                                  \
+int name##_dirty_range(const struct name* self, size_t* first, size_t* last)                       \
+{                                                                                                  \
+   if (self->track) return vector_track_dirty(self->track, sizeof(type), self->size, first, last); \
+   *first = 0;                                                                                     \
+   *last = self->size;                                                                             \
+   return 1;                                                                                       \
+}                                                                                                  \
+uint32_t name##_checksum(const struct name* self)                                                  \
+{                                                                                                  \
+   if (!self->track) return vector_checksum(self->data, sizeof(type) * self->size);                \
+   return vector_track_checksum(self->track, self->data, sizeof(type) * self->size);               \
+}
+
+/**************************************************************************************************
+* DECLARE_VECTOR: Deklarerar en vektorstrukt med angivet namn och elementtyp samt dess
+*                 associerade funktioner, se DECLARE_VECTOR_EX. Det inbyggda fltet rymmer
+*                 VECTOR_INLINE_BYTES byte, dock minst ett element.
+*
+*                 - name: Vektorstruktens namn.
+*                 - type: Elementens datatyp.
+**************************************************************************************************/
+#define DECLARE_VECTOR(name, type) DECLARE_VECTOR_EX(name, type, VECTOR_INLINE_CAPACITY(type))
+
+/**************************************************************************************************
+* DEFINE_VECTOR: Genererar definitioner av funktionerna fr en vektor deklarerad via
+*                DECLARE_VECTOR eller DECLARE_VECTOR_EX, dr element kopieras via memcpy.
+*
+*                - name: Vektorstruktens namn.
+*                - type: Elementens datatyp.
+**************************************************************************************************/
+#define DEFINE_VECTOR(name, type) \
+   DEFINE_VECTOR_IMPL(name, type, VECTOR_COPY_TRIVIAL, VECTOR_DESTROY_TRIVIAL, 0)
+
+/**************************************************************************************************
+* DEFINE_VECTOR_WITH_HOOKS: Genererar definitioner av funktionerna fr en vektor deklarerad via
+*                           DECLARE_VECTOR eller DECLARE_VECTOR_EX, dr element kopieras och
+*                           frigrs via angivna funktioner, se DEFINE_VECTOR_IMPL. Nya element
+*                           vid storleksndring nollstlls.
+*
+*                           - name   : Vektorstruktens namn.
+*                           - type   : Elementens datatyp.
+*                           - copy   : Funktion fr kopiering av element.
+*                           - destroy: Funktion fr destruktion av element.
+**************************************************************************************************/
+#define DEFINE_VECTOR_WITH_HOOKS(name, type, copy, destroy) \
+   DEFINE_VECTOR_IMPL(name, type, copy, destroy, 1)
+
+#endif /* VECTOR_H_ */